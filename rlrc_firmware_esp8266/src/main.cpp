@@ -3,6 +3,8 @@
 #include <Ticker.h>
 #include <WiFiUdp.h>
 
+#include <algorithm>
+
 #include "Log.hpp"
 #include "WiFiManager.h"
 #include "config.hpp"
@@ -86,6 +88,13 @@ void loop() {
             // 只负责将数据原模原样通过串口转发给 STM32
             Serial.write(tcpClient.read());
         }
+
+        // 反方向同样透明转发：STM32 的回复包 (已 COBS 编码) 原样发回 APP
+        if (const int len = Serial.available(); len > 0) {
+            uint8_t replyBuffer[64];
+            const size_t count = Serial.readBytes(replyBuffer, std::min<size_t>(len, sizeof(replyBuffer)));
+            tcpClient.write(replyBuffer, count);
+        }
     }
 
     // --- UDP 设备发现请求广播处理---
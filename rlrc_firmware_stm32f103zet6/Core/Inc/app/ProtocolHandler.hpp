@@ -3,7 +3,6 @@
 // //
 
 #pragma once
-#include <atomic>
 #include <cstdint>
 #include <span>
 
@@ -13,6 +12,8 @@ namespace ProtocolHandler {
         OK,
         INVALID_BUFFER_LENGTH,
         UNKNOWN_COMMAND,
+        INVALID_ARGUMENT,
+        BUSY, // 缓冲队列已满，稍后重发
     };
 
     enum class PacketType : std::uint8_t {
@@ -20,10 +21,38 @@ namespace ProtocolHandler {
         CMD_SET_FRAME = 0x02,
         CMD_TOGGLE    = 0x03,
         CMD_SET_MODE  = 0x04,
+        CMD_SET_BRIGHTNESS = 0x05,
+        CMD_SET_POWER_BUDGET = 0x06,
+        CMD_QUERY_POWER = 0x07,
+        CMD_SET_EFFECT_PARAM = 0x08,
+        CMD_SET_TRANSITION = 0x09,
+        CMD_PUSH_KEYFRAME = 0x0A,
+        CMD_UPLOAD_PAGE = 0x0B,
+        CMD_FLIP_PAGE = 0x0C,
+        CMD_SET_PAGE_CYCLE = 0x0D,
+        CMD_CLIP_BEGIN = 0x0E,
+        CMD_CLIP_DATA = 0x0F,
+        CMD_CLIP_END = 0x10,
+        CMD_PLAY_CLIP = 0x11,
+        CMD_SEQ_APPEND = 0x12,
+        CMD_SEQ_CONTROL = 0x13,
+        CMD_VM_LOAD = 0x14,
+        CMD_SET_TEXT = 0x15,
+        CMD_FILL_RECT = 0x16,
+        CMD_DRAW_LINE = 0x17,
+        CMD_GRADIENT = 0x18,
+        CMD_SHIFT = 0x19,
+        CMD_SPRITE_UPLOAD = 0x1A,
+        CMD_SPRITE_BLIT = 0x1B,
+        CMD_SET_DITHERING = 0x1C,
+        CMD_SET_FPS = 0x1D,
         MSG_LOG   = 0xFE,
     };
 
-    inline std::atomic_uint8_t g_currentMode;
+    // STM32 -> APP 的回复包，头部为对应指令 | 0x80
+    enum class ReplyType : std::uint8_t {
+        REPLY_POWER = 0x87, // [mA u32 LE][预算 mA u16 LE][限流系数 u8, 255 为不限流]
+    };
 
     /**
      * @brief 分发处理已解码的数据包
@@ -36,5 +65,30 @@ namespace ProtocolHandler {
     static ErrorCode handleSetFrame(std::span<const uint8_t> payload);
     static ErrorCode handleToggle(std::span<const uint8_t> payload);
     static ErrorCode handleSetMode(std::span<const uint8_t> payload);
+    static ErrorCode handleSetBrightness(std::span<const uint8_t> payload);
+    static ErrorCode handleSetPowerBudget(std::span<const uint8_t> payload);
+    static ErrorCode handleQueryPower(std::span<const uint8_t> payload);
+    static ErrorCode handleSetEffectParam(std::span<const uint8_t> payload);
+    static ErrorCode handleSetTransition(std::span<const uint8_t> payload);
+    static ErrorCode handlePushKeyframe(std::span<const uint8_t> payload);
+    static ErrorCode handleUploadPage(std::span<const uint8_t> payload);
+    static ErrorCode handleFlipPage(std::span<const uint8_t> payload);
+    static ErrorCode handleSetPageCycle(std::span<const uint8_t> payload);
+    static ErrorCode handleClipBegin(std::span<const uint8_t> payload);
+    static ErrorCode handleClipData(std::span<const uint8_t> payload);
+    static ErrorCode handleClipEnd(std::span<const uint8_t> payload);
+    static ErrorCode handlePlayClip(std::span<const uint8_t> payload);
+    static ErrorCode handleSeqAppend(std::span<const uint8_t> payload);
+    static ErrorCode handleSeqControl(std::span<const uint8_t> payload);
+    static ErrorCode handleVmLoad(std::span<const uint8_t> payload);
+    static ErrorCode handleSetText(std::span<const uint8_t> payload);
+    static ErrorCode handleFillRect(std::span<const uint8_t> payload);
+    static ErrorCode handleDrawLine(std::span<const uint8_t> payload);
+    static ErrorCode handleGradient(std::span<const uint8_t> payload);
+    static ErrorCode handleShift(std::span<const uint8_t> payload);
+    static ErrorCode handleSpriteUpload(std::span<const uint8_t> payload);
+    static ErrorCode handleSpriteBlit(std::span<const uint8_t> payload);
+    static ErrorCode handleSetDithering(std::span<const uint8_t> payload);
+    static ErrorCode handleSetFps(std::span<const uint8_t> payload);
 }
 
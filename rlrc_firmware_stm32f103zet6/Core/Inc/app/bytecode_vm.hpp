@@ -0,0 +1,102 @@
+/**
+ * 像素效果字节码虚拟机
+ *
+ * 让 APP 上传自定义效果而不必重新烧录固件。程序对每个像素各执行一次：
+ * 输入为像素坐标、时间等，运行结束时栈上恰好剩下 R, G, B 三个值 (Q16，[0, 1] 对应 0-255)。
+ *
+ * - 栈式指令，所有数值都是 Q16.16 定点数 (见 fixed_math.hpp)
+ * - 内建函数：sin/cos (查表)、值噪声、平方根、HSV 转 RGB 等
+ * - load() 时对整个程序做一次静态检查 (指令合法、立即数不越界、栈深度不溢出、结束时栈上恰好 3 个值)，
+ *   因此解释执行时不需要任何运行时检查
+ * - 程序来自网络，任何输入都不能触发未定义行为：加减与取反按 32 位回绕，除法饱和
+ *
+ * 指令编码：1 字节操作码，CONST 后跟 4 字节小端 Q16 立即数，PARAM 后跟 1 字节参数下标。
+ * 指令表与 APP 端的编译器 (effect_compiler.dart) 必须保持一致。
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "fixed_math.hpp"
+
+class BytecodeVm {
+public:
+    static constexpr uint16_t MAX_PROGRAM_SIZE = 256;
+    static constexpr uint8_t STACK_SIZE = 16;
+    static constexpr uint8_t PARAM_COUNT = 8;
+
+    enum class Op : uint8_t {
+        END = 0x00,
+
+        // 入栈 (弹出 0 个，压入 1 个)
+        CONST = 0x01, // 后跟 4 字节 Q16 立即数
+        X = 0x02,     // 像素列号
+        Y = 0x03,     // 像素行号
+        T = 0x04,     // 时间 (秒)
+        I = 0x05,     // 像素序号
+        W = 0x06,     // 点阵宽度
+        H = 0x07,     // 点阵高度
+        PARAM = 0x08, // 后跟 1 字节参数下标，参数值 (0-255) 作为整数入栈
+
+        // 二元运算 (弹出 2 个，压入 1 个)
+        ADD = 0x10,
+        SUB = 0x11,
+        MUL = 0x12,
+        DIV = 0x13, // 除数为 0 时结果为 0，溢出时饱和
+        MOD = 0x14, // 结果与除数同号，除数为 0 时结果为 0
+        MIN = 0x15,
+        MAX = 0x16,
+        NOISE = 0x17, // 二维值噪声，[0, 1)
+
+        // 一元运算 (弹出 1 个，压入 1 个)
+        NEG = 0x20,
+        ABS = 0x21,
+        SIN = 0x22, // 弧度
+        COS = 0x23,
+        FRACT = 0x24,
+        FLOOR = 0x25,
+        SQRT = 0x26,
+
+        // HSV 转 RGB (弹出 3 个，压入 3 个)，色相以圈为单位
+        HSV = 0x30,
+    };
+
+    enum class ErrorCode : uint8_t {
+        NONE = 0,
+        TOO_LARGE,         // 程序超过 MAX_PROGRAM_SIZE
+        INVALID_OPCODE,    // 未知指令
+        TRUNCATED,         // 立即数被截断
+        STACK_OVERFLOW,    // 栈深度超过 STACK_SIZE
+        STACK_UNDERFLOW,   // 操作数不足
+        BAD_RESULT,        // 结束时栈上不是恰好 3 个值
+    };
+
+    // 每个像素的输入
+    struct Inputs {
+        Fixed::q16 x;
+        Fixed::q16 y;
+        Fixed::q16 t;
+        Fixed::q16 i;
+    };
+
+    /**
+     * @brief 检查并载入程序，失败时保留原程序
+     */
+    ErrorCode load(std::span<const uint8_t> program);
+
+    [[nodiscard]] bool loaded() const;
+
+    /**
+     * @brief 对一个像素执行程序
+     * @param params 参数块 (PARAM 指令读取)
+     * @return R, G, B (Q16，未截断)
+     */
+    [[nodiscard]] std::array<Fixed::q16, 3> run(const Inputs &in, const std::array<uint8_t, PARAM_COUNT> &params) const;
+
+private:
+    // 多一个字节：没有 END 的满长程序末尾还要补一个 END
+    std::array<uint8_t, MAX_PROGRAM_SIZE + 1> code{};
+    uint16_t code_size = 0;
+};
@@ -0,0 +1,136 @@
+/**
+ * Flash 动画片段存储 (ClipStore)
+ *
+ * 链接脚本把 Flash 的高 256 KB 保留为 CLIPS 区域，划分为 SLOT_COUNT 个固定大小的槽位，每个槽位存放一个片段：
+ *
+ *   [Header 16 字节][调色板 palette_count * 3 字节][帧数据 frame_count * 帧大小]
+ *
+ * - RAW 格式：每帧 LED_COUNT * 3 字节 RGB
+ * - PALETTE 格式：每帧 LED_COUNT 字节调色板下标，5x5 下每帧只需 25 字节
+ *
+ * 写入流程：begin() -> 按顺序多次 write() -> end()
+ * - begin() 立即擦除槽位的第一页，旧片段随即失效
+ * - 后续的页在数据第一次写到该页时才擦除，擦除耗时分散到整个上传过程
+ * - Header 在 end() 时最后写入，未完成的上传不会被当作有效片段
+ *
+ * 读取时直接返回指向 Flash 的指针 (Flash 是内存映射的)，片段不需要先载入 RAM。
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+class ClipStore {
+public:
+    enum class ErrorCode : uint8_t {
+        NONE = 0,
+        INVALID_SLOT,  // 槽位号越界
+        INVALID_CLIP,  // 格式或参数非法
+        TOO_LARGE,     // 片段超出槽位容量
+        NOT_WRITING,   // 没有正在进行的上传
+        BAD_OFFSET,    // 数据块的偏移与写入位置不连续 (丢包)
+        OVERFLOW,      // 写入超出 begin() 声明的大小
+        INCOMPLETE,    // end() 时数据尚未写满
+        FLASH_ERROR,   // 擦除或编程失败
+    };
+
+    enum class Format : uint8_t {
+        RAW = 0,
+        PALETTE = 1,
+        COUNT,
+    };
+
+    struct ClipInfo {
+        Format format;
+        uint16_t palette_count;   // 调色板颜色数 (RAW 格式为 0)
+        uint16_t frame_count;
+        uint16_t frame_period_ms; // 每帧显示时长
+    };
+
+    // 指向 Flash 中的一个有效片段
+    struct Clip {
+        ClipInfo info;
+        const uint8_t *palette; // palette_count * 3 字节 RGB
+        const uint8_t *frames;
+
+        [[nodiscard]] size_t frameSize() const;
+        [[nodiscard]] std::span<const uint8_t> frame(uint16_t index) const;
+    };
+
+    static constexpr uint32_t PAGE_SIZE = 2048; // F103ZE (大容量产品) 的 Flash 页大小
+    static constexpr uint8_t SLOT_COUNT = 8;
+
+    static ClipStore &getInstance();
+
+    /**
+     * @brief 开始向槽位写入一个新片段
+     */
+    ErrorCode begin(uint8_t slot, const ClipInfo &info);
+
+    /**
+     * @brief 写入一段数据 (调色板与帧数据连续排列)
+     * @param offset 该段数据在片段数据中的偏移，必须等于已写入的字节数
+     */
+    ErrorCode write(uint32_t offset, std::span<const uint8_t> data);
+
+    /**
+     * @brief 结束上传，写入 Header 使片段生效
+     */
+    ErrorCode end();
+
+    /**
+     * @brief 读取槽位中的片段
+     * @return 槽位为空、上传未完成或数据损坏时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<Clip> clip(uint8_t slot) const;
+
+    /**
+     * @brief 单个槽位的容量 (字节，含 Header)
+     */
+    [[nodiscard]] uint32_t slotSize() const;
+
+    ClipStore(const ClipStore &) = delete;
+    ClipStore &operator=(const ClipStore &) = delete;
+
+private:
+    // 片段头，位于槽位起始处
+    struct Header {
+        uint32_t magic;
+        Format format;
+        uint8_t reserved;
+        uint16_t palette_count;
+        uint16_t frame_count;
+        uint16_t frame_period_ms;
+        uint32_t data_size; // 调色板 + 帧数据的字节数
+    };
+    static_assert(sizeof(Header) == 16 && sizeof(Header) % 2 == 0);
+
+    static constexpr uint32_t MAGIC = 0x50494C43; // "CLIP"
+
+    ClipStore() = default;
+
+    [[nodiscard]] uintptr_t slotBase(uint8_t slot) const;
+
+    static uint32_t dataSize(const ClipInfo &info);
+
+    /**
+     * @brief 确保 address 所在的页已擦除
+     */
+    bool ensureErased(uintptr_t address);
+
+    /**
+     * @brief 编程一个半字 (F1 的 Flash 只能按 16 bit 编程)
+     */
+    bool programHalfWord(uintptr_t address, uint16_t value);
+
+    // 正在进行的上传
+    bool writing = false;
+    uint8_t write_slot = 0;
+    ClipInfo write_info{};
+    uint32_t write_size = 0;     // 数据总字节数
+    uint32_t write_cursor = 0;   // 已写入的字节数
+    uint8_t pending_byte = 0;    // 奇数位置上尚未凑成半字的字节
+    uintptr_t erased_until = 0;  // 已擦除区域的结束地址
+};
@@ -48,4 +48,35 @@ namespace Cobs {
         // .first(length) 会返回按照 length 长度截断的视图
         return buffer.first(write_index);
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief COBS 编码，并在末尾加上分界符
+     * @param input 原始数据
+     * @param output 编码结果，至少需要 input.size() + input.size() / 254 + 2 个字节
+     * @return 写入 output 的字节数 (含分界符)；output 放不下时返回 0
+     */
+    inline size_t encode(std::span<const uint8_t> input, std::span<uint8_t> output) {
+        if (output.size() < input.size() + input.size() / 254 + 2) return 0;
+
+        size_t code_index = 0;  // 当前路标的位置
+        size_t write_index = 1; // 写指针，第 0 个字节留给第一个路标
+        uint8_t code = 1;       // 路标到下一个 00 的距离
+
+        for (const uint8_t byte : input) {
+            if (byte != TAIL) {
+                output[write_index++] = byte;
+                code++;
+            }
+            // 遇到 00，或者一段已满 254 个非零字节，结束当前段
+            if (byte == TAIL || code == 0xFF) {
+                output[code_index] = code;
+                code_index = write_index++;
+                code = 1;
+            }
+        }
+
+        output[code_index] = code;
+        output[write_index++] = TAIL;
+        return write_index;
+    }
+}
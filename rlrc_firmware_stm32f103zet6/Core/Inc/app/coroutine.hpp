@@ -0,0 +1,166 @@
+/**
+ * 零堆分配的 C++20 协程运行时
+ *
+ * 用协程把「等下一帧 -> 算一帧 -> 再等」这类流程写成直线代码，取代 static 变量手写的状态机。
+ *
+ * - Task：协程的返回类型。协程帧从静态帧池中分配，不使用堆；帧池耗尽或帧过大时返回无效的 Task
+ * - Event：事件源。co_await 事件只是在事件里记下协程所在的帧池槽位，事件触发 (fire) 时按槽位直接恢复，
+ *   协程句柄在创建时登记在帧池中，等待与唤醒都不写入链表节点
+ *
+ * 协程只在主循环上下文中被恢复：中断里只 post 调度器任务，由任务调用 Event::fire()。
+ * 恢复一个协程的开销是一次标志检查加一次间接调用，再由编译器生成的代码按挂起点跳转。
+ * 这比直接调用手写的 switch 状态机贵：主机基准 (tests/bench_coroutine.cpp) 中同一流程每轮约为状态机的 2~3 倍，
+ * * 每次唤醒多出 2~3 ns；唤醒路径变慢到状态机的 4 倍以上时基准失败。
+ */
+
+#pragma once
+#include <array>
+#include <bit>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+
+namespace Coro {
+    /**
+     * @brief 固定大小的静态协程帧池
+     */
+    class FramePool {
+    public:
+        static constexpr size_t SLOT_SIZE = 256; // 单个协程帧的最大字节数
+        static constexpr size_t SLOT_COUNT = 4;  // 同时存在的协程数
+
+        static void *allocate(size_t size) noexcept;
+        static void release(void *frame) noexcept;
+
+        /**
+         * @brief 地址 (协程帧内的任意位置) 所在的槽位
+         */
+        static uint8_t slotOf(const void *address) noexcept {
+            const auto offset = reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(slots.data());
+            return static_cast<uint8_t>(offset / SLOT_SIZE);
+        }
+
+        /**
+         * @brief 登记槽位中协程的句柄，供事件直接恢复
+         */
+        static void setHandle(const uint8_t slot, const std::coroutine_handle<> handle) noexcept {
+            handles[slot] = handle;
+        }
+        static std::coroutine_handle<> handle(const uint8_t slot) noexcept { return handles[slot]; }
+
+        /**
+         * @brief 已分配的最高槽位 + 1，事件只需检查这之前的槽位
+         */
+        static uint8_t slotLimit() noexcept { return static_cast<uint8_t>(std::bit_width(used_mask)); }
+
+    private:
+        alignas(std::max_align_t) static inline std::array<std::array<std::byte, SLOT_SIZE>, SLOT_COUNT> slots{};
+        static inline std::array<std::coroutine_handle<>, SLOT_COUNT> handles{};
+        static inline uint32_t used_mask = 0;
+    };
+
+    /**
+     * @brief 协程句柄的拥有者
+     * 协程创建后处于挂起状态，调用 start() 后开始执行，直到第一次 co_await
+     */
+    class Task {
+    public:
+        struct promise_type {
+            static void *operator new(const size_t size) noexcept { return FramePool::allocate(size); }
+            static void operator delete(void *frame) noexcept { FramePool::release(frame); }
+
+            // 帧池分配失败时不抛异常，而是返回一个无效的 Task
+            static Task get_return_object_on_allocation_failure() noexcept { return Task{}; }
+
+            Task get_return_object() noexcept {
+                // promise 位于协程帧内，构造时已由它的地址得到所在的槽位
+                const auto handle = std::coroutine_handle<promise_type>::from_promise(*this);
+                FramePool::setHandle(slot, handle);
+                return Task{handle};
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+
+            // 写成构造函数：GCC 12 构造 promise 时不执行默认成员初始化器
+            promise_type() noexcept : slot(FramePool::slotOf(this)) {}
+
+            const uint8_t slot; // 所在的帧池槽位
+        };
+
+        Task() = default;
+        explicit Task(const std::coroutine_handle<promise_type> handle) : handle(handle) {}
+        Task(Task &&other) noexcept : handle(other.handle) { other.handle = nullptr; }
+        Task &operator=(Task &&other) noexcept;
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+        ~Task();
+
+        /**
+         * @brief 帧池分配是否成功
+         */
+        [[nodiscard]] bool valid() const { return static_cast<bool>(handle); }
+
+        /**
+         * @brief 开始执行协程
+         */
+        void start() const;
+
+        [[nodiscard]] bool done() const;
+
+    private:
+        std::coroutine_handle<promise_type> handle = nullptr;
+    };
+
+    /**
+     * @brief 可被 co_await 的事件
+     * 等待者按帧池槽位的顺序 (即协程创建的顺序) 恢复，多个协程每次被恢复的顺序固定
+     * 等待标志按槽位记录，仍在等待的协程被销毁后不要再触发该事件，以免唤醒复用同一槽位的新协程
+     */
+    class Event {
+    public:
+        /**
+         * @param condition 可选的就绪条件，co_await 时条件已满足则不挂起 (例如 DMA 早已空闲)
+         */
+        explicit Event(bool (*condition)() = nullptr) : condition(condition) {}
+
+        // 事件本身就是 awaiter，co_await 时不需要在协程帧里另存等待节点
+        bool await_ready() const noexcept { return condition != nullptr && condition(); }
+        void await_suspend(const std::coroutine_handle<Task::promise_type> handle) noexcept {
+            waiting[handle.promise().slot] = true;
+        }
+        void await_resume() const noexcept {}
+
+        /**
+         * @brief 触发事件，按槽位顺序恢复所有等待者
+         * 恢复过程中再次等待本事件的协程 (槽位已经检查过) 会在下一次触发时才被恢复
+         */
+        void fire() noexcept {
+            // 等待者与句柄都按槽位存放，每次唤醒只读标志、调句柄，不依赖上一次唤醒写下的指针
+            const uint8_t limit = FramePool::slotLimit();
+            for (uint8_t slot = 0; slot < limit; ++slot) {
+                if (!waiting[slot]) continue;
+                waiting[slot] = false;
+                FramePool::handle(slot).resume();
+            }
+        }
+
+        Event(const Event &) = delete;
+        Event &operator=(const Event &) = delete;
+
+    private:
+        bool (*condition)() = nullptr;
+        std::array<bool, FramePool::SLOT_COUNT> waiting{};
+    };
+
+    // --- 固件中的事件源 ---
+    // 每个帧节拍触发一次
+    inline Event nextTick;
+    // WS2812B 的 DMA 传输完成，定义在 maincxx.cpp (运行时本身不依赖驱动)
+    extern Event dmaComplete;
+    // 收到并处理完一批数据包
+    inline Event packetAvailable;
+} // namespace Coro
@@ -0,0 +1,32 @@
+/**
+ * 基于 DWT CYCCNT 的周期计数器
+ *
+ * Cortex-M3 的 DWT 单元提供一个随内核时钟 (72MHz) 自增的 32 位计数器，
+ * 读取只需一条 LDR，适合在中断与主循环中测量时间间隔。约 59.6 秒回绕一次，差值运算天然处理回绕。
+ */
+
+#pragma once
+#include <cstdint>
+
+#include "main.h"
+
+namespace CycleCounter {
+    /**
+     * @brief 开启 DWT 周期计数器，上电后调用一次
+     */
+    inline void init() {
+        CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    /**
+     * @brief 当前周期数
+     */
+    inline uint32_t now() { return DWT->CYCCNT; }
+
+    /**
+     * @brief 周期数换算为微秒
+     */
+    inline uint32_t toMicros(const uint32_t cycles) { return cycles / (SystemCoreClock / 1'000'000); }
+} // namespace CycleCounter
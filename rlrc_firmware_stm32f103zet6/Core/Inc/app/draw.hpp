@@ -0,0 +1,43 @@
+/**
+ * 设备端绘图图元
+ *
+ * 把矩形、直线、渐变、平移等常见操作放在 STM32 上光栅化，APP 发送一个小数据包即可，
+ * 不必拆成大量 SetPixel 或整帧数据。全部是整数运算，超出点阵的部分自动裁剪。
+ * 坐标为有符号数，图元可以部分位于点阵之外。
+ */
+
+#pragma once
+#include <cstdint>
+
+#include "color.hpp"
+#include "ws2812b.hpp"
+
+namespace Draw {
+    using Color::Rgb;
+
+    /**
+     * @brief 填充矩形，左上角 (x, y)，宽 w 高 h
+     */
+    void fillRect(WS2812B &fb, int16_t x, int16_t y, uint16_t w, uint16_t h, Rgb color);
+
+    /**
+     * @brief Bresenham 直线，包含两个端点
+     */
+    void line(WS2812B &fb, int16_t x0, int16_t y0, int16_t x1, int16_t y1, Rgb color);
+
+    /**
+     * @brief 线性渐变填满整帧：沿 (x0, y0) -> (x1, y1) 方向从 from 过渡到 to，两端之外保持端点颜色
+     */
+    void linearGradient(WS2812B &fb, int16_t x0, int16_t y0, int16_t x1, int16_t y1, Rgb from, Rgb to);
+
+    /**
+     * @brief 径向渐变填满整帧：圆心 (cx, cy) 为 from，距离 radius 处及以外为 to
+     */
+    void radialGradient(WS2812B &fb, int16_t cx, int16_t cy, uint16_t radius, Rgb from, Rgb to);
+
+    /**
+     * @brief 整帧平移 (dx, dy)
+     * @param wrap 为 true 时移出的像素从另一侧移入，否则空出的位置填黑
+     */
+    void shift(WS2812B &fb, int16_t dx, int16_t dy, bool wrap);
+} // namespace Draw
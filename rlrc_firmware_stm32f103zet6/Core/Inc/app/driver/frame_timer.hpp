@@ -0,0 +1,86 @@
+#pragma once
+
+#include "main.h"
+
+#include <atomic>
+#include <cstdint>
+
+// 帧节拍使用的 TIM2 句柄 (CubeMX 未配置 TIM2，由 FrameTimer 自行初始化)
+extern "C" TIM_HandleTypeDef htim2;
+
+/**
+ * @brief 硬件帧节拍
+ * TIM2 按设定的帧率产生更新中断，主循环在两次节拍之间用 __WFI() 休眠，
+ * 取代原先对 HAL_GetTick() 的忙等轮询。
+ * 同时统计每一帧从节拍中断到主循环真正开始处理之间的延迟 (帧起始抖动)。
+ */
+class FrameTimer {
+public:
+    static constexpr uint16_t DEFAULT_FPS = 100;
+
+    // TIM2 计数频率：72MHz / 7200 = 10kHz，即 0.1ms 分辨率
+    static constexpr uint32_t COUNTER_HZ = 10'000;
+
+    // 帧起始抖动统计 (单位：CPU 周期)
+    struct JitterStats {
+        uint32_t frames = 0;
+        uint32_t min_cycles = UINT32_MAX;
+        uint32_t max_cycles = 0;
+        uint64_t total_cycles = 0;
+        uint32_t overruns = 0; // 上一帧还没处理完，下一个节拍就到了
+    };
+
+    static FrameTimer &getInstance();
+
+    /**
+     * @brief 初始化 TIM2 并开始产生节拍
+     * @param fps 帧率 (1 - COUNTER_HZ)
+     */
+    void init(uint16_t fps = DEFAULT_FPS);
+
+    /**
+     * @brief 修改帧率，立即生效
+     */
+    void setFps(uint16_t fps);
+
+    [[nodiscard]] uint16_t getFps() const;
+
+    /**
+     * @brief 是否有尚未处理的节拍
+     */
+    [[nodiscard]] bool tickPending() const;
+
+    /**
+     * @brief 取走一个节拍，并记录本帧的起始抖动
+     * @return 有节拍时返回 true，调用者应在此时开始处理一帧
+     */
+    bool takeTick();
+
+    /**
+     * @brief 取出当前的抖动统计并清零
+     */
+    JitterStats takeStats();
+
+    /**
+     * @brief TIM2 更新中断时由回调调用
+     */
+    void on_tick();
+
+    FrameTimer(const FrameTimer &) = delete;
+    FrameTimer &operator=(const FrameTimer &) = delete;
+
+private:
+    FrameTimer() = default;
+
+    /**
+     * @brief 帧率限制在 1 - COUNTER_HZ 之间
+     */
+    static uint16_t clampFps(uint16_t fps);
+
+    uint16_t fps = DEFAULT_FPS;
+
+    std::atomic_uint32_t pending_ticks = 0;   // 中断产生、尚未被主循环取走的节拍数
+    std::atomic_uint32_t last_tick_cycles = 0; // 最近一次节拍中断时的 CYCCNT
+
+    JitterStats stats{};
+};
@@ -0,0 +1,87 @@
+/**
+ * Gamma 校正查找表 (编译期生成)
+ *
+ * 人眼对亮度的感知近似为幂函数，线性的 PWM 占空比在低亮度区会显得过亮、过渡台阶明显。
+ * 输出 = 255 * (输入 / 255) ^ gamma
+ *
+ * 表在编译期由 constexpr 计算得到，直接放在 Flash (.rodata) 中，运行时只需一次查表。
+ * 由于 <cmath> 的 std::pow/std::exp/std::log 在 C++20 中还不是 constexpr，这里自带一套简易实现。
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace Gamma {
+    namespace detail {
+        constexpr double LN2 = 0.69314718055994530942;
+
+        // ln(x), x > 0
+        // 先把 x 规约到 [0.5, 1) 区间: x = m * 2^k，再用 atanh 级数计算 ln(m)
+        constexpr double ln(double x) {
+            int k = 0;
+            while (x >= 1.0) { x /= 2.0; ++k; }
+            while (x < 0.5) { x *= 2.0; --k; }
+
+            // ln(m) = 2 * atanh(z), z = (m - 1) / (m + 1)，|z| <= 1/3，收敛很快
+            const double z = (x - 1.0) / (x + 1.0);
+            const double z2 = z * z;
+            double term = z;
+            double sum = 0.0;
+            for (int n = 1; n < 40; n += 2) {
+                sum += term / n;
+                term *= z2;
+            }
+            return 2.0 * sum + k * LN2;
+        }
+
+        // exp(y)
+        // 先把 y 缩小到 |y| < 1/1024 再做泰勒展开，最后平方回来
+        constexpr double exp(double y) {
+            int squarings = 0;
+            while (y > 1.0 / 1024 || y < -1.0 / 1024) { y /= 2.0; ++squarings; }
+
+            double term = 1.0;
+            double sum = 1.0;
+            for (int n = 1; n < 12; ++n) {
+                term *= y / n;
+                sum += term;
+            }
+            while (squarings-- > 0) sum *= sum;
+            return sum;
+        }
+
+        constexpr double pow(const double base, const double exponent) {
+            if (base <= 0.0) return 0.0;
+            return exp(exponent * ln(base));
+        }
+    } // namespace detail
+
+    /**
+     * @brief 生成 8bit -> 8bit 的 gamma 查找表
+     * @param gamma gamma 值 (1.0 表示线性，WS2812B 常用 2.2 ~ 2.8)
+     */
+    consteval std::array<uint8_t, 256> makeTable(const double gamma) {
+        std::array<uint8_t, 256> table{};
+        for (int i = 0; i < 256; ++i) {
+            const double out = 255.0 * detail::pow(i / 255.0, gamma);
+            table[i] = static_cast<uint8_t>(out + 0.5); // 四舍五入
+        }
+        return table;
+    }
+
+    /**
+     * @brief 生成 8bit -> 16bit (8.8 定点) 的 gamma 查找表
+     * 高 8 位为整数输出，低 8 位保留了 8bit 表舍入时丢掉的小数部分，供时间抖动 (temporal dithering) 使用
+     * 最大值为 255 << 8，叠加 8 位误差后仍不会溢出 uint16_t
+     * @param gamma gamma 值
+     */
+    consteval std::array<uint16_t, 256> makeTable16(const double gamma) {
+        std::array<uint16_t, 256> table{};
+        for (int i = 0; i < 256; ++i) {
+            const double out = 255.0 * 256.0 * detail::pow(i / 255.0, gamma);
+            table[i] = static_cast<uint16_t>(out + 0.5);
+        }
+        return table;
+    }
+} // namespace Gamma
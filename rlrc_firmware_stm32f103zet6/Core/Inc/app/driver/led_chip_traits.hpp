@@ -0,0 +1,77 @@
+/**
+ * 灯珠芯片特性 (LedChipTraits)
+ *
+ * 不同的单线灯珠协议只在以下几点上有差异：
+ * - 位速率 (800kHz / 400kHz)
+ * - "0" 码与 "1" 码的高电平时间 T0H / T1H
+ * - reset 低电平时间
+ * - 每颗灯珠的通道数与发送顺序 (GRB / RGB / GRBW ...)
+ *
+ * 这些参数以 constexpr 的形式给出，LedStrip<Chip> 在编译期据此换算出 TIM1 的 tick 数、缓冲区大小和通道顺序，
+ * 编码循环针对具体芯片展开，不存在逐 bit 的运行时分支。
+ */
+
+#pragma once
+#include <array>
+#include <concepts>
+#include <cstdint>
+
+namespace LedChip {
+    // TIM1 计数时钟 (APB2 72MHz，预分频为 0)
+    constexpr uint32_t TIMER_CLOCK_HZ = 72'000'000;
+
+    // 逻辑通道，同时也是帧缓冲/误差缓冲中的下标
+    enum Channel : uint8_t { R = 0, G = 1, B = 2, W = 3 };
+
+    /**
+     * @brief 纳秒换算为 TIM1 tick 数 (四舍五入)
+     */
+    consteval uint16_t nsToTicks(const uint32_t ns) {
+        return static_cast<uint16_t>((static_cast<uint64_t>(ns) * TIMER_CLOCK_HZ + 500'000'000) / 1'000'000'000);
+    }
+
+    // WS2812B：800kHz，GRB
+    // T0H/T1H 取 444ns/889ns，即原先实测稳定的 32/64 ticks
+    struct Ws2812b {
+        static constexpr uint32_t BIT_RATE_HZ = 800'000;
+        static constexpr uint32_t T0H_NS = 444;
+        static constexpr uint32_t T1H_NS = 889;
+        // 需要 >50µs 的低电平，国产克隆版通常需要更长的 reset 时间来避免串色
+        static constexpr uint32_t RESET_US = 125;
+        static constexpr std::array<Channel, 3> CHANNEL_ORDER{G, R, B};
+        static constexpr uint16_t MA_PER_CHANNEL = 20;
+    };
+
+    // SK6812 RGBW：800kHz，GRBW，白色通道由 RGB 的公共部分提取
+    struct Sk6812Rgbw {
+        static constexpr uint32_t BIT_RATE_HZ = 800'000;
+        static constexpr uint32_t T0H_NS = 300;
+        static constexpr uint32_t T1H_NS = 600;
+        static constexpr uint32_t RESET_US = 80;
+        static constexpr std::array<Channel, 4> CHANNEL_ORDER{G, R, B, W};
+        static constexpr uint16_t MA_PER_CHANNEL = 20;
+    };
+
+    // WS2811 低速模式：400kHz，RGB
+    struct Ws2811 {
+        static constexpr uint32_t BIT_RATE_HZ = 400'000;
+        static constexpr uint32_t T0H_NS = 500;
+        static constexpr uint32_t T1H_NS = 1200;
+        static constexpr uint32_t RESET_US = 280;
+        static constexpr std::array<Channel, 3> CHANNEL_ORDER{R, G, B};
+        static constexpr uint16_t MA_PER_CHANNEL = 20;
+    };
+} // namespace LedChip
+
+/**
+ * @brief 对芯片特性类型的约束
+ */
+template<typename T>
+concept LedChipTraits = requires {
+    { T::BIT_RATE_HZ } -> std::convertible_to<uint32_t>;
+    { T::T0H_NS } -> std::convertible_to<uint32_t>;
+    { T::T1H_NS } -> std::convertible_to<uint32_t>;
+    { T::RESET_US } -> std::convertible_to<uint32_t>;
+    { T::MA_PER_CHANNEL } -> std::convertible_to<uint16_t>;
+    T::CHANNEL_ORDER.size();
+} && (T::CHANNEL_ORDER.size() == 3 || T::CHANNEL_ORDER.size() == 4);
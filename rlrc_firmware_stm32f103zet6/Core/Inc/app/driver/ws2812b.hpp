@@ -1,16 +1,33 @@
 #pragma once
 
 #include "main.h"
+#include "gamma.hpp"
+#include "led_chip_traits.hpp"
 
 #include <array>
 #include <atomic>
 #include <cstdint> // uint8_t, uint16_t...
 #include <span>
+#include <type_traits>
 
 // 外部链接 CubeMX 生成的 TIM1 句柄
 extern "C" TIM_HandleTypeDef htim1;
 
-class WS2812B {
+// 点阵尺寸，默认为板载的 5x5；主机测试用 -DLED_MATRIX_WIDTH=40 -DLED_MATRIX_HEIGHT=25 评估 1000 颗灯珠的开销
+#ifndef LED_MATRIX_WIDTH
+#define LED_MATRIX_WIDTH 5
+#endif
+#ifndef LED_MATRIX_HEIGHT
+#define LED_MATRIX_HEIGHT 5
+#endif
+
+/**
+ * @brief 单线灯珠 (WS2812B 及其变种) 驱动
+ * 基于 TIM1 PWM + DMA，芯片差异由 LedChipTraits 在编译期给出
+ * @tparam Chip 芯片特性，见 led_chip_traits.hpp
+ */
+template<LedChipTraits Chip>
+class LedStrip {
 public:
     // 错误代码
     enum class ErrorCode : uint8_t {
@@ -21,26 +38,77 @@ public:
         INVALID_FRAME_SIZE,  // setFrame() 帧数据长度异常
     };
 
-    // 灯珠数量
-    static constexpr uint16_t LED_COUNT = 5 * 5;
+    // 画面切换时的过渡效果
+    enum class Transition : uint8_t {
+        NONE = 0, // 直接切换
+        FADE,     // 整帧交叉淡入淡出
+        WIPE,     // 从左到右擦除，边缘有一列宽的软过渡
+        DISSOLVE, // 每颗灯珠在随机的时刻快速淡入
+        COUNT,
+    };
+
+    // 点阵尺寸与灯珠数量 (按行排列，index = y * WIDTH + x)
+    static constexpr uint8_t WIDTH = LED_MATRIX_WIDTH;
+    static constexpr uint8_t HEIGHT = LED_MATRIX_HEIGHT;
+    static constexpr uint16_t LED_COUNT = WIDTH * HEIGHT;
+
+    // 每颗灯珠的通道数 (RGB = 3，RGBW = 4)
+    static constexpr uint8_t CHANNEL_COUNT = Chip::CHANNEL_ORDER.size();
+    static constexpr bool HAS_WHITE = CHANNEL_COUNT == 4;
+
+    // 码元周期 (WS2812B: 72MHz / 90 ticks = 800kHz)
+    static constexpr uint16_t PWM_PERIOD_TICKS = LedChip::TIMER_CLOCK_HZ / Chip::BIT_RATE_HZ;
+
+    // 码元 (WS2812B: "1" 码 64 ticks ≈ 0.89µs，"0" 码 32 ticks ≈ 0.44µs)
+    static constexpr uint16_t PWM_HIGH_VAL = LedChip::nsToTicks(Chip::T1H_NS); // "1" 码
+    static constexpr uint16_t PWM_LOW_VAL = LedChip::nsToTicks(Chip::T0H_NS); // "0" 码
+    static_assert(PWM_LOW_VAL < PWM_HIGH_VAL && PWM_HIGH_VAL < PWM_PERIOD_TICKS, "T0H < T1H < 码元周期");
+
+    // 每颗灯珠的 bit 数 (WS2812B: 24 bits，G, R, B)
+    static constexpr uint16_t BITS_PER_LED = CHANNEL_COUNT * 8;
 
-    // WS2812B 码元 (72MHz / 90 ticks = 800kHz)
-    static constexpr uint16_t PWM_HIGH_VAL = 64; // "1" 码 (0.8µs)
-    static constexpr uint16_t PWM_LOW_VAL = 32; // "0" 码 (0.4µs)
+    // 重置码：用若干个占空比为 0 的码元实现 reset 所需的低电平
+    static constexpr uint16_t RESET_PULSES = Chip::RESET_US * (Chip::BIT_RATE_HZ / 1'000) / 1'000;
 
-    // WS2812B 协议需 24 bits (G, R, B)
-    static constexpr uint16_t BITS_PER_LED = 24;
+    // WS2812B 的时序改为由 ns/µs 换算而来，必须与原先实测稳定的 tick 数逐一相同
+    static_assert(!std::is_same_v<Chip, LedChip::Ws2812b> ||
+                          (PWM_LOW_VAL == 32 && PWM_HIGH_VAL == 64 && PWM_PERIOD_TICKS == 90 && RESET_PULSES == 100),
+                  "WS2812B 时序与原先的 32/64/90 ticks 和 100 个 reset 码元不一致");
 
-    // 重置码
-    // 需要 >50µs 的低电平，用更多低电平实现
-    // 国产WS2812B克隆版通常需要更长的reset时间来避免串色
-    static constexpr uint16_t RESET_PULSES = 100; // 增加到100个脉冲 (约125µs)
+    // 各通道的 gamma 值 (1.0 为线性)
+    // 不同批次灯珠的三色响应不一致时，可分别调整
+    static constexpr double GAMMA_R = 2.6;
+    static constexpr double GAMMA_G = 2.6;
+    static constexpr double GAMMA_B = 2.6;
+    static constexpr double GAMMA_W = 2.6; // 仅 RGBW 芯片使用
+
+    // 编译期生成的各通道 gamma 查找表 (8.8 定点)，位于 Flash
+    static constexpr std::array<uint16_t, 256> GAMMA_LUT_R = Gamma::makeTable16(GAMMA_R);
+    static constexpr std::array<uint16_t, 256> GAMMA_LUT_G = Gamma::makeTable16(GAMMA_G);
+    static constexpr std::array<uint16_t, 256> GAMMA_LUT_B = Gamma::makeTable16(GAMMA_B);
+    static constexpr std::array<uint16_t, 256> GAMMA_LUT_W = Gamma::makeTable16(GAMMA_W);
+
+    // 按逻辑通道 (R, G, B, W) 排列的查找表
+    static constexpr std::array<const std::array<uint16_t, 256> *, 4> GAMMA_LUTS{&GAMMA_LUT_R, &GAMMA_LUT_G,
+                                                                                  &GAMMA_LUT_B, &GAMMA_LUT_W};
+
+    // 功耗估算参数
+    // 单个通道满亮度 (255) 时的电流，以及每颗灯珠芯片本身的静态电流
+    static constexpr uint16_t MA_PER_CHANNEL = Chip::MA_PER_CHANNEL;
+    static constexpr uint16_t IDLE_MA_PER_LED = 1;
+    static constexpr uint16_t DEFAULT_POWER_BUDGET_MA = 2000; // 默认电源预算 (mA)
+
+    // 默认过渡时长 (ms)
+    static constexpr uint16_t DEFAULT_TRANSITION_MS = 300;
+
+    // 限流放宽的迟滞量：可放宽的幅度超过该值才重新编码，避免在预算边缘来回抖动
+    static constexpr uint8_t POWER_LIMIT_HYSTERESIS = 8;
 
     // PWM 缓冲区的总大小
     // 灯数 * 24 bit + RESET
     static constexpr uint16_t PWM_BUFFER_SIZE = (LED_COUNT * BITS_PER_LED) + RESET_PULSES;
 
-    static WS2812B &getInstance();
+    static LedStrip &getInstance();
 
     /**
      * @brief 将所有像素设为黑色 (关闭)
@@ -57,6 +125,11 @@ public:
      */
     void setPixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b);
 
+    /**
+     * @brief 读取帧缓冲中单个像素的颜色 (R, G, B)，坐标越界时返回黑色
+     */
+    [[nodiscard]] std::array<uint8_t, 3> getPixel(uint8_t x, uint8_t y) const;
+
     /**
      * 将所有像素设为同一颜色
      * @param r 红色 (0-255)
@@ -72,11 +145,87 @@ public:
      */
     void setFrame(std::span<const uint8_t> frameData);
 
+    /**
+     * @brief 设置全局亮度
+     * 亮度与 gamma 校正在 render() 展开 PWM 码元时一并完成，不需要额外的遍历
+     * @param value 亮度 (0-255，255 为原始亮度)
+     */
+    void setBrightness(uint8_t value);
+
+    [[nodiscard]] uint8_t getBrightness() const;
+
+    /**
+     * @brief 开关时间抖动 (temporal dithering)
+     * gamma 校正与亮度缩放在 16 bit 精度下进行，低 8 位小数通过逐帧误差累积分散到相邻的刷新帧中，
+     * 低亮度渐变不再被压成几个台阶。默认关闭。
+     * 开启后，含小数部分的灯珠在每次 render() 都会重新编码，因此需要以高于内容帧率的频率持续调用 render()；
+     * 只有抖动让某个码元真正发生变化时才会重新发送，否则仍计为跳过的渲染
+     */
+    void setDithering(bool enable);
+
+    [[nodiscard]] bool isDithering() const;
+
+    /**
+     * @brief 设置电源预算
+     * 每次 render() 在编码的同时累计所有通道的输出值估算整帧电流，
+     * 超出预算时自动压低整帧亮度 (与 setBrightness() 叠加)，直到回落到预算以内
+     * @param milliamps 预算电流 (mA)，0 表示不限流
+     */
+    void setPowerBudget(uint16_t milliamps);
+
+    [[nodiscard]] uint16_t getPowerBudget() const;
+
+    /**
+     * @brief 获取最近一次编码后估算的整帧电流 (mA)，已包含亮度与自动限流的作用
+     */
+    [[nodiscard]] uint32_t getEstimatedCurrent() const;
+
+    /**
+     * @brief 获取当前自动限流系数 (255 表示未限流)
+     */
+    [[nodiscard]] uint8_t getPowerLimit() const;
+
+    /**
+     * @brief 设置 beginTransition() 使用的过渡效果
+     * 过渡默认只用于模式、页面切换和开关；APP 连续推送的整帧 (CMD_SET_FRAME) 自身就是动画，
+     * 默认直接显示，只有 frames 为 true 时才在帧与帧之间过渡
+     * @param type 过渡类型
+     * @param duration_ms 过渡时长 (ms)，0 等同于 Transition::NONE
+     * @param frames 整帧刷新是否也使用过渡
+     */
+    void setTransition(Transition type, uint16_t duration_ms, bool frames = false);
+
+    [[nodiscard]] Transition getTransition() const;
+
+    [[nodiscard]] uint16_t getTransitionDuration() const;
+
+    /**
+     * @brief 整帧刷新是否使用过渡
+     */
+    [[nodiscard]] bool getTransitionFrames() const;
+
+    /**
+     * @brief 开始一次过渡
+     * 记下当前显示的画面，之后对帧缓冲的修改会在过渡时长内从该画面渐变过去。应在修改帧缓冲之前调用。
+     * 混合在 render() 编码时逐灯完成 (整数 alpha)，不需要额外的帧缓冲遍历；
+     * 过渡进行中再次调用时，从当前的混合画面开始新的过渡
+     */
+    void beginTransition();
+
+    [[nodiscard]] bool isTransitioning() const;
+
     /**
      * @brief 渲染
      * 将 setPixel() 设置的颜色转换并启动 DMA 传输
+     * 若编码后 pwm_buffer 与上次发送的内容相同 (颜色未变化，抖动也没有改变任何码元)，则跳过本次渲染
+     * @param force 为 true 时忽略脏标记，强制重新发送整帧
      */
-    void render();
+    void render(bool force = false);
+
+    /**
+     * @brief 上一帧的 DMA 传输是否仍在进行
+     */
+    [[nodiscard]] bool isBusy() const;
 
     /**
      * @brief DMA 传输完成时由中断回调调用的公共函数
@@ -89,12 +238,92 @@ public:
      */
     ErrorCode getLastError();
 
-    WS2812B(const WS2812B &) = delete;
-    WS2812B &operator=(const WS2812B &) = delete;
+    /**
+     * @brief 获取因帧内容未变化而被跳过的 render() 次数
+     */
+    [[nodiscard]] uint32_t getSkippedRenderCount() const;
+
+    LedStrip(const LedStrip &) = delete;
+    LedStrip &operator=(const LedStrip &) = delete;
 
 private:
-    WS2812B() = default;
-    ~WS2812B() = default;
+    LedStrip() = default;
+    ~LedStrip() = default;
+
+    // 脏位图的字数 (每个 uint32_t 记录 32 颗灯珠)
+    static constexpr uint16_t DIRTY_WORDS = (LED_COUNT + 31) / 32;
+
+    /**
+     * @brief 标记某颗灯珠颜色已变化，需要在下次 render() 时重新编码
+     */
+    void markDirty(uint16_t led_index);
+
+    /**
+     * @brief 将所有灯珠标记为脏 (例如亮度变化后需要全部重新编码)
+     */
+    void markAllDirty();
+
+    /**
+     * @brief 本帧要编码的灯珠：脏灯珠，以及开启抖动时正在抖动的灯珠
+     */
+    [[nodiscard]] std::array<uint32_t, DIRTY_WORDS> pendingLeds() const;
+
+    /**
+     * @brief 是否有灯珠的校正值带有小数部分 (需要继续抖动)
+     */
+    [[nodiscard]] bool hasDitherLeds() const;
+
+    /**
+     * @brief 亮度与限流系数合成的缩放系数 (0-256)
+     */
+    [[nodiscard]] uint32_t channelScale() const;
+
+    /**
+     * @brief 某颗灯珠按逻辑通道 (R, G, B, W) 排列的输入值
+     * 过渡期间先与旧画面混合；RGBW 芯片把 RGB 的公共部分提取为白色分量
+     */
+    [[nodiscard]] std::array<uint8_t, 4> channelInput(uint16_t led_index) const;
+
+    /**
+     * @brief 将单颗灯珠的 RGB (RGBW 芯片先提取白色分量) 经 gamma 校正、亮度缩放、时间抖动后
+     * 按芯片的通道顺序展开为 BITS_PER_LED 个 PWM 码元，写入 pwm_buffer 对应位置
+     * 同时更新 dither_leds 中该灯珠的位，以及该灯珠的功耗统计
+     * @return 是否有码元与 pwm_buffer 中原有的不同
+     */
+    bool encodeLed(uint16_t led_index);
+
+    /**
+     * @brief 编码所有脏灯珠与正在抖动的灯珠
+     * @return 是否有码元发生变化
+     */
+    bool encodeDirtyLeds();
+
+    /**
+     * @brief 撤销 leds 中各灯珠在本帧按 old_scale 编码时对抖动误差的推进
+     * 限流系数变化导致同一帧编码两遍时使用，保证抖动误差每帧只推进一次
+     */
+    void rewindDither(const std::array<uint32_t, DIRTY_WORDS> &leds, uint32_t old_scale);
+
+    /**
+     * @brief 按当前时间推进过渡进度，过渡期间每一帧都要重新编码所有灯珠
+     */
+    void updateTransition();
+
+    /**
+     * @brief 过渡期间某颗灯珠新画面所占的权重 (0-256)
+     */
+    [[nodiscard]] uint16_t transitionAlpha(uint16_t led_index) const;
+
+    /**
+     * @brief 过渡期间某颗灯珠实际显示的颜色 (旧画面与新画面按 alpha 混合)
+     */
+    [[nodiscard]] std::array<uint8_t, 3> blendedColor(uint16_t led_index) const;
+
+    /**
+     * @brief 根据本帧的功耗估算调整自动限流系数
+     * @return 限流系数是否发生变化 (变化时所有灯珠已被标脏，需要重新编码)
+     */
+    bool updatePowerLimit();
 
     // 缓冲区 1: 存储灯珠的 RGB "目标"颜色
     // [LED_COUNT][3] -> 25 * 3 = 75 字节
@@ -102,9 +331,60 @@ private:
     std::array<std::array<uint8_t, 3>, LED_COUNT> led_data{};
 
     // 缓冲区 2: 存储发送给 DMA 的 PWM "脉宽"值
-    // (25 * 24 + 50) * 2 字节 = 1300 字节 (uint16_t)
+    // (25 * 24 + 100) * 2 字节 = 1400 字节 (uint16_t)
+    // 跨帧保留：只有变化的灯珠会被重写，末尾的 reset 区始终为 0
     std::array<uint16_t, PWM_BUFFER_SIZE> pwm_buffer{};
 
+    // 逐灯脏位图：bit 为 1 表示该灯珠颜色变化后尚未重新编码进 pwm_buffer
+    // 初始全部置位，保证第一次 render() 会完整编码一遍
+    std::array<uint32_t, DIRTY_WORDS> dirty_leds = [] {
+        std::array<uint32_t, DIRTY_WORDS> bits{};
+        bits.fill(0xFFFFFFFF);
+        return bits;
+    }();
+
+    // 脏标记：led_data 自上次成功渲染以来是否被修改
+    // 初始为 true，保证上电后的第一次 render() 一定会发送
+    bool frame_dirty = true;
+    bool pwm_pending = false;     // pwm_buffer 中有尚未发送出去的变化
+    uint32_t skipped_renders = 0; // 被跳过的冗余渲染计数
+
+    uint8_t brightness = 255; // 全局亮度
+
+    bool dithering = false; // 时间抖动开关
+
+    uint16_t power_budget = DEFAULT_POWER_BUDGET_MA; // 电源预算 (mA)，0 为不限流
+    uint8_t power_limit = 255; // 自动限流系数，与 brightness 相乘后作用于每个通道
+
+    // 每颗灯珠所有通道最终输出值之和，以及整帧的累计值
+    // 只在编码时增量更新，因此估算与增量编码一样是 O(变化像素数)
+    std::array<uint16_t, LED_COUNT> led_power{};
+    uint32_t power_sum = 0;
+
+    // 抖动位图：bit 为 1 表示该灯珠校正后的 16 bit 值带有小数部分，每次刷新都要重新编码
+    std::array<uint32_t, DIRTY_WORDS> dither_leds{};
+
+    // 每颗灯珠每个通道的抖动误差累积 (8.8 定点的低 8 位)，按逻辑通道 (R, G, B[, W]) 存放
+    // 这就是高精度帧缓冲的全部额外开销：25 * 3 = 75 字节，而非一整份 uint16_t 帧缓冲
+    std::array<std::array<uint8_t, CHANNEL_COUNT>, LED_COUNT> dither_error{};
+
+    // 过渡状态
+    Transition transition = Transition::FADE;
+    uint16_t transition_ms = DEFAULT_TRANSITION_MS;
+    bool transition_frames = false;    // 整帧刷新也过渡 (需要 APP 显式开启)
+    bool transitioning = false;
+    uint32_t transition_start = 0;     // 开始时刻 (HAL_GetTick)
+    uint16_t transition_progress = 0;  // 进度 (0-256)
+    std::array<std::array<uint8_t, 3>, LED_COUNT> prev_data{}; // 过渡开始时显示的画面
+    std::array<uint8_t, LED_COUNT> dissolve_order{};           // DISSOLVE 中每颗灯珠开始淡入的时刻 (0-255)
+    uint32_t dissolve_seed = 0x2545F491;
+
     std::atomic_bool dma_transfer_complete_flag = true; // 初始状态为「已完成」
     std::atomic<ErrorCode> last_error{ErrorCode::NONE}; // 错误状态变量
 };
+
+// 当前硬件所用的灯珠芯片，更换灯带时只需修改这里
+using ActiveLedChip = LedChip::Ws2812b;
+
+// 项目中的灯带单例类型
+using WS2812B = LedStrip<ActiveLedChip>;
@@ -0,0 +1,92 @@
+/**
+ * 动画管理器
+ *
+ * - 效果注册表：模式 ID 即注册表下标，新增效果只需实现 Effect 并在 animation_manager.cpp 的注册表中加一行
+ * - 模式切换：setMode() 激活新效果并调用其 enter()
+ * - 帧预算：记录每个效果 update() 的耗时 (CPU 周期)，超过预算的帧计为 overrun
+ *
+ * update() 由主循环在每个帧节拍调用，只有当前效果的帧周期到了才会调用该效果的 update()。
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "effect.hpp"
+
+class AnimationManager {
+public:
+    static constexpr uint8_t MAX_EFFECTS = 16;
+
+    // 内置的模式 ID
+    enum Mode : uint8_t {
+        MODE_CANVAS = 0,    // 静态/画板模式
+        MODE_DIFFUSION = 1, // 扩散动画模式
+        MODE_KEYFRAME = 2,  // 关键帧插值模式
+        MODE_PAGES = 3,     // RAM 帧页模式
+        MODE_CLIP = 4,      // Flash 片段播放模式
+        MODE_VM = 5,        // 字节码效果模式
+        MODE_PLASMA = 6,    // 等离子动画模式
+        MODE_CLOUDS = 7,    // 云层 (噪声) 动画模式
+        MODE_LIFE = 8,      // 元胞自动机模式
+        MODE_FIRE = 9,      // 火焰模式
+        MODE_TEXT = 10,     // 文字跑马灯模式
+    };
+
+    // 单个效果的耗时统计 (CPU 周期)
+    struct EffectStats {
+        uint32_t frames = 0;
+        uint64_t total_cycles = 0;
+        uint32_t max_cycles = 0;
+        uint32_t overruns = 0; // 超出帧预算的帧数
+    };
+
+    static AnimationManager &getInstance();
+
+    /**
+     * @brief 切换效果
+     * @return 模式 ID 未注册时返回 false，当前效果不变
+     */
+    bool setMode(uint8_t mode);
+
+    [[nodiscard]] uint8_t getMode() const;
+
+    /**
+     * @brief 修改指定效果的参数块
+     * @return 模式 ID 未注册或参数越界时返回 false
+     */
+    bool setParams(uint8_t mode, uint8_t offset, std::span<const uint8_t> values);
+
+    /**
+     * @brief 在每个帧节拍调用，按需推进当前效果
+     * @param now 当前时间 (ms)
+     */
+    void update(uint32_t now);
+
+    /**
+     * @brief 设置单次 update() 的预算 (CPU 周期)，0 表示不检查
+     */
+    void setFrameBudget(uint32_t cycles);
+
+    /**
+     * @brief 模式 ID 对应的效果，未注册时返回 nullptr
+     */
+    [[nodiscard]] const Effect *effect(uint8_t mode) const;
+
+    /**
+     * @brief 取出效果耗时统计并清零
+     */
+    EffectStats takeStats(uint8_t mode);
+
+private:
+    AnimationManager();
+
+    std::array<Effect *, MAX_EFFECTS> effects{};
+    std::array<EffectStats, MAX_EFFECTS> stats{};
+
+    uint8_t active_mode = MODE_CANVAS;
+    bool entered = false;        // 当前效果是否已经 enter()
+    uint32_t next_frame_time = 0; // 当前效果下一次 update() 的时间 (ms)
+    uint32_t frame_budget = 0;
+};
@@ -0,0 +1,12 @@
+#pragma once
+#include "effect.hpp"
+
+/**
+ * @brief 静态/画板模式：不主动绘制，帧缓冲由 APP 通过 SetPixel / SetFrame 写入
+ */
+class CanvasEffect final : public Effect {
+public:
+    CanvasEffect() : Effect("canvas", 0, {}) {}
+
+    void update(uint32_t, WS2812B &) override {}
+};
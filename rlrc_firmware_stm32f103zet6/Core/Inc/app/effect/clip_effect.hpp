@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+
+#include "effect.hpp"
+
+/**
+ * @brief 播放 Flash 中的动画片段 (见 clip_store.hpp)
+ *
+ * 帧数据从内存映射的 Flash 中读出，只在换帧时写入帧缓冲：RAW 格式整帧拷贝，PALETTE 格式逐灯查表。
+ * 除帧缓冲外不需要额外的 RAM，播放时也不需要 APP 或 Wi-Fi 参与。
+ */
+class ClipEffect final : public Effect {
+public:
+    static ClipEffect &getInstance();
+
+    /**
+     * @brief 从头播放某个槽位的片段
+     * @param loop 为 false 时停在最后一帧
+     * @return 槽位中没有有效片段时返回 false
+     */
+    bool play(uint8_t slot, bool loop);
+
+    void enter(WS2812B &fb) override;
+    void update(uint32_t t, WS2812B &fb) override;
+
+private:
+    // 每个帧节拍检查一次，片段自己的帧率由其 frame_period_ms 决定
+    ClipEffect() : Effect("clip", 0, {}) {}
+
+    uint8_t slot = 0;
+    bool looping = true;
+    bool restart = true;       // 下一次 update() 从第 0 帧开始
+    uint32_t start_time = 0;
+    uint32_t shown_frame = UINT32_MAX; // 已写入帧缓冲的帧序号
+};
@@ -0,0 +1,20 @@
+#pragma once
+#include "effect.hpp"
+
+/**
+ * @brief 云层：随时间缓慢翻滚的分形噪声，深蓝到白色
+ */
+class CloudEffect final : public Effect {
+public:
+    // 参数下标
+    enum Param : uint8_t {
+        SPEED = 0,  // 翻滚速度
+        SCALE,      // 云团大小，越大云团越碎
+        BRIGHTNESS, // 亮度 (255 为满亮度)
+    };
+
+    // 每 40ms 更新一次 (25 FPS)
+    CloudEffect() : Effect("clouds", 40, {8, 24, 255}) {}
+
+    void update(uint32_t t, WS2812B &fb) override;
+};
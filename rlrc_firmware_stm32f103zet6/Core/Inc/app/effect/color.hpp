@@ -0,0 +1,114 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace Color {
+    struct Rgb {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+
+        constexpr bool operator==(const Rgb &) const = default;
+    };
+
+    struct Hsv {
+        uint8_t h;
+        uint8_t s;
+        uint8_t v;
+    };
+
+    /**
+     * @brief HSV 转 RGB，用于生成平滑的彩虹色
+     * h: 0-255, s: 0-255, v: 0-255
+     */
+    constexpr void hsv2rgb(uint8_t h, uint8_t s, uint8_t v, uint8_t &r, uint8_t &g, uint8_t &b) {
+        unsigned char region = 0, remainder = 0, p = 0, q = 0, t = 0;
+
+        if (s == 0) { r = v; g = v; b = v; return; }
+
+        region = h / 43;
+        remainder = (h - (region * 43)) * 6;
+
+        p = (v * (255 - s)) >> 8;
+        q = (v * (255 - ((s * remainder) >> 8))) >> 8;
+        t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+        switch (region) {
+            case 0: r = v; g = t; b = p; break;
+            case 1: r = q; g = v; b = p; break;
+            case 2: r = p; g = v; b = t; break;
+            case 3: r = p; g = q; b = v; break;
+            case 4: r = t; g = p; b = v; break;
+            default: r = v; g = p; b = q; break;
+        }
+    }
+
+    // --- 查表版本：不做除法，适合逐像素或整行批量调用 ---
+
+    /**
+     * @brief x * scale / 256，scale = 255 时原样返回
+     */
+    constexpr uint8_t scale8(const uint8_t x, const uint8_t scale) {
+        return static_cast<uint8_t>((x * (scale + 1u)) >> 8);
+    }
+
+    // 满饱和度、满亮度的 256 级色相表，在编译期由 hsv2rgb() 生成并放在 Flash 中
+    inline constexpr std::array<Rgb, 256> HUE_LUT = [] {
+        std::array<Rgb, 256> table{};
+        for (int h = 0; h < 256; ++h) {
+            hsv2rgb(static_cast<uint8_t>(h), 255, 255, table[h].r, table[h].g, table[h].b);
+        }
+        return table;
+    }();
+
+    /**
+     * @brief HSV 转 RGB：查色相表，再按饱和度向白色混合、按亮度缩放，只有乘法和移位
+     */
+    constexpr Rgb hsv(const uint8_t h, const uint8_t s, const uint8_t v) {
+        const Rgb hue = HUE_LUT[h];
+        const uint8_t white = 255 - s; // 饱和度不足的部分补成白色
+        return {scale8(static_cast<uint8_t>(scale8(hue.r, s) + white), v),
+                scale8(static_cast<uint8_t>(scale8(hue.g, s) + white), v),
+                scale8(static_cast<uint8_t>(scale8(hue.b, s) + white), v)};
+    }
+
+    /**
+     * @brief 整行批量 HSV 转 RGB，处理 min(in.size(), out.size()) 个像素
+     * 着色管线先算出一整行的 HSV 再调用一次，循环体里只有查表、乘法和移位
+     */
+    inline void hsv2rgb(const std::span<const Hsv> in, const std::span<Rgb> out) {
+        const size_t count = in.size() < out.size() ? in.size() : out.size();
+        for (size_t i = 0; i < count; ++i) out[i] = hsv(in[i].h, in[i].s, in[i].v);
+    }
+
+    /**
+     * @brief 16 色渐变调色板：下标 0-255 均匀分布在 16 个颜色上，相邻颜色之间线性插值，首尾相接
+     *
+     * 不需要首尾相接的渐变 (如火焰) 把下标限制在 0-240，240 正好是最后一个颜色。
+     * 逐像素插值比直接查 256 项的表慢，热点路径上可以在编译期把它展开成表。
+     */
+    struct Palette16 {
+        std::array<Rgb, 16> entries;
+
+        constexpr Rgb operator[](const uint8_t index) const {
+            const Rgb a = entries[index >> 4];
+            const Rgb b = entries[((index >> 4) + 1) & 15];
+            const uint8_t frac = static_cast<uint8_t>((index & 15) << 4); // 0-240
+            const auto mix = [frac](const uint8_t from, const uint8_t to) {
+                return static_cast<uint8_t>(from + (((to - from) * frac) >> 8));
+            };
+            return {mix(a.r, b.r), mix(a.g, b.g), mix(a.b, b.b)};
+        }
+
+        /**
+         * @brief 整行批量查调色板，处理 min(in.size(), out.size()) 个像素
+         */
+        void map(const std::span<const uint8_t> in, const std::span<Rgb> out) const {
+            const size_t count = in.size() < out.size() ? in.size() : out.size();
+            for (size_t i = 0; i < count; ++i) out[i] = (*this)[in[i]];
+        }
+    };
+
+    static_assert(hsv(0, 255, 255) == Rgb{255, 0, 0} && hsv(0, 0, 255) == Rgb{255, 255, 255});
+} // namespace Color
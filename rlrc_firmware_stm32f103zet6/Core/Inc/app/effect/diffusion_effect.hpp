@@ -0,0 +1,20 @@
+#pragma once
+#include "effect.hpp"
+
+/**
+ * @brief 彩色扩散：从中心向外移动的彩虹波纹
+ */
+class DiffusionEffect final : public Effect {
+public:
+    // 参数下标
+    enum Param : uint8_t {
+        WAVE_SPEED = 0, // 波纹速度，相位 = t * WAVE_SPEED / 1000 (弧度)
+        HUE_SPEED,      // 色相变化速度，色相 = t * HUE_SPEED / 1000
+        SATURATION,     // 饱和度
+    };
+
+    // 每 50ms 更新一次 (20 FPS)
+    DiffusionEffect() : Effect("diffusion", 50, {5, 100, 255}) {}
+
+    void update(uint32_t t, WS2812B &fb) override;
+};
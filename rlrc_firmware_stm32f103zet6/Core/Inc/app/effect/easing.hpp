@@ -0,0 +1,42 @@
+/**
+ * 定点缓动曲线
+ *
+ * 输入与输出都是 0-256 的进度 (256 = 1.0)，只用整数乘法与移位
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace Easing {
+    enum class Curve : uint8_t {
+        LINEAR = 0,
+        EASE_IN,     // t^2
+        EASE_OUT,    // 1 - (1 - t)^2
+        EASE_IN_OUT, // smoothstep: 3t^2 - 2t^3
+        COUNT,
+    };
+
+    /**
+     * @param t 进度 (0-256)
+     * @return 缓动后的进度 (0-256)
+     */
+    constexpr uint16_t apply(const Curve curve, const uint16_t t) {
+        const uint32_t x = t > 256 ? 256 : t;
+        switch (curve) {
+            case Curve::EASE_IN:
+                return static_cast<uint16_t>((x * x) >> 8);
+            case Curve::EASE_OUT:
+                return static_cast<uint16_t>(256 - (((256 - x) * (256 - x)) >> 8));
+            case Curve::EASE_IN_OUT:
+                return static_cast<uint16_t>((x * x * (768 - 2 * x)) >> 16);
+            case Curve::LINEAR:
+            case Curve::COUNT:
+                break;
+        }
+        return static_cast<uint16_t>(x);
+    }
+
+    static_assert(apply(Curve::EASE_IN_OUT, 0) == 0 && apply(Curve::EASE_IN_OUT, 256) == 256);
+    static_assert(apply(Curve::EASE_IN_OUT, 128) == 128);
+    static_assert(apply(Curve::EASE_OUT, 256) == 256 && apply(Curve::EASE_IN, 256) == 256);
+} // namespace Easing
@@ -0,0 +1,66 @@
+/**
+ * 动画效果 (Effect) 的统一接口
+ *
+ * 每个效果是一个静态对象，由 AnimationManager 按模式 ID 注册。只有当前激活的效果会被调用。
+ * - enter()：切换到该效果时调用一次，用于重置内部状态
+ * - update(t, fb)：到了该效果的帧周期时调用，t 为毫秒时间戳，把这一帧画进 fb
+ * - 参数块：每个效果最多 MAX_PARAMS 个字节参数，下标含义由各效果自己定义，可通过协议修改
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+
+#include "ws2812b.hpp"
+
+class Effect {
+public:
+    static constexpr uint8_t MAX_PARAMS = 8;
+
+    Effect(const Effect &) = delete;
+    Effect &operator=(const Effect &) = delete;
+
+    /**
+     * @brief 切换到该效果时调用
+     */
+    virtual void enter(WS2812B &) {}
+
+    /**
+     * @brief 绘制一帧
+     * @param t 当前时间 (ms)
+     * @param fb 帧缓冲
+     */
+    virtual void update(uint32_t t, WS2812B &fb) = 0;
+
+    [[nodiscard]] const char *name() const { return effect_name; }
+
+    /**
+     * @brief 两次 update() 之间的间隔 (ms)，0 表示每个帧节拍都更新
+     */
+    [[nodiscard]] uint16_t framePeriod() const { return frame_period_ms; }
+
+    [[nodiscard]] uint8_t param(const uint8_t index) const { return index < MAX_PARAMS ? params[index] : 0; }
+
+    /**
+     * @brief 从 offset 开始连续写入参数
+     * @return 越界时返回 false，参数不变
+     */
+    bool setParams(uint8_t offset, std::span<const uint8_t> values);
+
+protected:
+    Effect(const char *name, uint16_t frame_period_ms, std::initializer_list<uint8_t> defaults);
+    ~Effect() = default; // 效果都是静态对象，不通过基类指针析构
+
+    /**
+     * @brief 参数被协议修改后调用
+     */
+    virtual void paramsChanged() {}
+
+    std::array<uint8_t, MAX_PARAMS> params{};
+
+private:
+    const char *effect_name;
+    uint16_t frame_period_ms;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "color.hpp"
+#include "effect.hpp"
+
+/**
+ * @brief 火焰：逐列的热量模拟 (Fire2012 的点阵版本)
+ *
+ * 每列一条热量缓冲，每帧依次：随机冷却 -> 热量向上扩散 -> 底部随机产生火星 -> 热量查表映射为颜色。
+ * 全部是 8 位整数运算，随机数为 16 位线性同余，颜色由 16 色调色板在编译期展开成表。
+ * 产生火星的概率由沿 (列, 时间) 缓慢变化的梯度噪声调制，相邻几列一起窜高、一起回落，
+ * 火焰整体有起伏而不是各列独立闪烁；每帧每列只采样一次噪声。
+ */
+class FireEffect final : public Effect {
+public:
+    // 参数下标
+    enum Param : uint8_t {
+        COOLING = 0, // 冷却强度，越大火焰越矮
+        SPARKING,    // 每帧底部产生火星的平均概率 (x/255)
+        FLICKER,     // 噪声调制的幅度，0 为各列概率相同
+    };
+
+    // 热量 -> 颜色：黑 -> 红 -> 黄 -> 白，三段各自线性上升，每段 5 个色阶
+    static constexpr Color::Palette16 HEAT_COLORS{{{
+        {0, 0, 0}, {51, 0, 0}, {102, 0, 0}, {153, 0, 0}, {204, 0, 0},
+        {255, 0, 0}, {255, 51, 0}, {255, 102, 0}, {255, 153, 0}, {255, 204, 0},
+        {255, 255, 0}, {255, 255, 51}, {255, 255, 102}, {255, 255, 153}, {255, 255, 204},
+        {255, 255, 255},
+    }}};
+
+    // 每帧要查 LED_COUNT 次，在编译期把调色板展开成 256 项的表 (放在 Flash 中)，逐格只剩一次查表；
+    // 热量 0-255 压到调色板下标 0-240，最热处停在白色，不会绕回开头的黑色
+    static constexpr std::array<Color::Rgb, 256> HEAT_PALETTE = [] {
+        std::array<Color::Rgb, 256> table{};
+        for (int heat = 0; heat < 256; ++heat) {
+            table[heat] = HEAT_COLORS[Color::scale8(static_cast<uint8_t>(heat), 240)];
+        }
+        return table;
+    }();
+
+    static_assert(HEAT_PALETTE[0] == Color::Rgb{0, 0, 0} && HEAT_PALETTE[255] == Color::Rgb{255, 255, 255});
+
+    // 每 16ms 更新一次 (约 60 FPS)
+    FireEffect() : Effect("fire", 16, {80, 120, 160}) {}
+
+    void enter(WS2812B &fb) override;
+    void update(uint32_t t, WS2812B &fb) override;
+
+private:
+    uint8_t random8();
+
+    // [0, limit)
+    uint8_t random8(const uint8_t limit) { return static_cast<uint8_t>((random8() * limit) >> 8); }
+
+    // heat[x][h]：第 x 列从底部数第 h 格的热量
+    std::array<std::array<uint8_t, WS2812B::HEIGHT>, WS2812B::WIDTH> heat{};
+    uint16_t random_state = 1;
+};
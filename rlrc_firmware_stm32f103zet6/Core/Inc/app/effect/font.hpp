@@ -0,0 +1,137 @@
+/**
+ * 3x5 像素等宽点阵字体
+ *
+ * 字形以「字符画」的形式写在源码里 (# 为亮，. 为灭)，在编译期打包成每个字形一个 uint16_t：
+ * 第 col * 5 + row 位对应第 col 列、第 row 行，整张 ASCII 表 (0x20-0x7E) 只占 190 字节 Flash。
+ * 字符画写错 (非 #/. 字符或宽度不对) 时编译失败。
+ * 小写字母显示为对应的大写字母。
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace Font {
+    constexpr uint8_t GLYPH_WIDTH = 3;
+    constexpr uint8_t GLYPH_HEIGHT = 5;
+    constexpr uint8_t ADVANCE = GLYPH_WIDTH + 1; // 字间留一列空白
+
+    constexpr char FIRST_CHAR = 0x20;
+    constexpr char LAST_CHAR = 0x7E;
+
+    namespace detail {
+        // 每个字形 5 行，每行 3 个字符
+        struct Art {
+            char c;
+            const char *rows[GLYPH_HEIGHT];
+        };
+
+        // clang-format off
+        inline constexpr Art ART[] = {
+            {' ', {"...", "...", "...", "...", "..."}},
+            {'!', {".#.", ".#.", ".#.", "...", ".#."}},
+            {'"', {"#.#", "#.#", "...", "...", "..."}},
+            {'#', {"#.#", "###", "#.#", "###", "#.#"}},
+            {'$', {".##", "##.", ".#.", ".##", "##."}},
+            {'%', {"#.#", "..#", ".#.", "#..", "#.#"}},
+            {'&', {".#.", "#.#", ".#.", "#.#", ".##"}},
+            {'\'', {".#.", ".#.", "...", "...", "..."}},
+            {'(', {"..#", ".#.", ".#.", ".#.", "..#"}},
+            {')', {"#..", ".#.", ".#.", ".#.", "#.."}},
+            {'*', {"...", "#.#", ".#.", "#.#", "..."}},
+            {'+', {"...", ".#.", "###", ".#.", "..."}},
+            {',', {"...", "...", "...", ".#.", "#.."}},
+            {'-', {"...", "...", "###", "...", "..."}},
+            {'.', {"...", "...", "...", "...", ".#."}},
+            {'/', {"..#", "..#", ".#.", "#..", "#.."}},
+            {'0', {"###", "#.#", "#.#", "#.#", "###"}},
+            {'1', {".#.", "##.", ".#.", ".#.", "###"}},
+            {'2', {"###", "..#", "###", "#..", "###"}},
+            {'3', {"###", "..#", ".##", "..#", "###"}},
+            {'4', {"#.#", "#.#", "###", "..#", "..#"}},
+            {'5', {"###", "#..", "###", "..#", "###"}},
+            {'6', {"###", "#..", "###", "#.#", "###"}},
+            {'7', {"###", "..#", ".#.", ".#.", ".#."}},
+            {'8', {"###", "#.#", "###", "#.#", "###"}},
+            {'9', {"###", "#.#", "###", "..#", "###"}},
+            {':', {"...", ".#.", "...", ".#.", "..."}},
+            {';', {"...", ".#.", "...", ".#.", "#.."}},
+            {'<', {"..#", ".#.", "#..", ".#.", "..#"}},
+            {'=', {"...", "###", "...", "###", "..."}},
+            {'>', {"#..", ".#.", "..#", ".#.", "#.."}},
+            {'?', {"###", "..#", ".##", "...", ".#."}},
+            {'@', {"###", "#.#", "###", "#..", "###"}},
+            {'A', {".#.", "#.#", "###", "#.#", "#.#"}},
+            {'B', {"##.", "#.#", "##.", "#.#", "##."}},
+            {'C', {".##", "#..", "#..", "#..", ".##"}},
+            {'D', {"##.", "#.#", "#.#", "#.#", "##."}},
+            {'E', {"###", "#..", "##.", "#..", "###"}},
+            {'F', {"###", "#..", "##.", "#..", "#.."}},
+            {'G', {".##", "#..", "#.#", "#.#", ".##"}},
+            {'H', {"#.#", "#.#", "###", "#.#", "#.#"}},
+            {'I', {"###", ".#.", ".#.", ".#.", "###"}},
+            {'J', {"..#", "..#", "..#", "#.#", ".#."}},
+            {'K', {"#.#", "#.#", "##.", "#.#", "#.#"}},
+            {'L', {"#..", "#..", "#..", "#..", "###"}},
+            {'M', {"#.#", "###", "###", "#.#", "#.#"}},
+            {'N', {"##.", "#.#", "#.#", "#.#", "#.#"}},
+            {'O', {".#.", "#.#", "#.#", "#.#", ".#."}},
+            {'P', {"##.", "#.#", "##.", "#..", "#.."}},
+            {'Q', {".#.", "#.#", "#.#", "##.", ".##"}},
+            {'R', {"##.", "#.#", "##.", "#.#", "#.#"}},
+            {'S', {".##", "#..", ".#.", "..#", "##."}},
+            {'T', {"###", ".#.", ".#.", ".#.", ".#."}},
+            {'U', {"#.#", "#.#", "#.#", "#.#", "###"}},
+            {'V', {"#.#", "#.#", "#.#", "#.#", ".#."}},
+            {'W', {"#.#", "#.#", "###", "###", "#.#"}},
+            {'X', {"#.#", "#.#", ".#.", "#.#", "#.#"}},
+            {'Y', {"#.#", "#.#", ".#.", ".#.", ".#."}},
+            {'Z', {"###", "..#", ".#.", "#..", "###"}},
+            {'[', {".##", ".#.", ".#.", ".#.", ".##"}},
+            {'\\', {"#..", "#..", ".#.", "..#", "..#"}},
+            {']', {"##.", ".#.", ".#.", ".#.", "##."}},
+            {'^', {".#.", "#.#", "...", "...", "..."}},
+            {'_', {"...", "...", "...", "...", "###"}},
+            {'`', {"#..", ".#.", "...", "...", "..."}},
+            {'{', {".##", ".#.", "##.", ".#.", ".##"}},
+            {'|', {".#.", ".#.", ".#.", ".#.", ".#."}},
+            {'}', {"##.", ".#.", ".##", ".#.", "##."}},
+            {'~', {"...", ".##", "##.", "...", "..."}},
+        };
+        // clang-format on
+
+        constexpr uint16_t pack(const Art &art) {
+            uint16_t bits = 0;
+            for (uint8_t row = 0; row < GLYPH_HEIGHT; ++row) {
+                for (uint8_t col = 0; col < GLYPH_WIDTH; ++col) {
+                    const char pixel = art.rows[row][col];
+                    if (pixel != '#' && pixel != '.') throw "glyph art may only contain '#' and '.'";
+                    if (pixel == '#') bits |= 1u << (col * GLYPH_HEIGHT + row);
+                }
+                if (art.rows[row][GLYPH_WIDTH] != '\0') throw "glyph rows must be exactly 3 characters";
+            }
+            return bits;
+        }
+    } // namespace detail
+
+    // 打包后的字形表，下标为 c - FIRST_CHAR；小写字母复用大写字形
+    inline constexpr std::array<uint16_t, LAST_CHAR - FIRST_CHAR + 1> GLYPHS = [] {
+        std::array<uint16_t, LAST_CHAR - FIRST_CHAR + 1> table{};
+        for (const auto &art : detail::ART) {
+            table[art.c - FIRST_CHAR] = detail::pack(art);
+            if (art.c >= 'A' && art.c <= 'Z') table[art.c - 'A' + 'a' - FIRST_CHAR] = detail::pack(art);
+        }
+        return table;
+    }();
+
+    /**
+     * @brief 取字符 c 第 col 列的位图 (第 row 位对应第 row 行)，不支持的字符显示为 '?'
+     */
+    constexpr uint8_t column(char c, const uint8_t col) {
+        if (col >= GLYPH_WIDTH) return 0;
+        if (c < FIRST_CHAR || c > LAST_CHAR) c = '?';
+        return (GLYPHS[c - FIRST_CHAR] >> (col * GLYPH_HEIGHT)) & 0x1F;
+    }
+
+    static_assert(column('I', 1) == 0x1F && column('-', 0) == 0x04);
+} // namespace Font
@@ -0,0 +1,61 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "easing.hpp"
+#include "effect.hpp"
+
+/**
+ * @brief 关键帧插值：APP 只发送稀疏的关键帧与时长，由 STM32 在每个帧节拍插出中间帧
+ *
+ * 关键帧进入一个小队列，按顺序首尾相接地播放：每一段从上一个关键帧插值到下一个，
+ * 段的起点取上一段的结束时刻，因此连续的关键帧之间不会累积时间误差。
+ * 队列播完后停在最后一个关键帧上。
+ */
+class KeyframeEffect final : public Effect {
+public:
+    static constexpr uint8_t QUEUE_SIZE = 4; // 最多缓存的关键帧数
+
+    using Frame = std::array<std::array<uint8_t, 3>, WS2812B::LED_COUNT>;
+
+    static KeyframeEffect &getInstance();
+
+    /**
+     * @brief 追加一个关键帧
+     * @param pixels RGB 数据，长度必须为 LED_COUNT * 3
+     * @param duration_ms 从上一个关键帧过渡到本帧的时长
+     * @param curve 缓动曲线
+     * @return 队列已满或长度不符时返回 false
+     */
+    bool push(std::span<const uint8_t> pixels, uint16_t duration_ms, Easing::Curve curve);
+
+    /**
+     * @brief 清空尚未播放的关键帧
+     */
+    void flush();
+
+    void enter(WS2812B &fb) override;
+    void update(uint32_t t, WS2812B &fb) override;
+
+private:
+    struct Keyframe {
+        Frame pixels;
+        uint16_t duration_ms;
+        Easing::Curve curve;
+    };
+
+    // 每个帧节拍都插值一次
+    KeyframeEffect() : Effect("keyframe", 0, {}) {}
+
+    bool pop(Keyframe &out);
+
+    std::array<Keyframe, QUEUE_SIZE> queue{};
+    uint8_t queue_head = 0;  // 下一个要播放的关键帧
+    uint8_t queue_count = 0;
+
+    Frame from{};        // 当前段的起点 (上一个关键帧)
+    Keyframe target{};   // 当前段的终点
+    bool playing = false;
+    uint32_t segment_start = 0;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "effect.hpp"
+#include "life.hpp"
+
+/**
+ * @brief 元胞自动机 (默认 Conway 生命游戏 B3/S23)，细胞按存活代数着色
+ *
+ * 进入该模式时随机播种，细胞全部死亡或画面停滞一段时间后自动重新播种。
+ * 规则、边界、速度和配色都可以通过参数修改。
+ */
+class LifeEffect final : public Effect {
+public:
+    // 参数下标
+    enum Param : uint8_t {
+        BIRTH = 0,     // 复活规则：第 n 位表示 n 个邻居时复活 (n = 0-7)
+        SURVIVE,       // 存活规则：第 n 位表示 n 个邻居时存活 (n = 0-7)
+        RULE_8,        // 8 个邻居：bit0 复活，bit1 存活
+        WRAP,          // 非 0 时边界相连
+        GENERATION,    // 每代时长 (x10 ms)
+        HUE,           // 新生细胞的色相
+        AGE_HUE_STEP,  // 每多活一代色相的偏移
+    };
+
+    LifeEffect() : Effect("life", 0, {1u << 3, (1u << 2) | (1u << 3), 0, 1, 25, 96, 12}) {}
+
+    void enter(WS2812B &fb) override;
+    void update(uint32_t t, WS2812B &fb) override;
+
+private:
+    using Board = Life::Board<WS2812B::WIDTH, WS2812B::HEIGHT>;
+
+    // 停滞 (周期 1 或 2) 持续这么多代后重新播种
+    static constexpr uint8_t STAGNANT_LIMIT = 12;
+
+    [[nodiscard]] Life::Rule rule() const;
+    void reseed(uint32_t t);
+    void draw(WS2812B &fb);
+
+    Board board;
+    Board previous;        // 上一代
+    Board before_previous; // 上上代，用于发现周期 2 的振荡
+    std::array<uint8_t, WS2812B::LED_COUNT> age{};
+    uint8_t stagnant = 0;
+    uint32_t last_step = 0;
+    uint32_t random_state = 1;
+    bool restart = true;
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "effect.hpp"
+
+/**
+ * @brief RAM 帧页：APP 把循环动画的每一帧上传一次，之后只需发送翻页指令或让设备自动轮播
+ *
+ * 帧页占用 PAGE_RAM_BUDGET (64 KB RAM 中的 8 KB)，页数按矩阵尺寸换算：5x5 时 8192 / 75 = 109 页，
+ * 40x25 时 2 页；单页超过预算时仍保留 1 页。
+ * 翻页只是把该页拷进帧缓冲，下一次 render() 就会显示出来。
+ */
+class PageEffect final : public Effect {
+public:
+    static constexpr uint16_t PAGE_SIZE = WS2812B::LED_COUNT * 3;
+    static constexpr size_t PAGE_RAM_BUDGET = 8 * 1024;
+    // 页号是协议中的 1 个字节，最多 255 页
+    static constexpr uint8_t PAGE_COUNT =
+        static_cast<uint8_t>(std::clamp<size_t>(PAGE_RAM_BUDGET / PAGE_SIZE, 1, UINT8_MAX));
+
+    using Page = std::array<uint8_t, PAGE_SIZE>;
+    static_assert(PAGE_COUNT == 1 || sizeof(Page) * PAGE_COUNT <= PAGE_RAM_BUDGET, "帧页超出 RAM 预算");
+
+    static PageEffect &getInstance();
+
+    /**
+     * @brief 写入一页
+     * @return 页号越界或长度不符时返回 false
+     */
+    bool upload(uint8_t page, std::span<const uint8_t> pixels);
+
+    /**
+     * @brief 立即显示某一页，并停止自动轮播
+     * @return 页号越界时返回 false
+     */
+    bool flip(uint8_t page);
+
+    /**
+     * @brief 在 [first, first + count) 范围内自动轮播
+     * @param period_ms 每页显示时长，0 表示停止轮播
+     * @return 范围越界时返回 false
+     */
+    bool setCycle(uint8_t first, uint8_t count, uint16_t period_ms);
+
+    [[nodiscard]] uint8_t currentPage() const;
+
+    void enter(WS2812B &fb) override;
+    void update(uint32_t t, WS2812B &fb) override;
+
+private:
+    // 每个帧节拍检查一次，翻页延迟不超过一个节拍
+    PageEffect() : Effect("pages", 0, {}) {}
+
+    std::array<Page, PAGE_COUNT> pages{};
+
+    uint8_t current_page = 0;
+    bool page_changed = true; // 需要把 current_page 拷进帧缓冲
+
+    uint8_t cycle_first = 0;
+    uint8_t cycle_count = 0;
+    uint16_t cycle_period_ms = 0; // 0 表示不轮播
+    uint32_t next_flip_time = 0;
+    bool cycle_started = false;
+};
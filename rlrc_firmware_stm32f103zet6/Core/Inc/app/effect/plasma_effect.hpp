@@ -0,0 +1,20 @@
+#pragma once
+#include "effect.hpp"
+
+/**
+ * @brief 等离子：多组正弦波叠加后映射到彩虹色
+ */
+class PlasmaEffect final : public Effect {
+public:
+    // 参数下标
+    enum Param : uint8_t {
+        SPEED = 0,  // 波动速度，相位 = t * SPEED / 1000 (弧度)
+        HUE_SPEED,  // 彩虹旋转速度，色相偏移 = t * HUE_SPEED / 1000
+        BRIGHTNESS, // 亮度 (255 为满亮度)
+    };
+
+    // 每 30ms 更新一次 (约 33 FPS)
+    PlasmaEffect() : Effect("plasma", 30, {3, 20, 255}) {}
+
+    void update(uint32_t t, WS2812B &fb) override;
+};
@@ -0,0 +1,292 @@
+/**
+ * 编译期组合的像素着色管线
+ *
+ * 一个逐像素效果拆成四级：坐标源 -> 场函数 -> 调色板 -> 后处理 (可选，可以有多个)
+ *   - 坐标源 (Source)：像素坐标 -> Point，例如以点阵中心为原点
+ *   - 场函数 (Field)：Point -> Q16 标量，例如径向波纹、等离子、噪声
+ *   - 调色板 (Palette)：Q16 标量 -> RGB
+ *   - 后处理 (Post)：RGB -> RGB，例如整体亮度
+ *
+ * 每一级都是一个小类型：构造函数接收 Frame，在这里完成每帧只需做一次的计算 (时间相位、读取参数等)，
+ * operator() 处理单个像素。Pipeline 把各级类型组合起来，render() 展开成一个遍历帧缓冲的循环，
+ * 每个像素的调用都在编译期确定，可以完全内联，没有虚函数开销。
+ * 调色板还可以提供 row()，一次转换一整行标量 (RowPalette)，这时 render() 先算出整行标量再批量上色。
+ *
+ * 效果只需声明组合，例如：
+ *   using Ripple = Shader::Pipeline<Shader::Centered, Shader::RadialWave<SPEED>, Shader::HueCycle<HUE, SAT>>;
+ *   Ripple::render({t, params}, fb);
+ */
+
+#pragma once
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <tuple>
+
+#include "color.hpp"
+#include "effect.hpp"
+#include "fixed_math.hpp"
+#include "noise.hpp"
+
+namespace Shader {
+    using Fixed::q16;
+
+    // 每帧的输入
+    struct Frame {
+        uint32_t t; // 当前时间 (ms)
+        const std::array<uint8_t, Effect::MAX_PARAMS> &params;
+    };
+
+    struct Pixel {
+        uint8_t x;
+        uint8_t y;
+    };
+
+    struct Point {
+        q16 x;
+        q16 y;
+    };
+
+    using Color::Rgb;
+
+    // --- 各级的约束 ---
+
+    template <typename S>
+    concept Source = std::constructible_from<S, const Frame &> && requires(const S s, Pixel p) {
+        { s(p) } -> std::same_as<Point>;
+    };
+
+    template <typename F>
+    concept Field = std::constructible_from<F, const Frame &> && requires(const F f, Point p) {
+        { f(p) } -> std::same_as<q16>;
+    };
+
+    template <typename P>
+    concept Palette = std::constructible_from<P, const Frame &> && requires(const P palette, q16 v) {
+        { palette(v) } -> std::same_as<Rgb>;
+    };
+
+    // 可以整行批量上色的调色板，values 与 out 的长度都是 WS2812B::WIDTH
+    template <typename P>
+    concept RowPalette = Palette<P> && requires(const P palette, std::span<const q16> values, std::span<Rgb> out) {
+        palette.row(values, out);
+    };
+
+    template <typename P>
+    concept Post = std::constructible_from<P, const Frame &> && requires(const P post, Rgb c, Pixel p) {
+        { post(c, p) } -> std::same_as<Rgb>;
+    };
+
+    namespace detail {
+        // 2 * pi (Q16)
+        constexpr q16 TWO_PI = Fixed::fromDouble(2 * Fixed::detail::PI);
+
+        /**
+         * @brief 时间相位 t * speed / 1000 (弧度) 换算为圈数的小数部分 (Q16)
+         * 先对 2 * pi 取模再换算，运行时间再长也不会溢出
+         */
+        inline q16 phaseTurns(const uint32_t t, const uint8_t speed) {
+            const uint64_t radians = static_cast<uint64_t>(t) * speed * Fixed::ONE / 1000;
+            return Fixed::fract(Fixed::mul(static_cast<q16>(radians % TWO_PI), Fixed::INV_TWO_PI));
+        }
+    } // namespace detail
+
+    // --- 坐标源 ---
+
+    // 原点在左上角，单位为一个像素
+    struct Cartesian {
+        explicit Cartesian(const Frame &) {}
+        Point operator()(const Pixel p) const { return {Fixed::fromInt(p.x), Fixed::fromInt(p.y)}; }
+    };
+
+    // 原点在点阵中心，单位为一个像素
+    struct Centered {
+        explicit Centered(const Frame &) {}
+        Point operator()(const Pixel p) const {
+            // x - (WIDTH - 1) / 2 = (2x - (WIDTH - 1)) / 2
+            return {(2 * p.x - (WS2812B::WIDTH - 1)) * Fixed::HALF, (2 * p.y - (WS2812B::HEIGHT - 1)) * Fixed::HALF};
+        }
+    };
+
+    // --- 场函数 ---
+
+    /**
+     * @brief 从原点向外移动的正弦波纹 sin(dist - t * speed / 1000)，输出 [-1, 1]
+     * @tparam SPEED 速度参数的下标
+     */
+    template <uint8_t SPEED>
+    struct RadialWave {
+        explicit RadialWave(const Frame &f) : phase(detail::phaseTurns(f.t, f.params[SPEED])) {}
+
+        q16 operator()(const Point p) const {
+            const q16 dist = Fixed::sqrt(Fixed::mul(p.x, p.x) + Fixed::mul(p.y, p.y));
+            return Fixed::sinTurns(Fixed::mul(dist, Fixed::INV_TWO_PI) - phase);
+        }
+
+        q16 phase; // 圈
+    };
+
+    /**
+     * @brief 经典等离子：几组不同方向的正弦波叠加，输出 [0, 1]
+     * @tparam SPEED 速度参数的下标
+     */
+    template <uint8_t SPEED>
+    struct Plasma {
+        explicit Plasma(const Frame &f) : phase(detail::phaseTurns(f.t, f.params[SPEED])) {}
+
+        q16 operator()(const Point p) const {
+            // 空间频率：约每 6 个像素一个周期
+            constexpr q16 K = Fixed::fromDouble(1.0 / 6);
+            const q16 u = Fixed::mul(p.x, K);
+            const q16 v = Fixed::mul(p.y, K);
+            const q16 dist = Fixed::sqrt(Fixed::mul(u, u) + Fixed::mul(v, v));
+
+            const q16 sum = Fixed::sinTurns(u + phase) + Fixed::sinTurns(v - phase) +
+                            Fixed::sinTurns((u + v) / 2 + phase / 2) + Fixed::sinTurns(dist + phase);
+            return (sum / 4 + Fixed::ONE) / 2; // [-4, 4] -> [0, 1]
+        }
+
+        q16 phase; // 圈
+    };
+
+    /**
+     * @brief 随时间演变的分形噪声 (时间作为第三维)，输出 [0, 1]
+     * @tparam SPEED 演变速度参数的下标，z = t * speed / 8000
+     * @tparam SCALE 缩放参数的下标，每个像素跨越 scale / 64 个噪声格
+     * @tparam OCTAVES 叠加层数
+     */
+    template <uint8_t SPEED, uint8_t SCALE, uint8_t OCTAVES = 3>
+    struct Fbm {
+        explicit Fbm(const Frame &f)
+            // 噪声以 256 为周期，z 先取模再转为 Q16，运行时间再长也不会溢出
+            : z(static_cast<q16>(static_cast<uint64_t>(f.t) * f.params[SPEED] * Fixed::ONE / 8000 %
+                                 Fixed::fromInt(256))),
+              scale(f.params[SCALE] * (Fixed::ONE / 64)) {}
+
+        q16 operator()(const Point p) const {
+            const q16 n = Noise::fbm3(Fixed::mul(p.x, scale), Fixed::mul(p.y, scale), z, OCTAVES);
+            return (n + Fixed::ONE) / 2; // [-1, 1] -> [0, 1]
+        }
+
+        q16 z;
+        q16 scale;
+    };
+
+    // --- 调色板 ---
+
+    /**
+     * @brief 单一色相随时间旋转，标量作为亮度，负值熄灭
+     * @tparam SPEED 色相速度参数的下标，色相 = t * speed / 1000
+     * @tparam SATURATION 饱和度参数的下标
+     */
+    template <uint8_t SPEED, uint8_t SATURATION>
+    struct HueCycle {
+        // 整帧只有一个色相，逐像素只有亮度不同
+        explicit HueCycle(const Frame &f)
+            : hue(static_cast<uint8_t>(static_cast<uint64_t>(f.t) * f.params[SPEED] / 1000 % 255)),
+              saturation(f.params[SATURATION]) {}
+
+        Rgb operator()(const q16 v) const { return Color::hsv(hue, saturation, Fixed::toByte(v)); }
+
+        void row(const std::span<const q16> values, const std::span<Rgb> out) const {
+            std::array<Color::Hsv, WS2812B::WIDTH> hsv;
+            for (size_t i = 0; i < hsv.size(); ++i) hsv[i] = {hue, saturation, Fixed::toByte(values[i])};
+            Color::hsv2rgb(hsv, out);
+        }
+
+        uint8_t hue;
+        uint8_t saturation;
+    };
+
+    /**
+     * @brief 标量映射为色相 (一圈彩虹)，整体随时间旋转，满亮度
+     * @tparam SPEED 旋转速度参数的下标，色相偏移 = t * speed / 1000
+     */
+    template <uint8_t SPEED>
+    struct Rainbow {
+        explicit Rainbow(const Frame &f)
+            : offset(static_cast<uint8_t>(static_cast<uint64_t>(f.t) * f.params[SPEED] / 1000)) {}
+
+        Rgb operator()(const q16 v) const { return Color::HUE_LUT[hue(v)]; }
+
+        void row(const std::span<const q16> values, const std::span<Rgb> out) const {
+            std::array<Color::Hsv, WS2812B::WIDTH> hsv;
+            for (size_t i = 0; i < hsv.size(); ++i) hsv[i] = {hue(values[i]), 255, 255};
+            Color::hsv2rgb(hsv, out);
+        }
+
+        [[nodiscard]] uint8_t hue(const q16 v) const { return static_cast<uint8_t>((v >> 8) + offset); }
+
+        uint8_t offset;
+    };
+
+    /**
+     * @brief 两种颜色之间的线性渐变，标量 0 为 FROM，1 为 TO
+     */
+    template <Rgb FROM, Rgb TO>
+    struct Gradient {
+        explicit Gradient(const Frame &) {}
+
+        Rgb operator()(const q16 v) const {
+            const q16 a = v < 0 ? 0 : (v > Fixed::ONE ? Fixed::ONE : v);
+            const auto mix = [a](const uint8_t from, const uint8_t to) {
+                return static_cast<uint8_t>(from + (((to - from) * a) >> 16));
+            };
+            return {mix(FROM.r, TO.r), mix(FROM.g, TO.g), mix(FROM.b, TO.b)};
+        }
+    };
+
+    // --- 后处理 ---
+
+    /**
+     * @brief 按参数缩放亮度
+     * @tparam LEVEL 亮度参数的下标 (255 为原样)
+     */
+    template <uint8_t LEVEL>
+    struct Brightness {
+        explicit Brightness(const Frame &f) : level(f.params[LEVEL]) {}
+
+        Rgb operator()(const Rgb c, Pixel) const {
+            return {Color::scale8(c.r, level), Color::scale8(c.g, level), Color::scale8(c.b, level)};
+        }
+
+        uint8_t level;
+    };
+
+    // --- 组合 ---
+
+    template <Source S, Field F, Palette P, Post... Posts>
+    struct Pipeline {
+        /**
+         * @brief 用这条管线绘制整帧
+         */
+        static void render(const Frame &frame, WS2812B &fb) {
+            const S source{frame};
+            const F field{frame};
+            const P palette{frame};
+            const std::tuple<Posts...> posts{Posts{frame}...};
+
+            for (uint8_t y = 0; y < WS2812B::HEIGHT; y++) {
+                if constexpr (RowPalette<P>) {
+                    std::array<q16, WS2812B::WIDTH> values;
+                    std::array<Rgb, WS2812B::WIDTH> colors;
+                    for (uint8_t x = 0; x < WS2812B::WIDTH; x++) values[x] = field(source(Pixel{x, y}));
+                    palette.row(values, colors);
+                    for (uint8_t x = 0; x < WS2812B::WIDTH; x++) {
+                        Rgb c = colors[x];
+                        std::apply([&](const auto &...post) { ((c = post(c, Pixel{x, y})), ...); }, posts);
+                        fb.setPixel(x, y, c.r, c.g, c.b);
+                    }
+                } else {
+                    for (uint8_t x = 0; x < WS2812B::WIDTH; x++) {
+                        const Pixel pixel{x, y};
+                        Rgb c = palette(field(source(pixel)));
+                        std::apply([&](const auto &...post) { ((c = post(c, pixel)), ...); }, posts);
+                        fb.setPixel(x, y, c.r, c.g, c.b);
+                    }
+                }
+            }
+        }
+    };
+} // namespace Shader
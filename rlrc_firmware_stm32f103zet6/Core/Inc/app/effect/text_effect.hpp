@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "color.hpp"
+#include "effect.hpp"
+
+/**
+ * @brief 文字跑马灯：用内置的 3x5 字体 (font.hpp) 在设备端渲染并滚动一段文字
+ *
+ * APP 只需发送一次文字、颜色和速度。滚动位置精确到 1/256 像素，
+ * 位于两列之间时按小数部分混合相邻两列的亮度，低速滚动也不会一格一格地跳。
+ */
+class TextEffect final : public Effect {
+public:
+    static constexpr uint8_t MAX_TEXT = 64;
+
+    static TextEffect &getInstance();
+
+    /**
+     * @brief 设置文字并从头开始滚动，超出 MAX_TEXT 的部分被截断
+     * @param speed 滚动速度 (1/256 像素每秒)，0 表示静止显示 (放得下时居中)
+     */
+    void setText(std::span<const uint8_t> text, Color::Rgb color, uint16_t speed);
+
+    void enter(WS2812B &fb) override;
+    void update(uint32_t t, WS2812B &fb) override;
+
+private:
+    TextEffect() : Effect("text", 0, {}) {}
+
+    // 文字第 x 列的位图，超出范围为 0
+    [[nodiscard]] uint8_t columnAt(int32_t x) const;
+    [[nodiscard]] int32_t textWidth() const;
+
+    std::array<char, MAX_TEXT> text{};
+    uint8_t length = 0;
+    Color::Rgb color{255, 255, 255};
+    uint16_t speed = 0;
+    uint32_t start_time = 0;
+    int32_t shown_offset = INT32_MIN; // 已绘制的位置 (1/256 像素)
+    bool restart = true;
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+#include "bytecode_vm.hpp"
+#include "effect.hpp"
+
+/**
+ * @brief 运行 APP 上传的字节码程序 (见 bytecode_vm.hpp)
+ *
+ * 每帧对每个像素执行一次程序。参数块 (8 字节) 由程序的 PARAM 指令读取，含义由上传者自己约定。
+ */
+class VmEffect final : public Effect {
+public:
+    static VmEffect &getInstance();
+
+    /**
+     * @brief 载入新程序，失败时继续运行旧程序
+     */
+    BytecodeVm::ErrorCode load(std::span<const uint8_t> program);
+
+    void enter(WS2812B &fb) override;
+    void update(uint32_t t, WS2812B &fb) override;
+
+private:
+    VmEffect() : Effect("vm", 0, {}) {}
+
+    BytecodeVm vm;
+    uint32_t start_time = 0;
+    bool restart = true;
+};
@@ -0,0 +1,180 @@
+/**
+ * Q16.16 定点数学
+ *
+ * Cortex-M3 没有 FPU，float 运算全部走软件库。效果计算统一使用 Q16.16 定点数 (int32_t，65536 = 1.0)：
+ * 乘法借助 SMULL 一条指令得到 64 位乘积，正弦、噪声等函数查编译期生成的表。
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace Fixed {
+    using q16 = int32_t;
+
+    constexpr q16 ONE = 1 << 16;
+    constexpr q16 HALF = ONE / 2;
+
+    constexpr q16 fromInt(const int32_t value) { return value * ONE; }
+
+    /**
+     * @brief 编译期把浮点常量转换为 Q16 (四舍五入)
+     */
+    consteval q16 fromDouble(const double value) {
+        return static_cast<q16>(value * ONE + (value >= 0 ? 0.5 : -0.5));
+    }
+
+    constexpr q16 mul(const q16 a, const q16 b) { return static_cast<q16>((static_cast<int64_t>(a) * b) >> 16); }
+
+    /**
+     * @brief 除法，除数为 0 时返回 0，商超出 Q16 范围时饱和到最大/最小值
+     */
+    constexpr q16 div(const q16 a, const q16 b) {
+        if (b == 0) return 0;
+
+        // |a << 16| < 2^47，64 位的商不会溢出，只需要截断到 32 位
+        const int64_t quotient = (static_cast<int64_t>(a) * ONE) / b;
+        if (quotient > std::numeric_limits<q16>::max()) return std::numeric_limits<q16>::max();
+        if (quotient < std::numeric_limits<q16>::min()) return std::numeric_limits<q16>::min();
+        return static_cast<q16>(quotient);
+    }
+
+    constexpr q16 floor(const q16 a) { return a & ~(ONE - 1); }
+
+    constexpr q16 fract(const q16 a) { return a & (ONE - 1); }
+
+    constexpr q16 abs(const q16 a) { return a < 0 ? -a : a; }
+
+    /**
+     * @brief 平方根，负数返回 0 (逐位求整数平方根)
+     */
+    constexpr q16 sqrt(const q16 a) {
+        if (a <= 0) return 0;
+
+        // sqrt(a / 65536) * 65536 = sqrt(a * 65536)
+        uint64_t value = static_cast<uint64_t>(a) << 16;
+        uint64_t result = 0;
+        uint64_t bit = 1ull << 46; // 不超过 value 的最大 4 的幂
+        while (bit > value) bit >>= 2;
+        while (bit != 0) {
+            if (value >= result + bit) {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return static_cast<q16>(result);
+    }
+
+    /**
+     * @brief smoothstep 插值曲线 3t^2 - 2t^3，t 为 [0, 1] 内的 Q16
+     */
+    constexpr q16 smooth(const q16 t) { return mul(mul(t, t), fromInt(3) - 2 * t); }
+
+    constexpr q16 lerp(const q16 a, const q16 b, const q16 t) { return a + mul(b - a, t); }
+
+    /**
+     * @brief [0, 1] 截断后转换为 0-255 的颜色分量
+     */
+    constexpr uint8_t toByte(const q16 a) {
+        if (a <= 0) return 0;
+        if (a >= ONE) return 255;
+        return static_cast<uint8_t>((a * 255) >> 16);
+    }
+
+    namespace detail {
+        constexpr double PI = 3.14159265358979323846;
+
+        // sin(x)，x 规约到 [-pi, pi] 后做泰勒展开
+        constexpr double sin(double x) {
+            while (x > PI) x -= 2 * PI;
+            while (x < -PI) x += 2 * PI;
+
+            double term = x;
+            double sum = x;
+            for (int n = 1; n < 12; ++n) {
+                term *= -x * x / ((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+    } // namespace detail
+
+    // 一个周期 256 个采样点的正弦表 (Q16)，多出一项方便插值时不做回绕判断
+    inline constexpr std::array<q16, 257> SIN_LUT = [] {
+        std::array<q16, 257> table{};
+        for (int i = 0; i <= 256; ++i) {
+            const double value = detail::sin(2 * detail::PI * i / 256);
+            table[i] = static_cast<q16>(value * ONE + (value >= 0 ? 0.5 : -0.5));
+        }
+        return table;
+    }();
+
+    /**
+     * @brief 正弦，角度以「圈」为单位 (ONE = 360°)，查表并线性插值
+     */
+    constexpr q16 sinTurns(const q16 turns) {
+        const auto phase = static_cast<uint32_t>(turns) & 0xFFFF; // 只保留一圈以内的部分
+        const uint32_t index = phase >> 8;
+        const auto frac = static_cast<q16>(phase & 0xFF) << 8;
+        return lerp(SIN_LUT[index], SIN_LUT[index + 1], frac);
+    }
+
+    // 1 / (2 * pi)，弧度换算为圈数
+    constexpr q16 INV_TWO_PI = fromDouble(1.0 / (2 * detail::PI));
+
+    /**
+     * @brief 正弦，角度为弧度
+     */
+    constexpr q16 sin(const q16 radians) { return sinTurns(mul(radians, INV_TWO_PI)); }
+
+    constexpr q16 cos(const q16 radians) { return sinTurns(mul(radians, INV_TWO_PI) + ONE / 4); }
+
+    // 0-255 的随机排列，用作噪声的哈希表
+    inline constexpr std::array<uint8_t, 256> PERM = [] {
+        std::array<uint8_t, 256> table{};
+        for (int i = 0; i < 256; ++i) table[i] = static_cast<uint8_t>(i);
+
+        // 固定种子的 xorshift32 + Fisher-Yates 洗牌，每次编译结果相同
+        uint32_t seed = 0x9E3779B9;
+        for (int i = 255; i > 0; --i) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            const int j = static_cast<int>(seed % (i + 1));
+            const uint8_t tmp = table[i];
+            table[i] = table[j];
+            table[j] = tmp;
+        }
+        return table;
+    }();
+
+    constexpr uint8_t hash(const int32_t x, const int32_t y) { return PERM[(PERM[x & 0xFF] + y) & 0xFF]; }
+
+    /**
+     * @brief 二维值噪声，输出 [0, 1)
+     * 整数格点上取哈希值，格点之间用 smoothstep 插值
+     */
+    constexpr q16 valueNoise(const q16 x, const q16 y) {
+        const int32_t ix = x >> 16;
+        const int32_t iy = y >> 16;
+        const q16 fx = smooth(fract(x));
+        const q16 fy = smooth(fract(y));
+
+        // 8 bit 哈希值放大为 Q16 的 [0, 1)
+        const q16 v00 = hash(ix, iy) << 8;
+        const q16 v10 = hash(ix + 1, iy) << 8;
+        const q16 v01 = hash(ix, iy + 1) << 8;
+        const q16 v11 = hash(ix + 1, iy + 1) << 8;
+        return lerp(lerp(v00, v10, fx), lerp(v01, v11, fx), fy);
+    }
+
+    static_assert(sinTurns(0) == 0 && sinTurns(ONE / 4) == ONE && sinTurns(ONE / 2) == 0);
+    static_assert(sqrt(fromInt(4)) == fromInt(2) && sqrt(fromInt(9)) == fromInt(3));
+    static_assert(div(fromInt(3), fromInt(2)) == fromDouble(1.5) && div(fromInt(-3), 0) == 0);
+    static_assert(div(fromInt(30000), 1) == std::numeric_limits<q16>::max());
+    static_assert(div(std::numeric_limits<q16>::min(), -1) == std::numeric_limits<q16>::max());
+} // namespace Fixed
@@ -0,0 +1,132 @@
+/**
+ * 位棋盘 (bitboard) 元胞自动机
+ *
+ * 每一行存成若干个 32 位整数 (每 32 个细胞一个字)，一个 bit 对应一个细胞。计算下一代时不逐个细胞数邻居，
+ * 而是把一个字的 8 个邻居方向各看成一个位向量，用全加器/半加器逻辑按位相加，
+ * 一次得到 32 个细胞的邻居数 (4 个 bit 平面)，再按规则掩码组合出下一代。
+ * 左右移位时字与字之间互相补上移出的那一位，开销按每 32 个细胞计。
+ *
+ * 规则用 B/S 记法：birth 的第 n 位表示 n 个邻居的死细胞复活，survive 的第 n 位表示 n 个邻居的活细胞存活，
+ * 例如 Conway 生命游戏 B3/S23。
+ */
+
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace Life {
+    struct Rule {
+        uint16_t birth;   // 第 n 位：n 个邻居时复活 (n = 0-8)
+        uint16_t survive; // 第 n 位：n 个邻居时存活 (n = 0-8)
+    };
+
+    // B3/S23
+    inline constexpr Rule CONWAY{1u << 3, (1u << 2) | (1u << 3)};
+
+    template <uint8_t WIDTH, uint8_t HEIGHT>
+    class Board {
+        static_assert(WIDTH >= 1 && HEIGHT >= 1);
+
+    public:
+        using Row = uint32_t;
+        // 每 32 个细胞一个字，一行 WORDS 个字，各行首尾相接存成一维数组
+        static constexpr uint8_t WORDS = (WIDTH + 31) / 32;
+        // 最后一个字中最高的有效位，以及它的有效位掩码 (其余字全部有效)
+        static constexpr uint8_t TOP_BIT = (WIDTH - 1) % 32;
+        static constexpr Row LAST_MASK = TOP_BIT == 31 ? ~Row{0} : (Row{1} << (TOP_BIT + 1)) - 1;
+
+        [[nodiscard]] bool get(const uint8_t x, const uint8_t y) const {
+            return x < WIDTH && y < HEIGHT && ((rows[y * WORDS + x / 32] >> (x % 32)) & 1u) != 0;
+        }
+
+        void set(const uint8_t x, const uint8_t y, const bool alive) {
+            // 越界时 bit 为 0，第 0 个字原样写回
+            const bool inside = x < WIDTH && y < HEIGHT;
+            const uint16_t index = inside ? y * WORDS + x / 32 : 0;
+            const Row bit = inside ? Row{1} << (x % 32) : 0;
+            rows[index] = (rows[index] & ~bit) | (alive ? bit : 0);
+        }
+
+        void clear() { rows.fill(0); }
+
+        [[nodiscard]] uint16_t population() const {
+            uint16_t count = 0;
+            for (const Row word : rows) count += static_cast<uint16_t>(std::popcount(word));
+            return count;
+        }
+
+        [[nodiscard]] const std::array<Row, WORDS * HEIGHT> &data() const { return rows; }
+
+        bool operator==(const Board &) const = default;
+
+        /**
+         * @brief 计算下一代
+         * @param wrap 为 true 时上下、左右边界相连 (环面)，否则边界外视为死细胞
+         */
+        void step(const Rule rule, const bool wrap) {
+            static constexpr std::array<Row, WORDS> EMPTY{};
+            std::array<Row, WORDS * HEIGHT> next{};
+            for (uint8_t y = 0; y < HEIGHT; ++y) {
+                const Row *up = y > 0 ? &rows[(y - 1) * WORDS] : (wrap ? &rows[(HEIGHT - 1) * WORDS] : EMPTY.data());
+                const Row *mid = &rows[y * WORDS];
+                const Row *down = y + 1 < HEIGHT ? &rows[(y + 1) * WORDS] : (wrap ? &rows[0] : EMPTY.data());
+                for (uint8_t w = 0; w < WORDS; ++w) next[y * WORDS + w] = stepWord(up, mid, down, w, rule, wrap);
+            }
+            rows = next;
+        }
+
+    private:
+        /*
+         * 整行左右移动一格：west(r) 的第 x 位是 r 的第 x - 1 位，east(r) 的第 x 位是 r 的第 x + 1 位。
+         * 移出一个字的那一位进到相邻的字里；行首、行尾的那一位在 wrap 时绕到另一端，否则补 0。
+         */
+        static Row west(const Row *r, const uint8_t w, const bool wrap) {
+            const Row carry = w > 0 ? r[w - 1] >> 31 : (wrap ? (r[WORDS - 1] >> TOP_BIT) & 1u : 0);
+            return ((r[w] << 1) | carry) & (w + 1 < WORDS ? ~Row{0} : LAST_MASK);
+        }
+
+        static Row east(const Row *r, const uint8_t w, const bool wrap) {
+            const Row carry = w + 1 < WORDS ? (r[w + 1] & 1u) << 31 : (wrap ? (r[0] & 1u) << TOP_BIT : 0);
+            return (r[w] >> 1) | carry;
+        }
+
+        static Row stepWord(const Row *up, const Row *mid, const Row *down, const uint8_t w, const Rule rule,
+                            const bool wrap) {
+            // 8 个邻居方向的位向量
+            const Row n0 = west(up, w, wrap), n1 = up[w], n2 = east(up, w, wrap);
+            const Row n3 = west(mid, w, wrap), n4 = east(mid, w, wrap);
+            const Row n5 = west(down, w, wrap), n6 = down[w], n7 = east(down, w, wrap);
+
+            // 按位加法树：8 个 1 bit 输入 -> 4 bit 计数 (b3 b2 b1 b0)
+            const auto full = [](const Row a, const Row b, const Row c, Row &carry) {
+                carry = (a & b) | (c & (a ^ b));
+                return a ^ b ^ c;
+            };
+            Row c0a, c0b, c1a, c2a;
+            const Row s0a = full(n0, n1, n2, c0a);
+            const Row s0b = full(n3, n4, n5, c0b);
+            const Row s0c = n6 ^ n7, c0c = n6 & n7;
+            const Row b0 = full(s0a, s0b, s0c, c1a);  // 权重 1
+            const Row s2 = full(c0a, c0b, c0c, c2a);  // 权重 2 的三个进位
+            const Row b1 = s2 ^ c1a, c2b = s2 & c1a;  // 权重 2
+            const Row b2 = c2a ^ c2b, b3 = c2a & c2b; // 权重 4、8
+
+            // 按规则组合：邻居数恰好为 n 的位置，死细胞看 birth，活细胞看 survive
+            const Row self = mid[w];
+            Row next = 0;
+            for (uint8_t n = 0; n <= 8; ++n) {
+                const bool born = (rule.birth >> n) & 1u;
+                const bool stays = (rule.survive >> n) & 1u;
+                if (!born && !stays) continue;
+
+                const Row count_is_n = ((n & 1) ? b0 : ~b0) & ((n & 2) ? b1 : ~b1) & ((n & 4) ? b2 : ~b2) &
+                                       ((n & 8) ? b3 : ~b3);
+                next |= count_is_n & ((born ? ~self : 0) | (stays ? self : 0));
+            }
+            return next & (w + 1 < WORDS ? ~Row{0} : LAST_MASK);
+        }
+
+        std::array<Row, WORDS * HEIGHT> rows{};
+    };
+} // namespace Life
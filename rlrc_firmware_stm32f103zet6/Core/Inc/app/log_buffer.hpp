@@ -0,0 +1,39 @@
+/**
+ * 日志缓冲区
+ *
+ * 通过串口 printf 输出日志很慢 (115200 波特率下 256 字节约 22ms)，
+ * 为了不阻塞数据包处理与动画，日志先写入这里，再由低优先级任务分批输出。
+ * 仅在主循环上下文中使用。
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace LogBuffer {
+    constexpr size_t CAPACITY = 1024;
+
+    /**
+     * @brief 追加一段日志文本
+     * @return 空间不足导致内容被截断时返回 false
+     */
+    bool write(std::span<const char> text);
+
+    // 单条格式化日志的最大长度，超出部分被截断
+    constexpr size_t MAX_LINE = 128;
+
+    /**
+     * @brief 按 printf 格式追加一条日志
+     * @return 空间不足或超过 MAX_LINE 导致内容被截断时返回 false
+     */
+    bool print(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+    /**
+     * @brief 输出至多 max_bytes 字节的日志
+     * @return 缓冲区中剩余的字节数
+     */
+    size_t drain(size_t max_bytes);
+
+    [[nodiscard]] bool empty();
+} // namespace LogBuffer
@@ -0,0 +1,144 @@
+/**
+ * Q16.16 定点梯度噪声 (Perlin)
+ *
+ * 在没有 FPU 的 Cortex-M3 上，浮点噪声每个采样要几千个周期。这里全部用整数运算：
+ * - 格点哈希复用 Fixed::PERM 置换表
+ * - 梯度取自固定的小表 (2D 8 个方向，3D 16 个立方体棱方向)，分量只有 -1/0/1，点积只需加减
+ * - 插值曲线为 6t^5 - 15t^4 + 10t^3，格点处一阶、二阶导数连续，看不出网格
+ *
+ * perlin2/perlin3 输出约为 [-1, 1]，fbm 叠加多个倍频程用于云、火焰、水面等纹理。
+ * 3D 版本通常把时间作为第三维，得到平滑演变的 2D 图案。
+ * 置换表只有 256 项，噪声在每个轴上以 256 为周期重复，随时间增长的坐标可以用 wrap() 折回，避免溢出。
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "fixed_math.hpp"
+
+namespace Noise {
+    using Fixed::q16;
+
+    namespace detail {
+        struct Grad2 {
+            int8_t x, y;
+        };
+
+        struct Grad3 {
+            int8_t x, y, z;
+        };
+
+        // 2D 梯度：4 个轴向 + 4 个对角方向
+        inline constexpr std::array<Grad2, 8> GRAD2 = {{
+            {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {1, -1}, {-1, -1},
+        }};
+
+        // 3D 梯度：立方体的 12 条棱方向，补 4 个重复项凑成 16 个，用 & 15 代替 % 12
+        inline constexpr std::array<Grad3, 16> GRAD3 = {{
+            {1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0},
+            {1, 0, 1}, {-1, 0, 1}, {1, 0, -1}, {-1, 0, -1},
+            {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1},
+            {1, 1, 0}, {-1, 1, 0}, {0, -1, 1}, {0, -1, -1},
+        }};
+
+        // 分量只有 -1/0/1，点积退化为加减
+        constexpr q16 dot(const int8_t g, const q16 v) { return g > 0 ? v : (g < 0 ? -v : 0); }
+
+        constexpr q16 grad2(const uint8_t hash, const q16 x, const q16 y) {
+            const Grad2 g = GRAD2[hash & 7];
+            return dot(g.x, x) + dot(g.y, y);
+        }
+
+        constexpr q16 grad3(const uint8_t hash, const q16 x, const q16 y, const q16 z) {
+            const Grad3 g = GRAD3[hash & 15];
+            return dot(g.x, x) + dot(g.y, y) + dot(g.z, z);
+        }
+
+        constexpr uint8_t hash3(const int32_t x, const int32_t y, const int32_t z) {
+            return Fixed::PERM[(Fixed::hash(x, y) + z) & 0xFF];
+        }
+    } // namespace detail
+
+    /**
+     * @brief 五次插值曲线 6t^5 - 15t^4 + 10t^3，t 为 [0, 1] 内的 Q16
+     */
+    constexpr q16 fade(const q16 t) {
+        using Fixed::mul;
+        return mul(mul(mul(t, t), t), mul(t, mul(t, Fixed::fromInt(6)) - Fixed::fromInt(15)) + Fixed::fromInt(10));
+    }
+
+    /**
+     * @brief 把坐标折回一个周期 [0, 256) 内，结果不变
+     */
+    constexpr q16 wrap(const q16 a) { return a & (Fixed::fromInt(256) - 1); }
+
+    /**
+     * @brief 二维梯度噪声，输出约 [-1, 1]，整数格点处为 0
+     */
+    constexpr q16 perlin2(const q16 x, const q16 y) {
+        using Fixed::lerp;
+        const int32_t ix = x >> 16;
+        const int32_t iy = y >> 16;
+        const q16 fx = Fixed::fract(x);
+        const q16 fy = Fixed::fract(y);
+        const q16 u = fade(fx);
+        const q16 v = fade(fy);
+
+        const q16 n00 = detail::grad2(Fixed::hash(ix, iy), fx, fy);
+        const q16 n10 = detail::grad2(Fixed::hash(ix + 1, iy), fx - Fixed::ONE, fy);
+        const q16 n01 = detail::grad2(Fixed::hash(ix, iy + 1), fx, fy - Fixed::ONE);
+        const q16 n11 = detail::grad2(Fixed::hash(ix + 1, iy + 1), fx - Fixed::ONE, fy - Fixed::ONE);
+        return lerp(lerp(n00, n10, u), lerp(n01, n11, u), v);
+    }
+
+    /**
+     * @brief 三维梯度噪声，输出约 [-1, 1]，整数格点处为 0
+     */
+    constexpr q16 perlin3(const q16 x, const q16 y, const q16 z) {
+        using Fixed::lerp;
+        using detail::grad3;
+        using detail::hash3;
+        const int32_t ix = x >> 16;
+        const int32_t iy = y >> 16;
+        const int32_t iz = z >> 16;
+        const q16 fx = Fixed::fract(x);
+        const q16 fy = Fixed::fract(y);
+        const q16 fz = Fixed::fract(z);
+        const q16 gx = fx - Fixed::ONE;
+        const q16 gy = fy - Fixed::ONE;
+        const q16 gz = fz - Fixed::ONE;
+        const q16 u = fade(fx);
+        const q16 v = fade(fy);
+        const q16 w = fade(fz);
+
+        const q16 x00 = lerp(grad3(hash3(ix, iy, iz), fx, fy, fz), grad3(hash3(ix + 1, iy, iz), gx, fy, fz), u);
+        const q16 x10 = lerp(grad3(hash3(ix, iy + 1, iz), fx, gy, fz), grad3(hash3(ix + 1, iy + 1, iz), gx, gy, fz), u);
+        const q16 x01 = lerp(grad3(hash3(ix, iy, iz + 1), fx, fy, gz), grad3(hash3(ix + 1, iy, iz + 1), gx, fy, gz), u);
+        const q16 x11 =
+            lerp(grad3(hash3(ix, iy + 1, iz + 1), fx, gy, gz), grad3(hash3(ix + 1, iy + 1, iz + 1), gx, gy, gz), u);
+        return lerp(lerp(x00, x10, v), lerp(x01, x11, v), w);
+    }
+
+    /**
+     * @brief 分形布朗运动：叠加 octaves 层 3D 噪声，每层频率翻倍、振幅减半，输出约 [-1, 1]
+     */
+    constexpr q16 fbm3(q16 x, q16 y, q16 z, const uint8_t octaves) {
+        q16 sum = 0;
+        q16 amplitude = Fixed::HALF;
+        q16 total = 0; // 振幅之和，用于归一化
+        for (uint8_t i = 0; i < octaves; ++i) {
+            sum += Fixed::mul(perlin3(x, y, z), amplitude);
+            total += amplitude;
+            amplitude /= 2;
+            x *= 2;
+            y *= 2;
+            z *= 2;
+        }
+        return total != 0 ? Fixed::div(sum, total) : 0;
+    }
+
+    static_assert(perlin2(Fixed::fromInt(3), Fixed::fromInt(7)) == 0);
+    static_assert(perlin3(Fixed::fromInt(1), Fixed::fromInt(2), Fixed::fromInt(3)) == 0);
+    static_assert(fade(0) == 0 && fade(Fixed::ONE) == Fixed::ONE && fade(Fixed::HALF) == Fixed::HALF);
+} // namespace Noise
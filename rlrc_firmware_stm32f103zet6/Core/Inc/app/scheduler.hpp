@@ -0,0 +1,105 @@
+/**
+ * 协作式 (run-to-completion) 任务调度器
+ *
+ * - 每个任务是一个普通函数，被调度后一次执行到底，不会被其他任务抢占 (中断仍可打断)
+ * - 中断通过 post() 把任务标记为就绪：只是对一个原子位图做 fetch_or，无锁、不关中断
+ * - 主循环反复调用 runOne()，总是先运行优先级最高的就绪任务；同一优先级按添加顺序
+ * - 每个任务记录运行次数、运行时间、从就绪到开始运行的等待时间，以及截止期限 (deadline) 的超时次数
+ *
+ * 调度器本身不依赖 HAL，时间来源由构造函数注入：固件中使用 DWT 周期计数器，
+ * 在主机上可以换成模拟时钟单独编译运行。
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+class TaskScheduler {
+public:
+    using TaskFn = void (*)();
+    using ClockFn = uint32_t (*)(); // 单调递增、允许回绕的时钟
+    using TaskId = uint8_t;
+
+    static constexpr uint8_t MAX_TASKS = 8;
+
+    // 数值越小优先级越高
+    enum class Priority : uint8_t {
+        HIGH = 0,
+        NORMAL,
+        LOW,
+        COUNT,
+    };
+
+    // 单个任务的运行统计 (时间单位与时钟一致)
+    struct TaskStats {
+        uint32_t runs = 0;
+        uint64_t total_time = 0;
+        uint32_t max_time = 0;      // 单次运行的最长耗时
+        uint32_t max_latency = 0;   // 从 post() 到开始运行的最长等待
+        uint32_t deadline_misses = 0; // 等待 + 运行 超过 deadline 的次数
+    };
+
+    explicit TaskScheduler(ClockFn clock);
+
+    /**
+     * @brief 注册任务，应在启动阶段 (中断开始 post 之前) 完成
+     * @param name 任务名 (用于统计输出)
+     * @param fn 任务函数
+     * @param priority 优先级
+     * @param deadline 从就绪到运行结束的期限，0 表示不检查
+     * @return 任务 ID，传给 post()
+     */
+    TaskId add(const char *name, TaskFn fn, Priority priority, uint32_t deadline = 0);
+
+    /**
+     * @brief 修改任务的期限 (例如帧率改变后)，只在主循环中调用
+     */
+    void setDeadline(TaskId id, uint32_t deadline);
+
+    /**
+     * @brief 将任务标记为就绪，可在中断中调用
+     * 任务在运行前被多次 post 只会运行一次
+     */
+    void post(TaskId id);
+
+    /**
+     * @brief 运行一个优先级最高的就绪任务
+     * @return 没有就绪任务时返回 false
+     */
+    bool runOne();
+
+    /**
+     * @brief 是否没有任何就绪任务 (主循环据此决定是否休眠)
+     */
+    [[nodiscard]] bool idle() const;
+
+    [[nodiscard]] uint8_t taskCount() const;
+
+    [[nodiscard]] const char *taskName(TaskId id) const;
+
+    /**
+     * @brief 取出任务统计并清零
+     */
+    TaskStats takeStats(TaskId id);
+
+private:
+    struct Task {
+        const char *name = nullptr;
+        TaskFn fn = nullptr;
+        Priority priority = Priority::LOW;
+        uint32_t deadline = 0;
+        std::atomic_uint32_t ready_since = 0; // 由 post() 在置位时写入
+        TaskStats stats{};
+    };
+
+    ClockFn clock;
+    std::array<Task, MAX_TASKS> tasks{};
+    uint8_t task_count = 0;
+
+    // 每个优先级包含哪些任务 (位图)
+    std::array<uint32_t, static_cast<uint8_t>(Priority::COUNT)> priority_masks{};
+
+    // 就绪位图，中断与主循环共享
+    std::atomic_uint32_t ready_mask = 0;
+};
@@ -0,0 +1,89 @@
+/**
+ * 设备端的演出序列 (cue list)
+ *
+ * 序列由若干 (时间, 指令) 条目组成，指令就是普通的协议数据包 (切换模式、过渡、播放片段……)，
+ * 上传到 STM32 后按 MCU 自己的时钟执行，演出节奏不再受 Wi-Fi 抖动和 APP 是否在线的影响。
+ *
+ * - 条目时间相对于序列开始的时刻，必须单调不减
+ * - 循环播放时每一轮的起点 = 上一轮起点 + 循环周期，不会累积误差
+ * - update() 在每个帧节拍调用，执行所有已经到期的条目，误差不超过一个帧节拍
+ *
+ * 序列本身不依赖 HAL：时间与执行指令的函数由调用者传入，可在主机上单独模拟。
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+class Sequencer {
+public:
+    using DispatchFn = void (*)(std::span<const uint8_t> packet);
+
+    static constexpr size_t BUFFER_SIZE = 2048;   // 序列存储空间 (字节)
+    static constexpr size_t MAX_PACKET_SIZE = 255; // 单条指令的最大长度
+
+    enum class ErrorCode : uint8_t {
+        NONE = 0,
+        FULL,           // 存储空间不足
+        INVALID_PACKET, // 指令为空或过长
+        OUT_OF_ORDER,   // 条目时间早于上一条
+    };
+
+    static Sequencer &getInstance();
+
+    /**
+     * @brief 追加一个条目 (播放中也可以追加)
+     * @param time_ms 相对于序列开始的时间
+     * @param packet 到时执行的协议数据包
+     */
+    ErrorCode append(uint32_t time_ms, std::span<const uint8_t> packet);
+
+    /**
+     * @brief 停止并清空序列
+     */
+    void clear();
+
+    /**
+     * @brief 从头开始播放
+     * @param now 当前时间 (ms)
+     * @param loop_ms 循环周期，0 表示只播放一遍
+     */
+    void start(uint32_t now, uint32_t loop_ms);
+
+    void stop();
+
+    [[nodiscard]] bool isRunning() const;
+
+    [[nodiscard]] size_t cueCount() const;
+
+    /**
+     * @brief 执行所有到期的条目
+     * @param now 当前时间 (ms)
+     * @param dispatch 执行一条指令
+     */
+    void update(uint32_t now, DispatchFn dispatch);
+
+    Sequencer(const Sequencer &) = delete;
+    Sequencer &operator=(const Sequencer &) = delete;
+
+private:
+    // 每个条目的存储格式：[时间 uint32][长度 uint8][数据包...]
+    static constexpr size_t CUE_HEADER_SIZE = 5;
+
+    Sequencer() = default;
+
+    [[nodiscard]] uint32_t cueTime(size_t offset) const;
+
+    std::array<uint8_t, BUFFER_SIZE> buffer{};
+    size_t used = 0;        // 已使用的字节数
+    size_t cue_count = 0;
+    uint32_t last_time = 0; // 最后一个条目的时间
+
+    bool running = false;
+    uint32_t generation = 0; // 每次 start()/stop()/clear() 递增，用于发现执行指令期间序列被修改
+    uint32_t base_time = 0;  // 本轮的起点
+    uint32_t loop_period = 0;
+    size_t next_offset = 0;  // 下一个待执行条目在 buffer 中的位置
+};
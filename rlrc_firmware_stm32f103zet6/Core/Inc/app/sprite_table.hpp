@@ -0,0 +1,73 @@
+/**
+ * RAM 中的精灵表 (SpriteTable)
+ *
+ * 小图案 (角色、图标、光标……) 只上传一次，之后用 blit() 按坐标合成到帧缓冲，
+ * 移动一个物体只需一条几个字节的指令，不必重发整帧。
+ *
+ * - 最多 SPRITE_COUNT 个精灵，每个最大 MAX_SIZE x MAX_SIZE，像素为 RGB，按行存放
+ * - 透明：上传时可以指定一个关键色 (color key)，等于关键色的像素不绘制
+ * - 半透明：blit 时指定整体不透明度 alpha，与帧缓冲中已有的颜色混合
+ * - 支持水平/垂直翻转，超出点阵的部分自动裁剪
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "color.hpp"
+#include "ws2812b.hpp"
+
+class SpriteTable {
+public:
+    static constexpr uint8_t SPRITE_COUNT = 16;
+    static constexpr uint8_t MAX_SIZE = 8;
+
+    enum class ErrorCode : uint8_t {
+        NONE = 0,
+        INVALID_ID,   // 精灵编号越界
+        INVALID_SIZE, // 宽高为 0 或超过 MAX_SIZE
+        BAD_LENGTH,   // 像素数据长度不等于 width * height * 3
+        EMPTY,        // 该编号还没有上传精灵
+    };
+
+    // blit() 的标志位
+    enum Flags : uint8_t {
+        FLIP_X = 1u << 0,      // 水平翻转
+        FLIP_Y = 1u << 1,      // 垂直翻转
+        CLEAR_FIRST = 1u << 2, // 先清空帧缓冲，移动唯一的物体时不需要再单独擦除旧位置
+    };
+
+    static SpriteTable &getInstance();
+
+    /**
+     * @brief 上传 (或覆盖) 一个精灵
+     * @param key 透明关键色，传 nullptr 表示不透明
+     * @param pixels width * height 个 RGB 像素，按行排列
+     */
+    ErrorCode upload(uint8_t id, uint8_t width, uint8_t height, const Color::Rgb *key,
+                     std::span<const uint8_t> pixels);
+
+    /**
+     * @brief 把精灵合成到帧缓冲，左上角位于 (x, y)
+     * @param flags Flags 的组合
+     * @param alpha 整体不透明度，255 为直接覆盖
+     */
+    ErrorCode blit(WS2812B &fb, uint8_t id, int16_t x, int16_t y, uint8_t flags, uint8_t alpha) const;
+
+    SpriteTable(const SpriteTable &) = delete;
+    SpriteTable &operator=(const SpriteTable &) = delete;
+
+private:
+    struct Sprite {
+        uint8_t width = 0; // 0 表示空
+        uint8_t height = 0;
+        bool has_key = false;
+        Color::Rgb key{};
+        std::array<Color::Rgb, MAX_SIZE * MAX_SIZE> pixels{};
+    };
+
+    SpriteTable() = default;
+
+    std::array<Sprite, SPRITE_COUNT> sprites{};
+};
@@ -0,0 +1,73 @@
+/**
+ * 单生产者单消费者 (SPSC) 无锁环形队列
+ *
+ * 用于把中断里产生的事件交给主循环中的任务处理，入队/出队都不关中断、不分配内存。
+ *
+ * - 只允许一个生产者和一个消费者。在本固件中，"一个生产者" 指同一抢占优先级的一组中断：
+ *   同优先级的中断不会互相打断，因此可以共用一个队列；不同优先级的中断要各用一个队列
+ * - head 只由生产者写，tail 只由消费者写，两者都是自由递增、允许回绕的计数，
+ *   下标取低位，因此容量必须是 2 的幂，且 head - tail 就是当前元素个数
+ * - 内存序：生产者先写元素，再以 release 发布 head；消费者以 acquire 读 head 后才读元素。
+ *   消费者读完元素后以 release 发布 tail，生产者以 acquire 读 tail 后才覆盖该槽位。
+ *   Cortex-M3 是单核、无数据缓存，这些内存序在硬件上只需要 DMB (GCC 会自动插入)，
+ *   但它们同时约束了编译器不得重排元素读写与计数器更新，这一点在单核上同样必要
+ */
+
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+template<typename T, size_t Capacity>
+    requires(std::has_single_bit(Capacity) && std::is_trivially_copyable_v<T>)
+class SpscQueue {
+public:
+    static constexpr size_t CAPACITY = Capacity;
+
+    /**
+     * @brief 入队，只能由生产者调用 (可在中断中调用)
+     * @return 队列已满时返回 false，元素被丢弃
+     */
+    bool push(const T &item) {
+        const uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == Capacity) return false;
+
+        buffer[h & MASK] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 出队，只能由消费者调用
+     * @return 队列为空时返回 std::nullopt
+     */
+    std::optional<T> pop() {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) return std::nullopt;
+
+        const T item = buffer[t & MASK];
+        tail.store(t + 1, std::memory_order_release);
+        return item;
+    }
+
+    /**
+     * @brief 当前元素个数 (另一端可能同时在修改，结果只是一个快照)
+     */
+    [[nodiscard]] size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+private:
+    static constexpr uint32_t MASK = Capacity - 1;
+    static_assert(Capacity <= (1u << 31), "计数差值必须能用 uint32_t 表示");
+    static_assert(std::atomic_uint32_t::is_always_lock_free);
+
+    T buffer[Capacity]{};
+    std::atomic_uint32_t head = 0; // 生产者写
+    std::atomic_uint32_t tail = 0; // 消费者写
+};
@@ -18,6 +18,11 @@ public:
      */
     void init();
 
+    /**
+     * @brief 串口出错后重新启动接收，丢弃缓冲区中尚未处理的数据
+     */
+    void restart();
+
     /**
      * @brief 尝试获取一个完整的解码包
      * * @param output_buffer [输入/输出] 调用者提供的临时工作区。
@@ -0,0 +1,39 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "main.h"
+
+extern "C" UART_HandleTypeDef huart3;
+
+/**
+ * @brief 经 USART3 (ESP8266) 向 APP 回复数据包
+ *
+ * 数据包先 COBS 编码到发送缓冲区，再以中断方式发送，调用方不必等串口发完；
+ * 与接收方向的 DMA 互不影响。同一时刻只有一个包在发送，回复都很短，不做排队。
+ */
+class UART_Transmitter {
+public:
+    // 回复包 (编码前) 的最大长度
+    static constexpr uint16_t MAX_PACKET_SIZE = 64;
+
+    static UART_Transmitter &getInstance();
+
+    /**
+     * @brief 编码并开始发送一个数据包
+     * @return 上一个包还没发完、或者包过长时返回 false，本次不发送
+     */
+    bool send(std::span<const uint8_t> packet);
+
+    [[nodiscard]] bool isBusy() const;
+
+    UART_Transmitter(const UART_Transmitter &) = delete;
+    UART_Transmitter &operator=(const UART_Transmitter &) = delete;
+
+private:
+    UART_Transmitter() = default;
+
+    // 编码后最多多出一个路标和一个分界符
+    std::array<uint8_t, MAX_PACKET_SIZE + 2> txBuffer{};
+};
@@ -1,6 +1,19 @@
 #include "ProtocolHandler.hpp"
+#include "animation_manager.hpp"
+#include "clip_effect.hpp"
+#include "clip_store.hpp"
+#include "draw.hpp"
+#include "frame_timer.hpp"
+#include "keyframe_effect.hpp"
+#include "log_buffer.hpp"
+#include "page_effect.hpp"
+#include "sequencer.hpp"
+#include "sprite_table.hpp"
+#include "text_effect.hpp"
+#include "uart_transmitter.hpp"
+#include "vm_effect.hpp"
 #include "ws2812b.hpp"
-#include <cstdio>
+#include <array>
 #include <cstring>
 
 namespace ProtocolHandler {
@@ -25,6 +38,56 @@ namespace ProtocolHandler {
                 return handleSetFrame(payload);
             case PacketType::CMD_SET_MODE:
                 return handleSetMode(payload);
+            case PacketType::CMD_SET_BRIGHTNESS:
+                return handleSetBrightness(payload);
+            case PacketType::CMD_SET_POWER_BUDGET:
+                return handleSetPowerBudget(payload);
+            case PacketType::CMD_QUERY_POWER:
+                return handleQueryPower(payload);
+            case PacketType::CMD_SET_EFFECT_PARAM:
+                return handleSetEffectParam(payload);
+            case PacketType::CMD_SET_TRANSITION:
+                return handleSetTransition(payload);
+            case PacketType::CMD_PUSH_KEYFRAME:
+                return handlePushKeyframe(payload);
+            case PacketType::CMD_UPLOAD_PAGE:
+                return handleUploadPage(payload);
+            case PacketType::CMD_FLIP_PAGE:
+                return handleFlipPage(payload);
+            case PacketType::CMD_SET_PAGE_CYCLE:
+                return handleSetPageCycle(payload);
+            case PacketType::CMD_CLIP_BEGIN:
+                return handleClipBegin(payload);
+            case PacketType::CMD_CLIP_DATA:
+                return handleClipData(payload);
+            case PacketType::CMD_CLIP_END:
+                return handleClipEnd(payload);
+            case PacketType::CMD_PLAY_CLIP:
+                return handlePlayClip(payload);
+            case PacketType::CMD_SEQ_APPEND:
+                return handleSeqAppend(payload);
+            case PacketType::CMD_SEQ_CONTROL:
+                return handleSeqControl(payload);
+            case PacketType::CMD_VM_LOAD:
+                return handleVmLoad(payload);
+            case PacketType::CMD_SET_TEXT:
+                return handleSetText(payload);
+            case PacketType::CMD_FILL_RECT:
+                return handleFillRect(payload);
+            case PacketType::CMD_DRAW_LINE:
+                return handleDrawLine(payload);
+            case PacketType::CMD_GRADIENT:
+                return handleGradient(payload);
+            case PacketType::CMD_SHIFT:
+                return handleShift(payload);
+            case PacketType::CMD_SPRITE_UPLOAD:
+                return handleSpriteUpload(payload);
+            case PacketType::CMD_SPRITE_BLIT:
+                return handleSpriteBlit(payload);
+            case PacketType::CMD_SET_DITHERING:
+                return handleSetDithering(payload);
+            case PacketType::CMD_SET_FPS:
+                return handleSetFps(payload);
         }
 
         // 从这里出来说明出现未知指令
@@ -37,21 +100,21 @@ namespace ProtocolHandler {
         // 需要 5 个字节: X, Y, R, G, B
         if (payload.size() < 5) return ErrorCode::INVALID_BUFFER_LENGTH;
 
-        auto &led = WS2812B::getInstance();
-        led.setPixel(payload[0], payload[1], payload[2], payload[3], payload[4]);
-        led.render();
+        // 只写入帧缓冲，由下一个帧节拍统一 render()，帧间隔不受数据包到达时刻影响
+        WS2812B::getInstance().setPixel(payload[0], payload[1], payload[2], payload[3], payload[4]);
 
-        printf("[ESP->BIN] SetPixel (%d,%d)\r\n", payload[0], payload[1]);
+        LogBuffer::print("[ESP->BIN] SetPixel (%d,%d)\r\n", payload[0], payload[1]);
         return ErrorCode::OK;
     }
 
     ErrorCode handleSetFrame(const std::span<const uint8_t> payload) {
         if (payload.size() != WS2812B::LED_COUNT * 3) return ErrorCode::INVALID_BUFFER_LENGTH;
 
-        auto& led = WS2812B::getInstance();
-
+        // 流式推送的帧默认直接显示，否则每一帧都会被拖成一次过渡
+        // APP 开启整帧过渡后，单独发送的新帧从当前画面过渡过去，不需要发送中间帧
+        auto &led = WS2812B::getInstance();
+        if (led.getTransitionFrames()) led.beginTransition();
         led.setFrame(payload);
-        led.render();
 
         return ErrorCode::OK;
     }
@@ -62,30 +125,29 @@ namespace ProtocolHandler {
 
         const bool isOn = (payload[0] == 0x01);
         auto &led = WS2812B::getInstance();
+        led.beginTransition();
         if (isOn)
             led.setAll(64, 64, 64);
         else
             led.clear();
-        led.render();
 
-        printf("[ESP->BIN] Toggle: %s\r\n", isOn ? "ON" : "OFF");
+        LogBuffer::print("[ESP->BIN] Toggle: %s\r\n", isOn ? "ON" : "OFF");
         return ErrorCode::OK;
     }
 
     static ErrorCode handleLog(const std::span<const uint8_t> payload) {
         if (payload.empty()) return ErrorCode::OK; // 空日志忽略
 
-        // 为了 printf 安全，我们需要一个以 \0 结尾的 buffer
-        // 假设最大日志长度不超过 256 (你可以定义一个常量)
-        char logBuf[256];
+        // 只拷贝进日志缓冲区，由低优先级的日志任务慢慢输出，不在这里阻塞在串口上
+        // 最大日志长度不超过 255
         const size_t len = std::min(payload.size(), static_cast<size_t>(255));
+        const std::span<const char> text{reinterpret_cast<const char *>(payload.data()), len};
 
-        std::memcpy(logBuf, payload.data(), len);
-        logBuf[len] = '\0';
-
-        printf("[ESP->LOG] %s", logBuf);
+        constexpr char prefix[] = "[ESP->LOG] ";
+        LogBuffer::write({prefix, sizeof(prefix) - 1});
+        LogBuffer::write(text);
         // 如果原日志没带换行，补一个
-        if (len > 0 && logBuf[len - 1] != '\n') printf("\r\n");
+        if (text.back() != '\n') LogBuffer::write({"\r\n", 2});
 
         return ErrorCode::OK;
     }
@@ -95,19 +157,413 @@ namespace ProtocolHandler {
 
         const uint8_t mode = payload[0];
 
-        // 这里需要一个全局变量或单例来存储当前模式
-        // 假设我们在 maincxx.hpp 中定义了全局变量 g_currentMode
-        // 或者你可以设计一个 AnimationManager 单例
-        g_currentMode.store(mode);
+        // 模式 ID 即效果注册表的下标，未注册的模式不切换
+        if (!AnimationManager::getInstance().setMode(mode)) return ErrorCode::INVALID_ARGUMENT;
 
-        // 收到切换模式指令时，建议清空一下之前的显示，避免残影
+        // 旧画面在过渡时长内淡出到新效果的画面，而不是硬切
+        // 清空帧缓冲，避免新效果没有覆盖到的灯珠留下残影
+        auto &led = WS2812B::getInstance();
+        led.beginTransition();
         if (mode != 0) {
-            WS2812B::getInstance().clear();
-            WS2812B::getInstance().render();
+            led.clear();
+        }
+
+        LogBuffer::print("[ESP->BIN] Set Mode: %d (%s)\r\n", mode,
+                         AnimationManager::getInstance().effect(mode)->name());
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSetBrightness(std::span<const uint8_t> payload) {
+        // 需要 1 个字节: 亮度 (0-255)
+        if (payload.empty()) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        // 亮度在编码阶段统一生效，APP 不需要按比例重发每一帧
+        WS2812B::getInstance().setBrightness(payload[0]);
+
+        LogBuffer::print("[ESP->BIN] Set Brightness: %d\r\n", payload[0]);
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSetPowerBudget(std::span<const uint8_t> payload) {
+        // 需要 2 个字节: 预算电流 mA (uint16，小端)，0 表示不限流
+        if (payload.size() < 2) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const auto milliamps = static_cast<uint16_t>(payload[0] | (payload[1] << 8));
+        WS2812B::getInstance().setPowerBudget(milliamps);
+
+        LogBuffer::print("[ESP->BIN] Set Power Budget: %d mA\r\n", milliamps);
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleQueryPower(std::span<const uint8_t>) {
+        const auto &led = WS2812B::getInstance();
+        const uint32_t current = led.getEstimatedCurrent();
+        const uint16_t budget = led.getPowerBudget();
+        const uint8_t limit = led.getPowerLimit();
+
+        // 经 ESP8266 回复给 APP，多字节字段均为小端
+        const std::array<uint8_t, 8> reply = {
+            static_cast<uint8_t>(ReplyType::REPLY_POWER),
+            static_cast<uint8_t>(current), static_cast<uint8_t>(current >> 8),
+            static_cast<uint8_t>(current >> 16), static_cast<uint8_t>(current >> 24),
+            static_cast<uint8_t>(budget), static_cast<uint8_t>(budget >> 8),
+            limit,
+        };
+        // 上一个回复还在发送，让 APP 稍后再查
+        if (!UART_Transmitter::getInstance().send(reply)) return ErrorCode::BUSY;
+
+        // 限流系数换算为百分比便于阅读
+        LogBuffer::print("[ESP->BIN] Power: %lu mA / budget %d mA, limit %d%%\r\n",
+                         static_cast<unsigned long>(current), budget, (limit + 1) * 100 / 256);
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSetDithering(std::span<const uint8_t> payload) {
+        // 需要 1 个字节: 是否开启时间抖动 (0/1)
+        if (payload.empty()) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        WS2812B::getInstance().setDithering(payload[0] != 0);
+
+        LogBuffer::print("[ESP->BIN] Set Dithering: %s\r\n", payload[0] != 0 ? "ON" : "OFF");
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSetFps(std::span<const uint8_t> payload) {
+        // 需要 2 个字节: 帧率 (小端)
+        if (payload.size() < 2) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const uint16_t fps = payload[0] | payload[1] << 8;
+        if (fps == 0 || fps > FrameTimer::COUNTER_HZ) return ErrorCode::INVALID_ARGUMENT;
+
+        // 下一个节拍起生效，效果任务随后按新的帧周期重新计算期限与计算预算
+        FrameTimer::getInstance().setFps(fps);
+
+        LogBuffer::print("[ESP->BIN] Set FPS: %d\r\n", fps);
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSetEffectParam(std::span<const uint8_t> payload) {
+        // 至少 3 个字节: 模式 ID, 起始参数下标, 参数值...
+        if (payload.size() < 3) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const uint8_t mode = payload[0];
+        const uint8_t offset = payload[1];
+        if (!AnimationManager::getInstance().setParams(mode, offset, payload.subspan(2))) {
+            return ErrorCode::INVALID_ARGUMENT;
+        }
+
+        LogBuffer::print("[ESP->BIN] Set Effect Param: mode %d, [%d..%d]\r\n", mode, offset,
+                         offset + static_cast<int>(payload.size()) - 3);
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSetTransition(std::span<const uint8_t> payload) {
+        // 需要 3 个字节: 过渡类型, 时长 ms (uint16，小端)
+        // 可选第 4 个字节: 整帧刷新是否也过渡 (缺省为否)
+        if (payload.size() < 3) return ErrorCode::INVALID_BUFFER_LENGTH;
+        if (payload[0] >= static_cast<uint8_t>(WS2812B::Transition::COUNT)) return ErrorCode::INVALID_ARGUMENT;
+
+        const auto type = static_cast<WS2812B::Transition>(payload[0]);
+        const auto duration = static_cast<uint16_t>(payload[1] | (payload[2] << 8));
+        const bool frames = payload.size() >= 4 && payload[3] != 0;
+        WS2812B::getInstance().setTransition(type, duration, frames);
+
+        LogBuffer::print("[ESP->BIN] Set Transition: type %d, %d ms, frames %d\r\n", payload[0], duration, frames);
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handlePushKeyframe(std::span<const uint8_t> payload) {
+        // 需要 3 + LED_COUNT * 3 个字节: 缓动曲线, 时长 ms (uint16，小端), RGB 数据
+        if (payload.size() != 3 + WS2812B::LED_COUNT * 3) return ErrorCode::INVALID_BUFFER_LENGTH;
+        if (payload[0] >= static_cast<uint8_t>(Easing::Curve::COUNT)) return ErrorCode::INVALID_ARGUMENT;
+
+        const auto curve = static_cast<Easing::Curve>(payload[0]);
+        const auto duration = static_cast<uint16_t>(payload[1] | (payload[2] << 8));
+        if (!KeyframeEffect::getInstance().push(payload.subspan(3), duration, curve)) return ErrorCode::BUSY;
+
+        // 第一个关键帧自动进入关键帧模式，从当前画面开始插值
+        auto &animation = AnimationManager::getInstance();
+        if (animation.getMode() != AnimationManager::MODE_KEYFRAME) {
+            animation.setMode(AnimationManager::MODE_KEYFRAME);
         }
 
-        printf("[ESP->BIN] Set Mode: %d\r\n", mode);
         return ErrorCode::OK;
     }
 
+    static ErrorCode handleUploadPage(std::span<const uint8_t> payload) {
+        // 需要 1 + PAGE_SIZE 个字节: 页号, RGB 数据
+        if (payload.size() != 1 + PageEffect::PAGE_SIZE) return ErrorCode::INVALID_BUFFER_LENGTH;
+        if (!PageEffect::getInstance().upload(payload[0], payload.subspan(1))) return ErrorCode::INVALID_ARGUMENT;
+
+        LogBuffer::print("[ESP->BIN] Upload Page: %d\r\n", payload[0]);
+        return ErrorCode::OK;
+    }
+
+    // 页面切换进入 RAM 帧页模式 (不做过渡，翻页即显示)
+    static void enterPageMode() {
+        auto &animation = AnimationManager::getInstance();
+        if (animation.getMode() != AnimationManager::MODE_PAGES) {
+            animation.setMode(AnimationManager::MODE_PAGES);
+        }
+    }
+
+    static ErrorCode handleFlipPage(std::span<const uint8_t> payload) {
+        // 需要 1 个字节: 页号
+        if (payload.empty()) return ErrorCode::INVALID_BUFFER_LENGTH;
+        if (!PageEffect::getInstance().flip(payload[0])) return ErrorCode::INVALID_ARGUMENT;
+
+        enterPageMode();
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSetPageCycle(std::span<const uint8_t> payload) {
+        // 需要 4 个字节: 起始页, 页数, 每页时长 ms (uint16，小端)，时长为 0 时停止轮播
+        if (payload.size() < 4) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const auto period = static_cast<uint16_t>(payload[2] | (payload[3] << 8));
+        if (!PageEffect::getInstance().setCycle(payload[0], payload[1], period)) return ErrorCode::INVALID_ARGUMENT;
+
+        if (period != 0) enterPageMode();
+        LogBuffer::print("[ESP->BIN] Page Cycle: %d+%d, %d ms\r\n", payload[0], payload[1], period);
+        return ErrorCode::OK;
+    }
+
+    // 片段存储的错误只打印出来，再统一映射为协议错误码
+    static ErrorCode reportClipError(const char *action, const ClipStore::ErrorCode error) {
+        if (error == ClipStore::ErrorCode::NONE) return ErrorCode::OK;
+
+        LogBuffer::print("[ESP->BIN] Clip %s failed: %d\r\n", action, static_cast<int>(error));
+        return ErrorCode::INVALID_ARGUMENT;
+    }
+
+    static ErrorCode handleClipBegin(std::span<const uint8_t> payload) {
+        // 需要 8 个字节: 槽位, 格式, 每帧时长 ms, 帧数, 调色板颜色数 (uint16 均为小端)
+        if (payload.size() < 8) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const ClipStore::ClipInfo info{
+            static_cast<ClipStore::Format>(payload[1]),
+            static_cast<uint16_t>(payload[6] | (payload[7] << 8)),
+            static_cast<uint16_t>(payload[4] | (payload[5] << 8)),
+            static_cast<uint16_t>(payload[2] | (payload[3] << 8)),
+        };
+        const auto result = reportClipError("begin", ClipStore::getInstance().begin(payload[0], info));
+
+        if (result == ErrorCode::OK) {
+            LogBuffer::print("[ESP->BIN] Clip Begin: slot %d, %d frames\r\n", payload[0], info.frame_count);
+        }
+        return result;
+    }
+
+    static ErrorCode handleClipData(std::span<const uint8_t> payload) {
+        // 至少 5 个字节: 偏移 (uint32，小端), 数据...
+        if (payload.size() < 5) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const uint32_t offset =
+            payload[0] | (payload[1] << 8) | (payload[2] << 16) | (static_cast<uint32_t>(payload[3]) << 24);
+        return reportClipError("data", ClipStore::getInstance().write(offset, payload.subspan(4)));
+    }
+
+    static ErrorCode handleClipEnd(std::span<const uint8_t>) {
+        const auto result = reportClipError("end", ClipStore::getInstance().end());
+
+        if (result == ErrorCode::OK) LogBuffer::print("[ESP->BIN] Clip End\r\n");
+        return result;
+    }
+
+    static ErrorCode handlePlayClip(std::span<const uint8_t> payload) {
+        // 需要 2 个字节: 槽位, 是否循环
+        if (payload.size() < 2) return ErrorCode::INVALID_BUFFER_LENGTH;
+        if (!ClipEffect::getInstance().play(payload[0], payload[1] != 0)) return ErrorCode::INVALID_ARGUMENT;
+
+        auto &animation = AnimationManager::getInstance();
+        if (animation.getMode() != AnimationManager::MODE_CLIP) {
+            WS2812B::getInstance().beginTransition();
+            animation.setMode(AnimationManager::MODE_CLIP);
+        }
+
+        LogBuffer::print("[ESP->BIN] Play Clip: slot %d%s\r\n", payload[0], payload[1] != 0 ? " (loop)" : "");
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSeqAppend(std::span<const uint8_t> payload) {
+        // 至少 5 个字节: 时间 ms (uint32，小端), 到时执行的数据包...
+        if (payload.size() < 5) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const uint32_t time =
+            payload[0] | (payload[1] << 8) | (payload[2] << 16) | (static_cast<uint32_t>(payload[3]) << 24);
+        const auto error = Sequencer::getInstance().append(time, payload.subspan(4));
+        if (error != Sequencer::ErrorCode::NONE) {
+            LogBuffer::print("[ESP->BIN] Sequence append failed: %d\r\n", static_cast<int>(error));
+            return error == Sequencer::ErrorCode::FULL ? ErrorCode::BUSY : ErrorCode::INVALID_ARGUMENT;
+        }
+
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSeqControl(std::span<const uint8_t> payload) {
+        // 需要 1 个字节: 动作 (0 停止, 1 开始, 2 清空)；开始时可再带 4 个字节循环周期 ms (uint32，小端)
+        if (payload.empty()) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        auto &sequencer = Sequencer::getInstance();
+        switch (payload[0]) {
+            case 0:
+                sequencer.stop();
+                break;
+            case 1: {
+                uint32_t loop_ms = 0;
+                if (payload.size() >= 5) {
+                    loop_ms = payload[1] | (payload[2] << 8) | (payload[3] << 16) |
+                              (static_cast<uint32_t>(payload[4]) << 24);
+                }
+                sequencer.start(HAL_GetTick(), loop_ms);
+                break;
+            }
+            case 2:
+                sequencer.clear();
+                break;
+            default:
+                return ErrorCode::INVALID_ARGUMENT;
+        }
+
+        LogBuffer::print("[ESP->BIN] Sequence: action %d, %d cues\r\n", payload[0],
+                         static_cast<int>(sequencer.cueCount()));
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleVmLoad(std::span<const uint8_t> payload) {
+        // 字节码程序 (见 bytecode_vm.hpp)，载入后切换到字节码效果
+        if (payload.empty()) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const auto error = VmEffect::getInstance().load(payload);
+        if (error != BytecodeVm::ErrorCode::NONE) {
+            LogBuffer::print("[ESP->BIN] VM load failed: %d\r\n", static_cast<int>(error));
+            return ErrorCode::INVALID_ARGUMENT;
+        }
+
+        auto &animation = AnimationManager::getInstance();
+        if (animation.getMode() != AnimationManager::MODE_VM) {
+            WS2812B::getInstance().beginTransition();
+            animation.setMode(AnimationManager::MODE_VM);
+        }
+
+        LogBuffer::print("[ESP->BIN] VM load: %d bytes\r\n", static_cast<int>(payload.size()));
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSetText(std::span<const uint8_t> payload) {
+        // 至少 5 个字节: R, G, B, 速度 (uint16，小端，1/256 像素每秒), 文字 (ASCII)...
+        if (payload.size() < 5) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const uint16_t speed = payload[3] | (payload[4] << 8);
+        const auto text = payload.subspan(5);
+        TextEffect::getInstance().setText(text, {payload[0], payload[1], payload[2]}, speed);
+
+        auto &animation = AnimationManager::getInstance();
+        if (animation.getMode() != AnimationManager::MODE_TEXT) {
+            WS2812B::getInstance().beginTransition();
+            animation.setMode(AnimationManager::MODE_TEXT);
+        }
+
+        LogBuffer::print("[ESP->BIN] Set Text: %d chars, speed %d/256 px/s\r\n", static_cast<int>(text.size()), speed);
+        return ErrorCode::OK;
+    }
+
+    // --- 绘图图元 ---
+    // 与 SetPixel 一样只写入帧缓冲；坐标为有符号字节，图元可以部分位于点阵之外
+
+    static ErrorCode handleFillRect(std::span<const uint8_t> payload) {
+        // 需要 7 个字节: X, Y (int8), W, H, R, G, B
+        if (payload.size() < 7) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const auto x = static_cast<int8_t>(payload[0]);
+        const auto y = static_cast<int8_t>(payload[1]);
+        Draw::fillRect(WS2812B::getInstance(), x, y, payload[2], payload[3], {payload[4], payload[5], payload[6]});
+
+        LogBuffer::print("[ESP->BIN] Fill Rect (%d,%d) %dx%d\r\n", x, y, payload[2], payload[3]);
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleDrawLine(std::span<const uint8_t> payload) {
+        // 需要 7 个字节: X0, Y0, X1, Y1 (int8), R, G, B
+        if (payload.size() < 7) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const auto x0 = static_cast<int8_t>(payload[0]);
+        const auto y0 = static_cast<int8_t>(payload[1]);
+        const auto x1 = static_cast<int8_t>(payload[2]);
+        const auto y1 = static_cast<int8_t>(payload[3]);
+        Draw::line(WS2812B::getInstance(), x0, y0, x1, y1, {payload[4], payload[5], payload[6]});
+
+        LogBuffer::print("[ESP->BIN] Draw Line (%d,%d)-(%d,%d)\r\n", x0, y0, x1, y1);
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleGradient(std::span<const uint8_t> payload) {
+        // 需要 11 个字节: 类型, X0, Y0, X1, Y1 (int8), R0, G0, B0, R1, G1, B1
+        // 类型 0 为线性 (P0 -> P1)；类型 1 为径向，圆心 P0，X1 字节为半径 (0-255)，Y1 忽略
+        if (payload.size() < 11) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const auto x0 = static_cast<int8_t>(payload[1]);
+        const auto y0 = static_cast<int8_t>(payload[2]);
+        const auto x1 = static_cast<int8_t>(payload[3]);
+        const auto y1 = static_cast<int8_t>(payload[4]);
+        const Color::Rgb from{payload[5], payload[6], payload[7]};
+        const Color::Rgb to{payload[8], payload[9], payload[10]};
+
+        auto &led = WS2812B::getInstance();
+        switch (payload[0]) {
+            case 0:
+                Draw::linearGradient(led, x0, y0, x1, y1, from, to);
+                break;
+            case 1:
+                Draw::radialGradient(led, x0, y0, payload[3], from, to);
+                break;
+            default:
+                return ErrorCode::INVALID_ARGUMENT;
+        }
+
+        LogBuffer::print("[ESP->BIN] Gradient: type %d\r\n", payload[0]);
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleShift(std::span<const uint8_t> payload) {
+        // 需要 3 个字节: DX, DY (int8), 是否环绕 (0/1)
+        if (payload.size() < 3) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const auto dx = static_cast<int8_t>(payload[0]);
+        const auto dy = static_cast<int8_t>(payload[1]);
+        Draw::shift(WS2812B::getInstance(), dx, dy, payload[2] != 0);
+
+        LogBuffer::print("[ESP->BIN] Shift (%d,%d)%s\r\n", dx, dy, payload[2] != 0 ? " wrap" : "");
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSpriteUpload(std::span<const uint8_t> payload) {
+        // 至少 7 个字节: 编号, 宽, 高, 是否使用关键色, 关键色 R, G, B, 像素 (宽 * 高 * 3)...
+        if (payload.size() < 7) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const Color::Rgb key{payload[4], payload[5], payload[6]};
+        const auto error = SpriteTable::getInstance().upload(payload[0], payload[1], payload[2],
+                                                             payload[3] != 0 ? &key : nullptr, payload.subspan(7));
+        if (error != SpriteTable::ErrorCode::NONE) {
+            LogBuffer::print("[ESP->BIN] Sprite upload failed: %d\r\n", static_cast<int>(error));
+            return error == SpriteTable::ErrorCode::BAD_LENGTH ? ErrorCode::INVALID_BUFFER_LENGTH
+                                                               : ErrorCode::INVALID_ARGUMENT;
+        }
+
+        LogBuffer::print("[ESP->BIN] Sprite %d: %dx%d\r\n", payload[0], payload[1], payload[2]);
+        return ErrorCode::OK;
+    }
+
+    static ErrorCode handleSpriteBlit(std::span<const uint8_t> payload) {
+        // 需要 4 个字节: 编号, X, Y (int8), 标志位 (见 SpriteTable::Flags)；可选第 5 个字节为不透明度，默认 255
+        // 与 SetPixel 一样只写入帧缓冲，高频移动时不打印日志
+        if (payload.size() < 4) return ErrorCode::INVALID_BUFFER_LENGTH;
+
+        const uint8_t alpha = payload.size() > 4 ? payload[4] : 255;
+        const auto error = SpriteTable::getInstance().blit(WS2812B::getInstance(), payload[0],
+                                                           static_cast<int8_t>(payload[1]),
+                                                           static_cast<int8_t>(payload[2]), payload[3], alpha);
+        return error == SpriteTable::ErrorCode::NONE ? ErrorCode::OK : ErrorCode::INVALID_ARGUMENT;
+    }
+
 } // namespace ProtocolHandler
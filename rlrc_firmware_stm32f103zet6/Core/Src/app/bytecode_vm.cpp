@@ -0,0 +1,164 @@
+#include "bytecode_vm.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "color.hpp"
+#include "ws2812b.hpp"
+
+namespace {
+    using Fixed::q16;
+    using Op = BytecodeVm::Op;
+
+    // 每条指令的栈效果与立即数长度
+    struct OpInfo {
+        bool valid;
+        uint8_t pops;
+        uint8_t pushes;
+        uint8_t immediate;
+    };
+
+    constexpr OpInfo opInfo(const uint8_t opcode) {
+        switch (static_cast<Op>(opcode)) {
+            case Op::END: return {true, 0, 0, 0};
+            case Op::CONST: return {true, 0, 1, 4};
+            case Op::PARAM: return {true, 0, 1, 1};
+            case Op::X:
+            case Op::Y:
+            case Op::T:
+            case Op::I:
+            case Op::W:
+            case Op::H: return {true, 0, 1, 0};
+            case Op::ADD:
+            case Op::SUB:
+            case Op::MUL:
+            case Op::DIV:
+            case Op::MOD:
+            case Op::MIN:
+            case Op::MAX:
+            case Op::NOISE: return {true, 2, 1, 0};
+            case Op::NEG:
+            case Op::ABS:
+            case Op::SIN:
+            case Op::COS:
+            case Op::FRACT:
+            case Op::FLOOR:
+            case Op::SQRT: return {true, 1, 1, 0};
+            case Op::HSV: return {true, 3, 3, 0};
+        }
+        return {false, 0, 0, 0};
+    }
+
+    // 有符号溢出是未定义行为：先转为无符号运算，结果按 32 位回绕
+    constexpr q16 wrapAdd(const q16 a, const q16 b) {
+        return static_cast<q16>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b));
+    }
+
+    constexpr q16 wrapSub(const q16 a, const q16 b) {
+        return static_cast<q16>(static_cast<uint32_t>(a) - static_cast<uint32_t>(b));
+    }
+
+    constexpr q16 wrapNeg(const q16 a) { return static_cast<q16>(0u - static_cast<uint32_t>(a)); }
+} // namespace
+
+BytecodeVm::ErrorCode BytecodeVm::load(const std::span<const uint8_t> program) {
+    if (program.size() > MAX_PROGRAM_SIZE) return ErrorCode::TOO_LARGE;
+
+    // 静态模拟栈深度：每条指令的操作数个数固定，与输入数据无关
+    // 通过检查后，run() 中的每次压栈/出栈都不会越界
+    uint8_t depth = 0;
+    size_t pc = 0;
+    while (pc < program.size()) {
+        const OpInfo info = opInfo(program[pc]);
+        if (!info.valid) return ErrorCode::INVALID_OPCODE;
+        if (static_cast<Op>(program[pc]) == Op::END) break;
+        if (pc + 1 + info.immediate > program.size()) return ErrorCode::TRUNCATED;
+        if (depth < info.pops) return ErrorCode::STACK_UNDERFLOW;
+
+        depth = depth - info.pops + info.pushes;
+        if (depth > STACK_SIZE) return ErrorCode::STACK_OVERFLOW;
+        pc += 1 + info.immediate;
+    }
+    if (depth != 3) return ErrorCode::BAD_RESULT;
+
+    // 只保留到 END 之前的指令，末尾统一补一个 END
+    std::copy_n(program.begin(), pc, code.begin());
+    code[pc] = static_cast<uint8_t>(Op::END);
+    code_size = static_cast<uint16_t>(pc + 1);
+    return ErrorCode::NONE;
+}
+
+bool BytecodeVm::loaded() const { return code_size != 0; }
+
+std::array<q16, 3> BytecodeVm::run(const Inputs &in, const std::array<uint8_t, PARAM_COUNT> &params) const {
+    if (code_size == 0) return {};
+
+    std::array<q16, STACK_SIZE> stack; // NOLINT：load() 保证先写后读
+    uint8_t sp = 0;
+    const uint8_t *pc = code.data();
+
+    while (true) {
+        switch (static_cast<Op>(*pc++)) {
+            case Op::END:
+                return {stack[0], stack[1], stack[2]};
+
+            case Op::CONST: {
+                q16 value;
+                std::memcpy(&value, pc, sizeof(value)); // 小端
+                pc += sizeof(value);
+                stack[sp++] = value;
+                break;
+            }
+            case Op::X: stack[sp++] = in.x; break;
+            case Op::Y: stack[sp++] = in.y; break;
+            case Op::T: stack[sp++] = in.t; break;
+            case Op::I: stack[sp++] = in.i; break;
+            case Op::W: stack[sp++] = Fixed::fromInt(WS2812B::WIDTH); break;
+            case Op::H: stack[sp++] = Fixed::fromInt(WS2812B::HEIGHT); break;
+            case Op::PARAM: {
+                const uint8_t index = *pc++;
+                stack[sp++] = index < PARAM_COUNT ? Fixed::fromInt(params[index]) : 0;
+                break;
+            }
+
+            case Op::ADD: sp--; stack[sp - 1] = wrapAdd(stack[sp - 1], stack[sp]); break;
+            case Op::SUB: sp--; stack[sp - 1] = wrapSub(stack[sp - 1], stack[sp]); break;
+            case Op::MUL: sp--; stack[sp - 1] = Fixed::mul(stack[sp - 1], stack[sp]); break;
+            case Op::DIV: sp--; stack[sp - 1] = Fixed::div(stack[sp - 1], stack[sp]); break;
+            case Op::MOD: {
+                sp--;
+                const q16 b = stack[sp];
+                // 除数为 -1 时余数总是 0，同时避开 INT32_MIN % -1 (未定义行为)
+                if (b == 0 || b == -1) {
+                    stack[sp - 1] = 0;
+                } else {
+                    const q16 r = stack[sp - 1] % b;
+                    stack[sp - 1] = (r != 0 && (r < 0) != (b < 0)) ? r + b : r;
+                }
+                break;
+            }
+            case Op::MIN: sp--; stack[sp - 1] = std::min(stack[sp - 1], stack[sp]); break;
+            case Op::MAX: sp--; stack[sp - 1] = std::max(stack[sp - 1], stack[sp]); break;
+            case Op::NOISE: sp--; stack[sp - 1] = Fixed::valueNoise(stack[sp - 1], stack[sp]); break;
+
+            case Op::NEG: stack[sp - 1] = wrapNeg(stack[sp - 1]); break;
+            case Op::ABS: stack[sp - 1] = stack[sp - 1] < 0 ? wrapNeg(stack[sp - 1]) : stack[sp - 1]; break;
+            case Op::SIN: stack[sp - 1] = Fixed::sin(stack[sp - 1]); break;
+            case Op::COS: stack[sp - 1] = Fixed::cos(stack[sp - 1]); break;
+            case Op::FRACT: stack[sp - 1] = Fixed::fract(stack[sp - 1]); break;
+            case Op::FLOOR: stack[sp - 1] = Fixed::floor(stack[sp - 1]); break;
+            case Op::SQRT: stack[sp - 1] = Fixed::sqrt(stack[sp - 1]); break;
+
+            case Op::HSV: {
+                // 色相取小数部分 (圈)，饱和度与明度截断到 [0, 1]
+                const auto h = static_cast<uint8_t>(Fixed::fract(stack[sp - 3]) >> 8);
+                const Color::Rgb c = Color::hsv(h, Fixed::toByte(stack[sp - 2]), Fixed::toByte(stack[sp - 1]));
+                // 0-255 还原为 Q16 [0, 1]
+                stack[sp - 3] = (c.r << 8) | c.r;
+                stack[sp - 2] = (c.g << 8) | c.g;
+                stack[sp - 1] = (c.b << 8) | c.b;
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,160 @@
+#include "clip_store.hpp"
+
+#include <cstring>
+
+#include "main.h"
+#include "ws2812b.hpp"
+
+// 链接脚本中 CLIPS 区域的起止地址
+extern "C" const uint8_t _sclips[];
+extern "C" const uint8_t _eclips[];
+
+ClipStore &ClipStore::getInstance() {
+    static ClipStore instance;
+    return instance;
+}
+
+size_t ClipStore::Clip::frameSize() const {
+    return info.format == Format::RAW ? WS2812B::LED_COUNT * 3 : WS2812B::LED_COUNT;
+}
+
+std::span<const uint8_t> ClipStore::Clip::frame(const uint16_t index) const {
+    if (index >= info.frame_count) return {};
+    return {frames + index * frameSize(), frameSize()};
+}
+
+uint32_t ClipStore::slotSize() const {
+    // 槽位大小按页对齐
+    const auto total = static_cast<uint32_t>(_eclips - _sclips);
+    return total / SLOT_COUNT / PAGE_SIZE * PAGE_SIZE;
+}
+
+uintptr_t ClipStore::slotBase(const uint8_t slot) const {
+    return reinterpret_cast<uintptr_t>(_sclips) + slot * slotSize();
+}
+
+uint32_t ClipStore::dataSize(const ClipInfo &info) {
+    const uint32_t frame_size = info.format == Format::RAW ? WS2812B::LED_COUNT * 3 : WS2812B::LED_COUNT;
+    return info.palette_count * 3 + info.frame_count * frame_size;
+}
+
+ClipStore::ErrorCode ClipStore::begin(const uint8_t slot, const ClipInfo &info) {
+    if (slot >= SLOT_COUNT) return ErrorCode::INVALID_SLOT;
+    if (info.format >= Format::COUNT || info.frame_count == 0) return ErrorCode::INVALID_CLIP;
+    if (info.format == Format::PALETTE && (info.palette_count == 0 || info.palette_count > 256)) {
+        return ErrorCode::INVALID_CLIP;
+    }
+    if (sizeof(Header) + dataSize(info) > slotSize()) return ErrorCode::TOO_LARGE;
+
+    writing = false;
+    erased_until = slotBase(slot);
+
+    // 先擦除第一页：旧片段的 Header 随之失效
+    HAL_FLASH_Unlock();
+    const bool erased = ensureErased(slotBase(slot));
+    HAL_FLASH_Lock();
+    if (!erased) return ErrorCode::FLASH_ERROR;
+
+    writing = true;
+    write_slot = slot;
+    write_info = info;
+    write_size = dataSize(info);
+    write_cursor = 0;
+    return ErrorCode::NONE;
+}
+
+ClipStore::ErrorCode ClipStore::write(const uint32_t offset, const std::span<const uint8_t> data) {
+    if (!writing) return ErrorCode::NOT_WRITING;
+    if (offset != write_cursor) return ErrorCode::BAD_OFFSET;
+    if (data.size() > write_size - write_cursor) return ErrorCode::OVERFLOW;
+
+    const uintptr_t data_base = slotBase(write_slot) + sizeof(Header);
+    bool ok = true;
+
+    HAL_FLASH_Unlock();
+    for (const uint8_t byte: data) {
+        // 数据区起始地址是偶数，偶数偏移的字节先暂存，凑齐一个半字再编程 (小端：低地址在低字节)
+        if ((write_cursor & 1) == 0) {
+            pending_byte = byte;
+        } else {
+            const uintptr_t address = data_base + write_cursor - 1;
+            ok = ensureErased(address) && programHalfWord(address, static_cast<uint16_t>(pending_byte | (byte << 8)));
+            if (!ok) break;
+        }
+        write_cursor++;
+    }
+    HAL_FLASH_Lock();
+
+    if (!ok) {
+        writing = false;
+        return ErrorCode::FLASH_ERROR;
+    }
+    return ErrorCode::NONE;
+}
+
+ClipStore::ErrorCode ClipStore::end() {
+    if (!writing) return ErrorCode::NOT_WRITING;
+    if (write_cursor != write_size) return ErrorCode::INCOMPLETE;
+    writing = false;
+
+    const uintptr_t base = slotBase(write_slot);
+    bool ok = true;
+
+    HAL_FLASH_Unlock();
+    // 剩下的奇数字节，高字节补 0xFF (擦除后的值)
+    if (write_size & 1) {
+        const uintptr_t address = base + sizeof(Header) + write_size - 1;
+        ok = ensureErased(address) && programHalfWord(address, static_cast<uint16_t>(pending_byte | 0xFF00));
+    }
+
+    // 最后写 Header
+    const Header header{MAGIC, write_info.format, 0xFF, write_info.palette_count, write_info.frame_count,
+                        write_info.frame_period_ms, write_size};
+    uint16_t words[sizeof(Header) / 2];
+    std::memcpy(words, &header, sizeof(Header));
+    for (size_t i = 0; ok && i < std::size(words); ++i) {
+        ok = programHalfWord(base + i * 2, words[i]);
+    }
+    HAL_FLASH_Lock();
+
+    return ok ? ErrorCode::NONE : ErrorCode::FLASH_ERROR;
+}
+
+std::optional<ClipStore::Clip> ClipStore::clip(const uint8_t slot) const {
+    if (slot >= SLOT_COUNT) return std::nullopt;
+    if (writing && slot == write_slot) return std::nullopt; // 正在改写
+
+    const auto *base = reinterpret_cast<const uint8_t *>(slotBase(slot));
+    Header header;
+    std::memcpy(&header, base, sizeof(Header));
+
+    if (header.magic != MAGIC || header.format >= Format::COUNT) return std::nullopt;
+
+    const ClipInfo info{header.format, header.palette_count, header.frame_count, header.frame_period_ms};
+    if (header.data_size != dataSize(info) || sizeof(Header) + header.data_size > slotSize()) return std::nullopt;
+
+    const uint8_t *palette = base + sizeof(Header);
+    return Clip{info, palette, palette + info.palette_count * 3};
+}
+
+bool ClipStore::ensureErased(const uintptr_t address) {
+    if (address < erased_until) return true;
+
+    // 数据按顺序写入，只需擦除 address 所在的页
+    const uintptr_t page = address - (address - reinterpret_cast<uintptr_t>(_sclips)) % PAGE_SIZE;
+    FLASH_EraseInitTypeDef erase{};
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.Banks = FLASH_BANK_1;
+    erase.PageAddress = page;
+    erase.NbPages = 1;
+
+    uint32_t page_error = 0;
+    if (HAL_FLASHEx_Erase(&erase, &page_error) != HAL_OK) return false;
+
+    erased_until = page + PAGE_SIZE;
+    return true;
+}
+
+bool ClipStore::programHalfWord(const uintptr_t address, const uint16_t value) {
+    return HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, address, value) == HAL_OK;
+}
@@ -0,0 +1,47 @@
+#include "coroutine.hpp"
+
+#include <bit>
+
+namespace Coro {
+    // --- FramePool ---
+    void *FramePool::allocate(const size_t size) noexcept {
+        if (size > SLOT_SIZE) return nullptr;
+
+        const uint32_t free_mask = ~used_mask & ((1u << SLOT_COUNT) - 1);
+        if (free_mask == 0) return nullptr;
+
+        const auto slot = std::countr_zero(free_mask);
+        used_mask |= 1u << slot;
+        return slots[slot].data();
+    }
+
+    void FramePool::release(void *frame) noexcept {
+        for (size_t slot = 0; slot < SLOT_COUNT; ++slot) {
+            if (slots[slot].data() == frame) {
+                used_mask &= ~(1u << slot);
+                handles[slot] = nullptr;
+                return;
+            }
+        }
+    }
+
+    // --- Task ---
+    Task &Task::operator=(Task &&other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = other.handle;
+            other.handle = nullptr;
+        }
+        return *this;
+    }
+
+    Task::~Task() {
+        if (handle) handle.destroy();
+    }
+
+    void Task::start() const {
+        if (handle && !handle.done()) handle.resume();
+    }
+
+    bool Task::done() const { return !handle || handle.done(); }
+} // namespace Coro
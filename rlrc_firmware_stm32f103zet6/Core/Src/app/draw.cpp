@@ -0,0 +1,148 @@
+#include "draw.hpp"
+
+#include <array>
+
+namespace {
+    using Color::Rgb;
+
+    void plot(WS2812B &fb, const int32_t x, const int32_t y, const Rgb c) {
+        if (x < 0 || y < 0 || x >= WS2812B::WIDTH || y >= WS2812B::HEIGHT) return;
+        fb.setPixel(static_cast<uint8_t>(x), static_cast<uint8_t>(y), c.r, c.g, c.b);
+    }
+
+    // 按 t (0-256) 在两种颜色之间插值
+    Rgb mix(const Rgb from, const Rgb to, const int32_t t) {
+        const auto channel = [t](const uint8_t a, const uint8_t b) {
+            return static_cast<uint8_t>(a + (((b - a) * t) >> 8));
+        };
+        return {channel(from.r, to.r), channel(from.g, to.g), channel(from.b, to.b)};
+    }
+
+    // 整数平方根 (向下取整)
+    uint32_t isqrt(uint32_t value) {
+        uint32_t result = 0;
+        uint32_t bit = 1u << 30;
+        while (bit > value) bit >>= 2;
+        while (bit != 0) {
+            if (value >= result + bit) {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return result;
+    }
+
+    // 取模结果落在 [0, n)
+    int32_t wrapIndex(const int32_t value, const int32_t n) {
+        const int32_t r = value % n;
+        return r < 0 ? r + n : r;
+    }
+} // namespace
+
+namespace Draw {
+    void fillRect(WS2812B &fb, const int16_t x, const int16_t y, const uint16_t w, const uint16_t h, const Rgb color) {
+        // 先裁剪到点阵范围，循环内不再判断
+        const int32_t left = x < 0 ? 0 : x;
+        const int32_t top = y < 0 ? 0 : y;
+        const int32_t right = x + w < WS2812B::WIDTH ? x + w : WS2812B::WIDTH;
+        const int32_t bottom = y + h < WS2812B::HEIGHT ? y + h : WS2812B::HEIGHT;
+
+        for (int32_t py = top; py < bottom; ++py) {
+            for (int32_t px = left; px < right; ++px) {
+                fb.setPixel(static_cast<uint8_t>(px), static_cast<uint8_t>(py), color.r, color.g, color.b);
+            }
+        }
+    }
+
+    void line(WS2812B &fb, int16_t x0, int16_t y0, const int16_t x1, const int16_t y1, const Rgb color) {
+        // 通用 Bresenham：误差项同时累计 x、y 两个方向，适用于所有斜率
+        const int32_t dx = x1 > x0 ? x1 - x0 : x0 - x1;
+        const int32_t dy = -(y1 > y0 ? y1 - y0 : y0 - y1);
+        const int32_t sx = x0 < x1 ? 1 : -1;
+        const int32_t sy = y0 < y1 ? 1 : -1;
+        int32_t error = dx + dy;
+
+        while (true) {
+            plot(fb, x0, y0, color);
+            if (x0 == x1 && y0 == y1) break;
+
+            const int32_t e2 = 2 * error;
+            if (e2 >= dy) {
+                error += dy;
+                x0 = static_cast<int16_t>(x0 + sx);
+            }
+            if (e2 <= dx) {
+                error += dx;
+                y0 = static_cast<int16_t>(y0 + sy);
+            }
+        }
+    }
+
+    void linearGradient(WS2812B &fb, const int16_t x0, const int16_t y0, const int16_t x1, const int16_t y1,
+                        const Rgb from, const Rgb to) {
+        // t = (p - p0)·d / |d|^2，预先算好 256 * 2^38 / |d|^2，逐像素只需乘法和移位
+        // 坐标为 int16 时 |d|^2 与投影都超出 32 位，按 64 位计算；
+        // 乘积不超过 2^46 * |p - p0| / |d| < 2^62，倒数至少 2^11，端点相距很远时 t 仍然精确到 1/256；
+        // 倒数向上取整，t 恰好为整数时不会因截断少 1
+        const int64_t dx = x1 - x0;
+        const int64_t dy = y1 - y0;
+        const int64_t length2 = dx * dx + dy * dy;
+        const int64_t inverse = length2 != 0 ? ((int64_t{256} << 38) + length2 - 1) / length2 : 0;
+
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+            for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) {
+                const int64_t projection = (x - x0) * dx + (y - y0) * dy;
+                int64_t t = (projection * inverse) >> 38;
+                t = t < 0 ? 0 : (t > 256 ? 256 : t);
+                plot(fb, x, y, mix(from, to, static_cast<int32_t>(t)));
+            }
+        }
+    }
+
+    void radialGradient(WS2812B &fb, const int16_t cx, const int16_t cy, const uint16_t radius, const Rgb from,
+                        const Rgb to) {
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+            for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) {
+                int32_t t = 256;
+                if (radius != 0) {
+                    // 坐标为 int16 时 dist^2 最大约 2^31.1，两项之和按无符号 32 位计算
+                    const int32_t dx = x - cx;
+                    const int32_t dy = y - cy;
+                    const uint32_t dist2 = static_cast<uint32_t>(dx * dx) + static_cast<uint32_t>(dy * dy);
+                    // 距离放大 128 倍：近处先放大再开方保留小数，远处先开方再放大，误差不到 1/512
+                    const uint32_t dist128 = dist2 < (1u << 18) ? isqrt(dist2 << 14) : isqrt(dist2) << 7;
+                    const uint32_t scaled = dist128 * 2 / radius; // dist * 256 / radius
+                    t = scaled > 256 ? 256 : static_cast<int32_t>(scaled);
+                }
+                plot(fb, x, y, mix(from, to, t));
+            }
+        }
+    }
+
+    void shift(WS2812B &fb, const int16_t dx, const int16_t dy, const bool wrap) {
+        // 先把整帧读出来，避免边读边写时覆盖还没移动的像素
+        std::array<std::array<uint8_t, 3>, WS2812B::LED_COUNT> copy;
+        for (uint16_t i = 0; i < WS2812B::LED_COUNT; ++i) {
+            copy[i] = fb.getPixel(i % WS2812B::WIDTH, i / WS2812B::WIDTH);
+        }
+
+        for (int32_t y = 0; y < WS2812B::HEIGHT; ++y) {
+            for (int32_t x = 0; x < WS2812B::WIDTH; ++x) {
+                int32_t sx = x - dx;
+                int32_t sy = y - dy;
+                if (wrap) {
+                    sx = wrapIndex(sx, WS2812B::WIDTH);
+                    sy = wrapIndex(sy, WS2812B::HEIGHT);
+                } else if (sx < 0 || sy < 0 || sx >= WS2812B::WIDTH || sy >= WS2812B::HEIGHT) {
+                    fb.setPixel(static_cast<uint8_t>(x), static_cast<uint8_t>(y), 0, 0, 0);
+                    continue;
+                }
+                const auto &c = copy[sy * WS2812B::WIDTH + sx];
+                fb.setPixel(static_cast<uint8_t>(x), static_cast<uint8_t>(y), c[0], c[1], c[2]);
+            }
+        }
+    }
+} // namespace Draw
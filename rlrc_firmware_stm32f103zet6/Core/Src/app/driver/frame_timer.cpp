@@ -0,0 +1,80 @@
+#include "frame_timer.hpp"
+
+#include "cycle_counter.hpp"
+
+extern "C" {
+TIM_HandleTypeDef htim2;
+}
+
+FrameTimer &FrameTimer::getInstance() {
+    static FrameTimer instance;
+    return instance;
+}
+
+void FrameTimer::init(uint16_t fps) {
+    CycleCounter::init();
+    fps = clampFps(fps);
+
+    // TIM2 挂在 APB1 (36MHz)，APB1 分频不为 1 时定时器时钟翻倍，为 72MHz
+    __HAL_RCC_TIM2_CLK_ENABLE();
+
+    htim2.Instance = TIM2;
+    htim2.Init.Prescaler = SystemCoreClock / COUNTER_HZ - 1;
+    htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim2.Init.Period = COUNTER_HZ / fps - 1;
+    htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    HAL_TIM_Base_Init(&htim2);
+    this->fps = fps;
+
+    // 节拍优先级低于 WS2812B 的 DMA 与串口，不打断码元输出和接收
+    HAL_NVIC_SetPriority(TIM2_IRQn, 1, 0);
+    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+
+    HAL_TIM_Base_Start_IT(&htim2);
+}
+
+void FrameTimer::setFps(uint16_t fps) {
+    fps = clampFps(fps);
+
+    this->fps = fps;
+    // 开启了 ARR 预装载，新周期在下一次更新事件时生效，不会打乱当前这一帧
+    __HAL_TIM_SET_AUTORELOAD(&htim2, COUNTER_HZ / fps - 1);
+}
+
+uint16_t FrameTimer::getFps() const { return fps; }
+
+uint16_t FrameTimer::clampFps(const uint16_t fps) {
+    if (fps == 0) return 1;
+    if (fps > COUNTER_HZ) return COUNTER_HZ;
+    return fps;
+}
+
+bool FrameTimer::tickPending() const { return pending_ticks.load() != 0; }
+
+bool FrameTimer::takeTick() {
+    const uint32_t ticks = pending_ticks.exchange(0);
+    if (ticks == 0) return false;
+
+    // 帧起始抖动：节拍中断到主循环开始处理这一帧之间的延迟
+    const uint32_t latency = CycleCounter::now() - last_tick_cycles.load();
+    stats.frames++;
+    stats.total_cycles += latency;
+    if (latency < stats.min_cycles) stats.min_cycles = latency;
+    if (latency > stats.max_cycles) stats.max_cycles = latency;
+    if (ticks > 1) stats.overruns += ticks - 1; // 多出来的节拍被合并，相当于丢帧
+
+    return true;
+}
+
+FrameTimer::JitterStats FrameTimer::takeStats() {
+    const JitterStats result = stats;
+    stats = {};
+    return result;
+}
+
+// 中断上下文
+void FrameTimer::on_tick() {
+    last_tick_cycles.store(CycleCounter::now());
+    pending_ticks.fetch_add(1);
+}
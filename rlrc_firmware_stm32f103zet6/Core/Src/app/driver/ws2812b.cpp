@@ -1,90 +1,247 @@
 #include "ws2812b.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cstring>
 
-WS2812B & WS2812B::getInstance() {
-    static WS2812B instance;
+template<LedChipTraits Chip>
+LedStrip<Chip> &LedStrip<Chip>::getInstance() {
+    static LedStrip instance;
     return instance;
 }
 
-void WS2812B::setPixel(const uint8_t x, const uint8_t y, const uint8_t r, const uint8_t g, const uint8_t b) {
-    if (x >= 5 || y >= 5) {  // 边界检查
+template<LedChipTraits Chip>
+void LedStrip<Chip>::setPixel(const uint8_t x, const uint8_t y, const uint8_t r, const uint8_t g, const uint8_t b) {
+    if (x >= WIDTH || y >= HEIGHT) {  // 边界检查
         last_error.store(ErrorCode::INVALID_COORDS);
         return;
     }
 
     // 将 2D 坐标 (x,y) 转换为 1D 索引
     // Z 形布线 (从 0,0 到 4,4)
-    const uint16_t index = y * 5 + x;
+    const uint16_t index = y * WIDTH + x;
 
-    led_data[index][0] = r;
-    led_data[index][1] = g;
-    led_data[index][2] = b;
+    const std::array<uint8_t, 3> color{r, g, b};
+    if (led_data[index] == color) return; // 颜色未变化，不置脏
+
+    led_data[index] = color;
+    markDirty(index);
+}
+
+template<LedChipTraits Chip>
+std::array<uint8_t, 3> LedStrip<Chip>::getPixel(const uint8_t x, const uint8_t y) const {
+    if (x >= WIDTH || y >= HEIGHT) return {};
+    return led_data[y * WIDTH + x];
 }
 
-void WS2812B::clear() { led_data = {}; }
+template<LedChipTraits Chip>
+void LedStrip<Chip>::clear() { setAll(0, 0, 0); }
 
-void WS2812B::setAll(uint8_t r, uint8_t g, uint8_t b) {
+template<LedChipTraits Chip>
+void LedStrip<Chip>::setAll(uint8_t r, uint8_t g, uint8_t b) {
+    const std::array<uint8_t, 3> color{r, g, b};
     for (uint16_t i = 0; i < LED_COUNT; ++i) {
-        led_data[i][0] = r;
-        led_data[i][1] = g;
-        led_data[i][2] = b;
+        if (led_data[i] == color) continue;
+        led_data[i] = color;
+        markDirty(i);
     }
 }
 
 // TODO：在这里负责将一维数据转换成二维有点奇怪，后面考虑怎么优化
-void WS2812B::setFrame(std::span<const uint8_t> frameData) {
+template<LedChipTraits Chip>
+void LedStrip<Chip>::setFrame(std::span<const uint8_t> frameData) {
     // 数据长度是否符合预期 (LED 数量 * 3)
     if (frameData.size() != LED_COUNT * 3) {
         last_error.store(ErrorCode::INVALID_FRAME_SIZE);
         return;
     }
 
-    // 拷贝到新数组
-    uint8_t* dest_ptr = &led_data[0][0];
-    std::copy(frameData.begin(), frameData.end(), dest_ptr);
+    // 逐灯比较后拷贝，只有颜色变化的灯珠才会被标脏
+    for (uint16_t i = 0; i < LED_COUNT; ++i) {
+        const auto src = frameData.subspan(i * 3, 3);
+        if (std::equal(src.begin(), src.end(), led_data[i].begin())) continue;
+
+        std::copy(src.begin(), src.end(), led_data[i].begin());
+        markDirty(i);
+    }
+}
+
+template<LedChipTraits Chip>
+void LedStrip<Chip>::setBrightness(const uint8_t value) {
+    if (value == brightness) return;
+
+    brightness = value;
+    markAllDirty(); // 亮度作用于每一颗灯珠
 }
 
-void WS2812B::render() {
+template<LedChipTraits Chip>
+uint8_t LedStrip<Chip>::getBrightness() const { return brightness; }
+
+template<LedChipTraits Chip>
+void LedStrip<Chip>::setDithering(const bool enable) {
+    if (enable == dithering) return;
+
+    dithering = enable;
+    dither_error = {};
+    dither_leds = {};
+    markAllDirty(); // 按新的量化方式重新编码
+}
+
+template<LedChipTraits Chip>
+bool LedStrip<Chip>::isDithering() const { return dithering; }
+
+template<LedChipTraits Chip>
+void LedStrip<Chip>::setPowerBudget(const uint16_t milliamps) {
+    power_budget = milliamps;
+    frame_dirty = true; // 下一次 render() 按新预算重新评估限流
+}
+
+template<LedChipTraits Chip>
+uint16_t LedStrip<Chip>::getPowerBudget() const { return power_budget; }
+
+template<LedChipTraits Chip>
+uint32_t LedStrip<Chip>::getEstimatedCurrent() const {
+    return power_sum * MA_PER_CHANNEL / 255 + LED_COUNT * IDLE_MA_PER_LED;
+}
+
+template<LedChipTraits Chip>
+uint8_t LedStrip<Chip>::getPowerLimit() const { return power_limit; }
+
+template<LedChipTraits Chip>
+void LedStrip<Chip>::setTransition(const Transition type, const uint16_t duration_ms, const bool frames) {
+    transition = type;
+    transition_ms = duration_ms;
+    transition_frames = frames;
+}
+
+template<LedChipTraits Chip>
+typename LedStrip<Chip>::Transition LedStrip<Chip>::getTransition() const { return transition; }
+
+template<LedChipTraits Chip>
+uint16_t LedStrip<Chip>::getTransitionDuration() const { return transition_ms; }
+
+template<LedChipTraits Chip>
+bool LedStrip<Chip>::getTransitionFrames() const { return transition_frames; }
+
+template<LedChipTraits Chip>
+void LedStrip<Chip>::beginTransition() {
+    if (transition == Transition::NONE || transition_ms == 0) {
+        if (transitioning) { // 中止正在进行的过渡，直接显示新画面
+            transitioning = false;
+            markAllDirty();
+        }
+        return;
+    }
+
+    // 记下当前显示的画面 (过渡中则是混合后的画面)
+    for (uint16_t i = 0; i < LED_COUNT; ++i) {
+        prev_data[i] = transitioning ? blendedColor(i) : led_data[i];
+    }
+
+    if (transition == Transition::DISSOLVE) {
+        // xorshift32 伪随机序列，每次过渡的溶解顺序都不同
+        for (auto &order: dissolve_order) {
+            dissolve_seed ^= dissolve_seed << 13;
+            dissolve_seed ^= dissolve_seed >> 17;
+            dissolve_seed ^= dissolve_seed << 5;
+            order = static_cast<uint8_t>(dissolve_seed >> 24);
+        }
+    }
+
+    transitioning = true;
+    transition_start = HAL_GetTick();
+    transition_progress = 0;
+    markAllDirty();
+}
+
+template<LedChipTraits Chip>
+bool LedStrip<Chip>::isTransitioning() const { return transitioning; }
+
+template<LedChipTraits Chip>
+void LedStrip<Chip>::updateTransition() {
+    const uint32_t elapsed = HAL_GetTick() - transition_start;
+    if (elapsed >= transition_ms) {
+        transitioning = false; // 最后一帧按新画面完整编码一遍
+    } else {
+        transition_progress = static_cast<uint16_t>(elapsed * 256 / transition_ms);
+    }
+    markAllDirty();
+}
+
+template<LedChipTraits Chip>
+uint16_t LedStrip<Chip>::transitionAlpha(const uint16_t led_index) const {
+    const int32_t p = transition_progress;
+    int32_t alpha = 256;
+    switch (transition) {
+        case Transition::FADE:
+            alpha = p;
+            break;
+        case Transition::WIPE:
+            // 擦除边缘从第 0 列左侧移动到最后一列右侧，共 WIDTH + 1 列的行程
+            alpha = p * (WIDTH + 1) - (led_index % WIDTH) * 256;
+            break;
+        case Transition::DISSOLVE:
+            // 每颗灯珠在 order * 3/4 的进度开始淡入，用 1/4 的时长完成
+            alpha = p * 4 - dissolve_order[led_index] * 3;
+            break;
+        case Transition::NONE:
+        case Transition::COUNT:
+            break;
+    }
+    return static_cast<uint16_t>(std::clamp<int32_t>(alpha, 0, 256));
+}
+
+template<LedChipTraits Chip>
+std::array<uint8_t, 3> LedStrip<Chip>::blendedColor(const uint16_t led_index) const {
+    const int32_t alpha = transitionAlpha(led_index);
+    std::array<uint8_t, 3> color{};
+    for (uint8_t ch = 0; ch < 3; ++ch) {
+        const int32_t from = prev_data[led_index][ch];
+        const int32_t to = led_data[led_index][ch];
+        color[ch] = static_cast<uint8_t>(from + (((to - from) * alpha) >> 8));
+    }
+    return color;
+}
+
+template<LedChipTraits Chip>
+void LedStrip<Chip>::render(const bool force) {
+    // 过渡期间画面随时间变化，每一帧都要重新编码
+    if (transitioning) updateTransition();
+
+    // 帧内容自上次发送后没有变化，也没有灯珠在抖动，跳过重复的编码与传输
+    if (!force && !frame_dirty && !(dithering && hasDitherLeds())) {
+        skipped_renders++;
+        return;
+    }
+
     // 检查上一次 DMA 传输是否已完成
     if (!dma_transfer_complete_flag) {
         last_error.store(ErrorCode::RENDER_BUSY);
-        return; // 上次传输还未结束，退出以防数据错乱
+        return; // 上次传输还未结束，退出以防数据错乱 (保留脏标记，下次再发)
     }
-    dma_transfer_complete_flag = false; // 标记为 "正在传输"
 
-    uint16_t buffer_index = 0;
-
-    // 将 RGB 转换为 PWM
-    for (uint16_t led_i = 0; led_i < LED_COUNT; ++led_i) {
-        // WS2812B 的数据顺序是 GRB，不是 RGB
-        const uint8_t r = led_data[led_i][0];
-        const uint8_t g = led_data[led_i][1];
-        const uint8_t b = led_data[led_i][2];
-
-        // 颜色数组，按 GRB 顺序
-        uint8_t ws_colors_gbr[] = {g, r, b};
-
-        // 遍历 G, R, B 三种颜色
-        for (const uint8_t color: ws_colors_gbr) {
-            // 遍历一个颜色的 8 个 bit (从 MSB 到 LSB)
-            for (int8_t bit = 7; bit >= 0; --bit) {
-                if ((color >> bit) & 1) {
-                    // "1" 码
-                    pwm_buffer[buffer_index] = PWM_HIGH_VAL;
-                } else {
-                    // "0" 码
-                    pwm_buffer[buffer_index] = PWM_LOW_VAL;
-                }
-                buffer_index++;
-            }
-        }
+    // 编码的同时统计功耗；超出预算时压低限流系数，并在发送前把整帧重新编码一遍
+    const uint32_t old_scale = channelScale();
+    const auto encoded = pendingLeds();
+    if (encodeDirtyLeds()) pwm_pending = true;
+    if (updatePowerLimit()) {
+        // 第一遍已经按旧系数推进了抖动误差，先退回，本帧只按新系数推进一次
+        if (dithering) rewindDither(encoded, old_scale);
+        if (encodeDirtyLeds()) pwm_pending = true;
     }
+    frame_dirty = false;
 
-    // 填充reset信号 - 确保所有reset脉冲都是0
-    for (uint16_t i = buffer_index; i < PWM_BUFFER_SIZE; ++i) {
-        pwm_buffer[i] = 0;
+    // 只有抖动灯珠被重新编码，且没有任何码元变化：与上一次发送的内容相同，不必重发
+    if (!force && !pwm_pending) {
+        skipped_renders++;
+        return;
     }
+    dma_transfer_complete_flag = false; // 标记为 "正在传输"
+
+    // reset 区 (pwm_buffer 末尾 RESET_PULSES 个码元) 从未被写入，始终为 0
+
+    // 码元周期由芯片决定 (CubeMX 中按 WS2812B 配置为 90 ticks)
+    __HAL_TIM_SET_AUTORELOAD(&htim1, PWM_PERIOD_TICKS - 1);
 
     // 启动 DMA 传输
     const HAL_StatusTypeDef status = HAL_TIM_PWM_Start_DMA(
@@ -97,18 +254,206 @@ void WS2812B::render() {
     if (status != HAL_OK) {
         last_error.store(ErrorCode::HAL_START_FAILED);
         dma_transfer_complete_flag = true;
+        frame_dirty = true; // 本帧未发出，下次 render() 重发 (pwm_pending 保持为 true)
+        return;
+    }
+    pwm_pending = false;
+}
+
+template<LedChipTraits Chip>
+std::array<uint32_t, LedStrip<Chip>::DIRTY_WORDS> LedStrip<Chip>::pendingLeds() const {
+    std::array<uint32_t, DIRTY_WORDS> leds = dirty_leds;
+    if (dithering) {
+        for (uint16_t word = 0; word < DIRTY_WORDS; ++word) leds[word] |= dither_leds[word];
     }
+    return leds;
+}
+
+template<LedChipTraits Chip>
+bool LedStrip<Chip>::hasDitherLeds() const {
+    return std::any_of(dither_leds.begin(), dither_leds.end(), [](const uint32_t word) { return word != 0; });
 }
 
+template<LedChipTraits Chip>
+bool LedStrip<Chip>::encodeDirtyLeds() {
+    // 只重新编码自上次 render() 以来颜色变化过的灯珠，以及正在抖动的灯珠
+    // 其余灯珠在 pwm_buffer 中的码元保持不变，稀疏更新的代价为 O(变化像素数)
+    const auto pending = pendingLeds();
+    dirty_leds = {};
+
+    bool changed = false;
+    for (uint16_t word = 0; word < DIRTY_WORDS; ++word) {
+        uint32_t bits = pending[word];
+        while (bits != 0) {
+            const auto led_i = static_cast<uint16_t>(word * 32 + std::countr_zero(bits));
+            bits &= bits - 1; // 清除最低位的 1
+            if (led_i < LED_COUNT) changed |= encodeLed(led_i);
+        }
+    }
+    return changed;
+}
+
+template<LedChipTraits Chip>
+void LedStrip<Chip>::rewindDither(const std::array<uint32_t, DIRTY_WORDS> &leds, const uint32_t old_scale) {
+    // 编码时 error' = (v16 + error) & 0xFF，因此 error = (error' - v16) & 0xFF
+    for (uint16_t word = 0; word < DIRTY_WORDS; ++word) {
+        uint32_t bits = leds[word];
+        while (bits != 0) {
+            const auto led_i = static_cast<uint16_t>(word * 32 + std::countr_zero(bits));
+            bits &= bits - 1;
+            if (led_i >= LED_COUNT) continue;
+
+            const auto input = channelInput(led_i);
+            for (uint8_t ch = 0; ch < CHANNEL_COUNT; ++ch) {
+                const auto v16 = static_cast<uint16_t>(((*GAMMA_LUTS[ch])[input[ch]] * old_scale) >> 8);
+                dither_error[led_i][ch] = static_cast<uint8_t>(dither_error[led_i][ch] - v16);
+            }
+        }
+    }
+}
+
+template<LedChipTraits Chip>
+bool LedStrip<Chip>::updatePowerLimit() {
+    if (power_budget == 0) { // 不限流
+        if (power_limit == 255) return false;
+        power_limit = 255;
+        markAllDirty();
+        return true;
+    }
+
+    // 静态电流不受亮度影响，只有通道电流可以被压缩
+    constexpr uint32_t idle_ma = LED_COUNT * IDLE_MA_PER_LED;
+    const uint32_t channel_ma = getEstimatedCurrent() - idle_ma;
+    const uint32_t channel_budget = power_budget > idle_ma ? power_budget - idle_ma : 0;
+
+    // 电流与限流系数近似成正比：按比例推算出恰好满足预算的系数
+    uint32_t target = 255;
+    if (channel_ma > 0) {
+        target = (power_limit + 1) * channel_budget / channel_ma;
+        target = target > 0 ? target - 1 : 0;
+        if (target > 255) target = 255;
+    }
+
+    const bool over_budget = channel_ma > channel_budget;
+    const bool can_relax = target > static_cast<uint32_t>(power_limit + POWER_LIMIT_HYSTERESIS) ||
+                           (target == 255 && power_limit != 255);
+    if (!over_budget && !can_relax) return false;
+    if (target == power_limit) return false;
+
+    power_limit = static_cast<uint8_t>(target);
+    markAllDirty(); // 限流系数作用于每一颗灯珠
+    return true;
+}
+
+template<LedChipTraits Chip>
+void LedStrip<Chip>::markDirty(const uint16_t led_index) {
+    dirty_leds[led_index / 32] |= 1u << (led_index % 32);
+    frame_dirty = true;
+}
+
+template<LedChipTraits Chip>
+void LedStrip<Chip>::markAllDirty() {
+    dirty_leds.fill(0xFFFFFFFF);
+    frame_dirty = true;
+}
+
+template<LedChipTraits Chip>
+uint32_t LedStrip<Chip>::channelScale() const {
+    // value * (k + 1) >> 8，k = 255 时保持原值
+    return ((brightness + 1) * (power_limit + 1)) >> 8;
+}
+
+template<LedChipTraits Chip>
+std::array<uint8_t, 4> LedStrip<Chip>::channelInput(const uint16_t led_index) const {
+    const auto rgb = transitioning ? blendedColor(led_index) : led_data[led_index];
+    std::array<uint8_t, 4> input{rgb[0], rgb[1], rgb[2], 0};
+    if constexpr (HAS_WHITE) {
+        // RGBW 芯片：RGB 的公共部分交给独立的白色 LED，显色更纯、功耗更低
+        const uint8_t white = std::min({input[LedChip::R], input[LedChip::G], input[LedChip::B]});
+        input[LedChip::R] -= white;
+        input[LedChip::G] -= white;
+        input[LedChip::B] -= white;
+        input[LedChip::W] = white;
+    }
+    return input;
+}
+
+template<LedChipTraits Chip>
+bool LedStrip<Chip>::encodeLed(const uint16_t led_index) {
+    uint16_t buffer_index = led_index * BITS_PER_LED;
+
+    // 先查 gamma 表 (8.8 定点)，再乘以亮度与限流系数
+    const uint32_t scale = channelScale();
+    bool fractional = false;
+    auto correct = [&](const std::array<uint16_t, 256> &lut, const uint8_t value, uint8_t &error) -> uint8_t {
+        const auto v16 = static_cast<uint16_t>((lut[value] * scale) >> 8);
+        if (!dithering) return static_cast<uint8_t>((v16 + 0x80) >> 8); // 四舍五入到 8 bit
+
+        // 时间抖动：把上一帧没能输出的小数部分累加进来，溢出到整数部分时本帧多亮一级
+        // v16 最大 255 << 8，加上 8 位误差不会溢出
+        const auto acc = static_cast<uint16_t>(v16 + error);
+        error = static_cast<uint8_t>(acc & 0xFF);
+        fractional |= (v16 & 0xFF) != 0;
+        return static_cast<uint8_t>(acc >> 8);
+    };
+
+    const auto input = channelInput(led_index);
+    auto &error = dither_error[led_index];
+    std::array<uint8_t, 4> output{};
+    uint16_t led_sum = 0;
+    for (uint8_t ch = 0; ch < CHANNEL_COUNT; ++ch) {
+        output[ch] = correct(*GAMMA_LUTS[ch], input[ch], error[ch]);
+        led_sum += output[ch];
+    }
+
+    // 增量更新整帧功耗统计
+    power_sum -= led_power[led_index];
+    led_power[led_index] = led_sum;
+    power_sum += led_power[led_index];
+
+    // 记录该灯珠是否需要在后续刷新中继续抖动
+    const uint32_t mask = 1u << (led_index % 32);
+    if (fractional)
+        dither_leds[led_index / 32] |= mask;
+    else
+        dither_leds[led_index / 32] &= ~mask;
+
+    // 按芯片的通道顺序发送 (WS2812B 是 GRB，不是 RGB)
+    // 通道顺序和数量都是编译期常量，循环会针对具体芯片展开
+    bool changed = false;
+    for (const LedChip::Channel ch: Chip::CHANNEL_ORDER) {
+        const uint8_t color = output[ch];
+        // 遍历一个颜色的 8 个 bit (从 MSB 到 LSB)
+        for (int8_t bit = 7; bit >= 0; --bit) {
+            // "1" 码 / "0" 码
+            const uint16_t pulse = ((color >> bit) & 1) ? PWM_HIGH_VAL : PWM_LOW_VAL;
+            changed |= pwm_buffer[buffer_index] != pulse;
+            pwm_buffer[buffer_index++] = pulse;
+        }
+    }
+    return changed;
+}
+
+template<LedChipTraits Chip>
+bool LedStrip<Chip>::isBusy() const { return !dma_transfer_complete_flag; }
+
 // 公共回调函数
-void WS2812B::on_dma_transfer_complete() {
+template<LedChipTraits Chip>
+void LedStrip<Chip>::on_dma_transfer_complete() {
     // 设置标志，允许下一次 render()
     dma_transfer_complete_flag = true;
 }
 
-WS2812B::ErrorCode WS2812B::getLastError() {
+template<LedChipTraits Chip>
+typename LedStrip<Chip>::ErrorCode LedStrip<Chip>::getLastError() {
     return last_error.exchange(ErrorCode::NONE);
     // .exchange() 是一个原子操作
     // 1. 返回 last_error 当前的值
     // 2. 将 last_error 设为 ErrorCode::NONE
 }
+
+template<LedChipTraits Chip>
+uint32_t LedStrip<Chip>::getSkippedRenderCount() const { return skipped_renders; }
+
+// 成员函数定义在本文件中，只为实际使用的芯片实例化
+template class LedStrip<ActiveLedChip>;
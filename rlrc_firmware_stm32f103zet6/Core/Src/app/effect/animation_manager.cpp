@@ -0,0 +1,99 @@
+#include "animation_manager.hpp"
+
+#include "canvas_effect.hpp"
+#include "clip_effect.hpp"
+#include "cloud_effect.hpp"
+#include "cycle_counter.hpp"
+#include "diffusion_effect.hpp"
+#include "fire_effect.hpp"
+#include "keyframe_effect.hpp"
+#include "life_effect.hpp"
+#include "page_effect.hpp"
+#include "plasma_effect.hpp"
+#include "text_effect.hpp"
+#include "vm_effect.hpp"
+
+// --- 效果实例 ---
+static CanvasEffect canvasEffect;
+static DiffusionEffect diffusionEffect;
+static PlasmaEffect plasmaEffect;
+static CloudEffect cloudEffect;
+static LifeEffect lifeEffect;
+static FireEffect fireEffect;
+
+AnimationManager &AnimationManager::getInstance() {
+    static AnimationManager instance;
+    return instance;
+}
+
+AnimationManager::AnimationManager() {
+    // --- 注册表：模式 ID -> 效果 ---
+    effects[MODE_CANVAS] = &canvasEffect;
+    effects[MODE_DIFFUSION] = &diffusionEffect;
+    effects[MODE_KEYFRAME] = &KeyframeEffect::getInstance();
+    effects[MODE_PAGES] = &PageEffect::getInstance();
+    effects[MODE_CLIP] = &ClipEffect::getInstance();
+    effects[MODE_VM] = &VmEffect::getInstance();
+    effects[MODE_PLASMA] = &plasmaEffect;
+    effects[MODE_CLOUDS] = &cloudEffect;
+    effects[MODE_LIFE] = &lifeEffect;
+    effects[MODE_FIRE] = &fireEffect;
+    effects[MODE_TEXT] = &TextEffect::getInstance();
+}
+
+bool AnimationManager::setMode(const uint8_t mode) {
+    if (mode >= MAX_EFFECTS || effects[mode] == nullptr) return false;
+
+    active_mode = mode;
+    entered = false; // 下一次 update() 时进入，保证 enter() 与 update() 在同一上下文
+    return true;
+}
+
+uint8_t AnimationManager::getMode() const { return active_mode; }
+
+bool AnimationManager::setParams(const uint8_t mode, const uint8_t offset, const std::span<const uint8_t> values) {
+    if (mode >= MAX_EFFECTS || effects[mode] == nullptr) return false;
+    return effects[mode]->setParams(offset, values);
+}
+
+void AnimationManager::update(const uint32_t now) {
+    Effect &effect = *effects[active_mode];
+    auto &fb = WS2812B::getInstance();
+
+    if (!entered) {
+        effect.enter(fb);
+        entered = true;
+        next_frame_time = now;
+    }
+
+    // 帧周期未到
+    if (static_cast<int32_t>(now - next_frame_time) < 0) return;
+
+    // 落后一个周期以上 (例如被长任务阻塞) 时不追帧，从现在重新计时
+    const uint16_t period = effect.framePeriod();
+    next_frame_time = (now - next_frame_time >= period) ? now + period : next_frame_time + period;
+
+    const uint32_t start = CycleCounter::now();
+    effect.update(now, fb);
+    const uint32_t elapsed = CycleCounter::now() - start;
+
+    auto &s = stats[active_mode];
+    s.frames++;
+    s.total_cycles += elapsed;
+    if (elapsed > s.max_cycles) s.max_cycles = elapsed;
+    if (frame_budget != 0 && elapsed > frame_budget) s.overruns++;
+}
+
+void AnimationManager::setFrameBudget(const uint32_t cycles) { frame_budget = cycles; }
+
+const Effect *AnimationManager::effect(const uint8_t mode) const {
+    return mode < MAX_EFFECTS ? effects[mode] : nullptr;
+}
+
+AnimationManager::EffectStats AnimationManager::takeStats(const uint8_t mode) {
+    if (mode >= MAX_EFFECTS) return {};
+
+    const EffectStats result = stats[mode];
+    stats[mode] = {};
+    return result;
+}
@@ -0,0 +1,55 @@
+#include "clip_effect.hpp"
+
+#include "clip_store.hpp"
+
+ClipEffect &ClipEffect::getInstance() {
+    static ClipEffect instance;
+    return instance;
+}
+
+bool ClipEffect::play(const uint8_t clip_slot, const bool loop) {
+    if (!ClipStore::getInstance().clip(clip_slot)) return false;
+
+    slot = clip_slot;
+    looping = loop;
+    restart = true;
+    return true;
+}
+
+void ClipEffect::enter(WS2812B &) { restart = true; }
+
+void ClipEffect::update(const uint32_t t, WS2812B &fb) {
+    // 每次都重新读取 Header：槽位被重新上传时立即停止播放
+    const auto clip = ClipStore::getInstance().clip(slot);
+    if (!clip) return;
+
+    if (restart) {
+        restart = false;
+        start_time = t;
+        shown_frame = UINT32_MAX;
+    }
+
+    const uint16_t count = clip->info.frame_count;
+    const uint32_t period = clip->info.frame_period_ms != 0 ? clip->info.frame_period_ms : 1;
+    uint32_t index = (t - start_time) / period;
+    index = looping ? index % count : (index < count ? index : count - 1u);
+    if (index == shown_frame) return;
+    shown_frame = index;
+
+    const auto frame = clip->frame(static_cast<uint16_t>(index));
+    if (clip->info.format == ClipStore::Format::RAW) {
+        fb.setFrame(frame);
+        return;
+    }
+
+    // 调色板格式：逐灯查表，下标越界的显示为黑色
+    for (uint16_t i = 0; i < WS2812B::LED_COUNT; ++i) {
+        const uint8_t color = frame[i];
+        if (color < clip->info.palette_count) {
+            const uint8_t *rgb = clip->palette + color * 3;
+            fb.setPixel(i % WS2812B::WIDTH, i / WS2812B::WIDTH, rgb[0], rgb[1], rgb[2]);
+        } else {
+            fb.setPixel(i % WS2812B::WIDTH, i / WS2812B::WIDTH, 0, 0, 0);
+        }
+    }
+}
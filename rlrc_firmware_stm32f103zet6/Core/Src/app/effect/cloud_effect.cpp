@@ -0,0 +1,9 @@
+#include "cloud_effect.hpp"
+
+#include "shader.hpp"
+
+using CloudShader = Shader::Pipeline<Shader::Cartesian, Shader::Fbm<CloudEffect::SPEED, CloudEffect::SCALE>,
+                                     Shader::Gradient<Shader::Rgb{0, 16, 96}, Shader::Rgb{255, 255, 255}>,
+                                     Shader::Brightness<CloudEffect::BRIGHTNESS>>;
+
+void CloudEffect::update(const uint32_t t, WS2812B &fb) { CloudShader::render({t, params}, fb); }
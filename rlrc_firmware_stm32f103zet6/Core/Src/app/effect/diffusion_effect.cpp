@@ -0,0 +1,9 @@
+#include "diffusion_effect.hpp"
+
+#include "shader.hpp"
+
+// 以中心为原点的径向波纹，波峰一侧按波高点亮，波谷熄灭；色相随时间旋转
+using DiffusionShader = Shader::Pipeline<Shader::Centered, Shader::RadialWave<DiffusionEffect::WAVE_SPEED>,
+                                         Shader::HueCycle<DiffusionEffect::HUE_SPEED, DiffusionEffect::SATURATION>>;
+
+void DiffusionEffect::update(const uint32_t t, WS2812B &fb) { DiffusionShader::render({t, params}, fb); }
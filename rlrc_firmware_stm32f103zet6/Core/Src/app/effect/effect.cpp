@@ -0,0 +1,16 @@
+#include "effect.hpp"
+
+#include <algorithm>
+
+Effect::Effect(const char *name, const uint16_t frame_period_ms, const std::initializer_list<uint8_t> defaults)
+    : effect_name(name), frame_period_ms(frame_period_ms) {
+    std::copy_n(defaults.begin(), std::min(defaults.size(), params.size()), params.begin());
+}
+
+bool Effect::setParams(const uint8_t offset, const std::span<const uint8_t> values) {
+    if (offset >= MAX_PARAMS || values.size() > static_cast<size_t>(MAX_PARAMS - offset)) return false;
+
+    std::copy(values.begin(), values.end(), params.begin() + offset);
+    paramsChanged();
+    return true;
+}
@@ -0,0 +1,55 @@
+#include "fire_effect.hpp"
+
+#include "noise.hpp"
+
+namespace {
+    constexpr uint8_t addSaturate(const uint8_t a, const uint8_t b) {
+        const unsigned sum = a + b;
+        return sum > 255 ? 255 : static_cast<uint8_t>(sum);
+    }
+
+    constexpr uint8_t subSaturate(const uint8_t a, const uint8_t b) { return a > b ? a - b : 0; }
+} // namespace
+
+void FireEffect::enter(WS2812B &) {
+    for (auto &column : heat) column.fill(0);
+}
+
+uint8_t FireEffect::random8() {
+    // 16 位线性同余，高低字节相加改善低位的周期性
+    random_state = static_cast<uint16_t>(random_state * 2053u + 13849u);
+    return static_cast<uint8_t>((random_state & 0xFF) + (random_state >> 8));
+}
+
+void FireEffect::update(const uint32_t t, WS2812B &fb) {
+    constexpr uint8_t H = WS2812B::HEIGHT;
+    // 冷却量与列高成反比，不同尺寸的点阵火焰比例相近
+    const auto max_cooling = static_cast<uint8_t>(params[COOLING] * 10u / H + 2u);
+
+    // 噪声的时间轴：约 1 秒走过一个噪声格；乘积按 2^32 回绕，正好是噪声周期 (2^24) 的整数倍
+    const Fixed::q16 z = Noise::wrap(static_cast<Fixed::q16>(t * 64u));
+
+    for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) {
+        auto &column = heat[x];
+
+        // 1. 每格随机冷却
+        for (uint8_t h = 0; h < H; ++h) column[h] = subSaturate(column[h], random8(max_cooling));
+
+        // 2. 热量向上飘，同时略微扩散
+        for (uint8_t h = H - 1; h >= 2; --h) column[h] = (column[h - 1] + column[h - 2] + column[h - 2]) / 3;
+
+        // 3. 底部随机产生火星，概率 = SPARKING * (1 + FLICKER/256 * 噪声)，噪声约 [-1, 1]，每 4 列一个噪声格
+        const Fixed::q16 n = Noise::perlin2(x * (Fixed::ONE / 4), z);
+        const int32_t chance = params[SPARKING] + ((params[SPARKING] * Fixed::mul(n, params[FLICKER])) >> 8);
+        if (random8() < chance) {
+            const uint8_t h = random8(H < 3 ? H : 3);
+            column[h] = addSaturate(column[h], static_cast<uint8_t>(160 + random8(96)));
+        }
+
+        // 4. 查表上色，第 0 格在最下面一行
+        for (uint8_t h = 0; h < H; ++h) {
+            const Color::Rgb c = HEAT_PALETTE[column[h]];
+            fb.setPixel(x, H - 1 - h, c.r, c.g, c.b);
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#include "keyframe_effect.hpp"
+
+KeyframeEffect &KeyframeEffect::getInstance() {
+    static KeyframeEffect instance;
+    return instance;
+}
+
+bool KeyframeEffect::push(const std::span<const uint8_t> pixels, const uint16_t duration_ms,
+                          const Easing::Curve curve) {
+    if (pixels.size() != WS2812B::LED_COUNT * 3 || queue_count == QUEUE_SIZE) return false;
+
+    Keyframe &slot = queue[(queue_head + queue_count) % QUEUE_SIZE];
+    for (uint16_t i = 0; i < WS2812B::LED_COUNT; ++i) {
+        slot.pixels[i] = {pixels[i * 3], pixels[i * 3 + 1], pixels[i * 3 + 2]};
+    }
+    slot.duration_ms = duration_ms;
+    slot.curve = curve;
+    queue_count++;
+    return true;
+}
+
+void KeyframeEffect::flush() { queue_count = 0; }
+
+bool KeyframeEffect::pop(Keyframe &out) {
+    if (queue_count == 0) return false;
+
+    out = queue[queue_head];
+    queue_head = (queue_head + 1) % QUEUE_SIZE;
+    queue_count--;
+    return true;
+}
+
+void KeyframeEffect::enter(WS2812B &fb) {
+    // 从当前显示的画面开始插值到第一个关键帧
+    for (uint16_t i = 0; i < WS2812B::LED_COUNT; ++i) {
+        from[i] = fb.getPixel(i % WS2812B::WIDTH, i / WS2812B::WIDTH);
+    }
+    playing = false;
+}
+
+void KeyframeEffect::update(const uint32_t t, WS2812B &fb) {
+    // 空闲时收到新的关键帧，从现在开始
+    if (!playing && pop(target)) {
+        playing = true;
+        segment_start = t;
+    }
+
+    // 当前段已结束：终点成为下一段的起点，下一段紧接着上一段的结束时刻开始
+    while (playing && t - segment_start >= target.duration_ms) {
+        from = target.pixels;
+        segment_start += target.duration_ms;
+        playing = pop(target);
+    }
+
+    // 播放中 elapsed < duration_ms，不会除零
+    uint16_t alpha = 0;
+    if (playing) {
+        const uint32_t elapsed = t - segment_start;
+        alpha = Easing::apply(target.curve, static_cast<uint16_t>(elapsed * 256 / target.duration_ms));
+    }
+
+    // 定点线性插值：from + (to - from) * alpha / 256
+    for (uint16_t i = 0; i < WS2812B::LED_COUNT; ++i) {
+        std::array<uint8_t, 3> color = from[i];
+        for (uint8_t ch = 0; alpha != 0 && ch < 3; ++ch) {
+            const int32_t a = from[i][ch];
+            const int32_t b = target.pixels[i][ch];
+            color[ch] = static_cast<uint8_t>(a + (((b - a) * alpha) >> 8));
+        }
+        fb.setPixel(i % WS2812B::WIDTH, i / WS2812B::WIDTH, color[0], color[1], color[2]);
+    }
+}
@@ -0,0 +1,78 @@
+#include "life_effect.hpp"
+
+#include "color.hpp"
+
+void LifeEffect::enter(WS2812B &) {
+    board.clear(); // 下一次 update() 随机播种
+    restart = true;
+}
+
+void LifeEffect::update(const uint32_t t, WS2812B &fb) {
+    if (restart) {
+        restart = false;
+        if (board.population() == 0) reseed(t);
+        age.fill(0);
+        stagnant = 0;
+        last_step = t;
+        draw(fb);
+        return;
+    }
+
+    const uint32_t period = params[GENERATION] * 10u;
+    if (t - last_step < period) return;
+    last_step = t;
+
+    before_previous = previous;
+    previous = board;
+    board.step(rule(), params[WRAP] != 0);
+
+    // 全部死亡立即重新播种；静止或周期 2 振荡持续一段时间后重新播种
+    if (board.population() == 0) {
+        reseed(t);
+    } else if (board == previous || board == before_previous) {
+        if (++stagnant >= STAGNANT_LIMIT) reseed(t);
+    } else {
+        stagnant = 0;
+    }
+
+    draw(fb);
+}
+
+Life::Rule LifeEffect::rule() const {
+    return {static_cast<uint16_t>(params[BIRTH] | ((params[RULE_8] & 1u) << 8)),
+            static_cast<uint16_t>(params[SURVIVE] | ((params[RULE_8] & 2u) << 7))};
+}
+
+void LifeEffect::reseed(const uint32_t t) {
+    random_state ^= t | 1u; // xorshift32 的状态不能为 0
+
+    board.clear();
+    for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+        for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) {
+            random_state ^= random_state << 13;
+            random_state ^= random_state >> 17;
+            random_state ^= random_state << 5;
+            board.set(x, y, random_state % 3 == 0); // 约 1/3 的密度
+        }
+    }
+    age.fill(0);
+    stagnant = 0;
+}
+
+void LifeEffect::draw(WS2812B &fb) {
+    uint16_t index = 0;
+    for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+        for (uint8_t x = 0; x < WS2812B::WIDTH; ++x, ++index) {
+            if (!board.get(x, y)) {
+                age[index] = 0;
+                fb.setPixel(x, y, 0, 0, 0);
+                continue;
+            }
+
+            if (age[index] < UINT8_MAX) age[index]++;
+            const auto hue = static_cast<uint8_t>(params[HUE] + (age[index] - 1) * params[AGE_HUE_STEP]);
+            const Color::Rgb c = Color::HUE_LUT[hue];
+            fb.setPixel(x, y, c.r, c.g, c.b);
+        }
+    }
+}
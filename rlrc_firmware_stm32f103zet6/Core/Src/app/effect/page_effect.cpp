@@ -0,0 +1,64 @@
+#include "page_effect.hpp"
+
+#include <algorithm>
+
+PageEffect &PageEffect::getInstance() {
+    static PageEffect instance;
+    return instance;
+}
+
+bool PageEffect::upload(const uint8_t page, const std::span<const uint8_t> pixels) {
+    if (page >= PAGE_COUNT || pixels.size() != PAGE_SIZE) return false;
+
+    std::copy(pixels.begin(), pixels.end(), pages[page].begin());
+    if (page == current_page) page_changed = true; // 正在显示的页被改写
+    return true;
+}
+
+bool PageEffect::flip(const uint8_t page) {
+    if (page >= PAGE_COUNT) return false;
+
+    cycle_period_ms = 0;
+    current_page = page;
+    page_changed = true;
+    return true;
+}
+
+bool PageEffect::setCycle(const uint8_t first, const uint8_t count, const uint16_t period_ms) {
+    if (period_ms != 0 && (count == 0 || first + count > PAGE_COUNT)) return false;
+
+    cycle_first = first;
+    cycle_count = count;
+    cycle_period_ms = period_ms;
+    cycle_started = false; // 下一次 update() 从 first 开始
+    return true;
+}
+
+uint8_t PageEffect::currentPage() const { return current_page; }
+
+void PageEffect::enter(WS2812B &) {
+    page_changed = true;
+    cycle_started = false;
+}
+
+void PageEffect::update(const uint32_t t, WS2812B &fb) {
+    if (cycle_period_ms != 0) {
+        if (!cycle_started) {
+            cycle_started = true;
+            current_page = cycle_first;
+            next_flip_time = t + cycle_period_ms;
+            page_changed = true;
+        } else if (static_cast<int32_t>(t - next_flip_time) >= 0) {
+            // 按固定节奏翻页，落后一整个周期以上时从现在重新计时
+            next_flip_time = (t - next_flip_time >= cycle_period_ms) ? t + cycle_period_ms
+                                                                     : next_flip_time + cycle_period_ms;
+            const uint8_t index = current_page - cycle_first + 1;
+            current_page = cycle_first + (index >= cycle_count ? 0 : index);
+            page_changed = true;
+        }
+    }
+
+    if (!page_changed) return;
+    page_changed = false;
+    fb.setFrame(pages[current_page]);
+}
@@ -0,0 +1,9 @@
+#include "plasma_effect.hpp"
+
+#include "shader.hpp"
+
+using PlasmaShader = Shader::Pipeline<Shader::Cartesian, Shader::Plasma<PlasmaEffect::SPEED>,
+                                      Shader::Rainbow<PlasmaEffect::HUE_SPEED>,
+                                      Shader::Brightness<PlasmaEffect::BRIGHTNESS>>;
+
+void PlasmaEffect::update(const uint32_t t, WS2812B &fb) { PlasmaShader::render({t, params}, fb); }
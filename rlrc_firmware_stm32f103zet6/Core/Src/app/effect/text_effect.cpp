@@ -0,0 +1,74 @@
+#include "text_effect.hpp"
+
+#include "font.hpp"
+
+TextEffect &TextEffect::getInstance() {
+    static TextEffect instance;
+    return instance;
+}
+
+void TextEffect::setText(const std::span<const uint8_t> new_text, const Color::Rgb new_color,
+                         const uint16_t new_speed) {
+    length = static_cast<uint8_t>(new_text.size() < MAX_TEXT ? new_text.size() : MAX_TEXT);
+    for (uint8_t i = 0; i < length; ++i) text[i] = static_cast<char>(new_text[i]);
+    color = new_color;
+    speed = new_speed;
+    restart = true;
+}
+
+void TextEffect::enter(WS2812B &) { restart = true; }
+
+int32_t TextEffect::textWidth() const {
+    // 最后一个字后面的空白列不计入宽度
+    return length == 0 ? 0 : length * Font::ADVANCE - 1;
+}
+
+uint8_t TextEffect::columnAt(const int32_t x) const {
+    if (x < 0 || x >= textWidth()) return 0;
+    return Font::column(text[x / Font::ADVANCE], static_cast<uint8_t>(x % Font::ADVANCE));
+}
+
+void TextEffect::update(const uint32_t t, WS2812B &fb) {
+    if (restart) {
+        restart = false;
+        start_time = t;
+        shown_offset = INT32_MIN;
+    }
+
+    // 屏幕第 0 列对应文字的位置 (1/256 像素)
+    int32_t offset;
+    const int32_t width = textWidth();
+    if (speed == 0) {
+        // 静止：放得下时居中，否则左对齐
+        offset = width < WS2812B::WIDTH ? -((WS2812B::WIDTH - width) * 256 / 2) : 0;
+    } else {
+        // 从右边缘外进入，完全移出左边缘后重新开始
+        const uint32_t period = static_cast<uint32_t>(width + WS2812B::WIDTH) * 256;
+        const uint64_t travelled = static_cast<uint64_t>(t - start_time) * speed / 1000;
+        offset = static_cast<int32_t>(travelled % period) - WS2812B::WIDTH * 256;
+    }
+    if (offset == shown_offset) return;
+    shown_offset = offset;
+
+    const int32_t whole = offset >> 8; // 向下取整
+    const uint32_t frac = offset & 0xFF;
+    constexpr uint8_t top = WS2812B::HEIGHT > Font::GLYPH_HEIGHT ? (WS2812B::HEIGHT - Font::GLYPH_HEIGHT) / 2 : 0;
+
+    for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) {
+        const uint8_t left = columnAt(whole + x);
+        const uint8_t right = columnAt(whole + x + 1);
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+            const uint8_t row = y - top;
+            if (y < top || row >= Font::GLYPH_HEIGHT) {
+                fb.setPixel(x, y, 0, 0, 0);
+                continue;
+            }
+
+            // 两列亮度按小数部分混合
+            const uint32_t level = ((left >> row) & 1u) * (256 - frac) + ((right >> row) & 1u) * frac;
+            const auto scale = static_cast<uint8_t>(level > 255 ? 255 : level);
+            fb.setPixel(x, y, Color::scale8(color.r, scale), Color::scale8(color.g, scale),
+                        Color::scale8(color.b, scale));
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#include "vm_effect.hpp"
+
+VmEffect &VmEffect::getInstance() {
+    static VmEffect instance;
+    return instance;
+}
+
+BytecodeVm::ErrorCode VmEffect::load(const std::span<const uint8_t> program) {
+    const auto result = vm.load(program);
+    if (result == BytecodeVm::ErrorCode::NONE) restart = true; // 新程序的时间从 0 开始
+    return result;
+}
+
+void VmEffect::enter(WS2812B &) { restart = true; }
+
+void VmEffect::update(const uint32_t t, WS2812B &fb) {
+    if (!vm.loaded()) return;
+
+    if (restart) {
+        restart = false;
+        start_time = t;
+    }
+
+    // 毫秒转换为 Q16 秒：t * 65536 / 1000，先取整秒避免溢出
+    const uint32_t elapsed = t - start_time;
+    const Fixed::q16 seconds =
+        Fixed::fromInt(static_cast<int32_t>(elapsed / 1000)) + static_cast<Fixed::q16>((elapsed % 1000) * 65536 / 1000);
+
+    BytecodeVm::Inputs in{.x = 0, .y = 0, .t = seconds, .i = 0};
+    uint16_t index = 0;
+    for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+        for (uint8_t x = 0; x < WS2812B::WIDTH; ++x, ++index) {
+            in.x = Fixed::fromInt(x);
+            in.y = Fixed::fromInt(y);
+            in.i = Fixed::fromInt(index);
+            const auto [r, g, b] = vm.run(in, params);
+            fb.setPixel(x, y, Fixed::toByte(r), Fixed::toByte(g), Fixed::toByte(b));
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#include "log_buffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdarg>
+#include <cstdio>
+
+namespace LogBuffer {
+    static std::array<char, CAPACITY> buffer{};
+    static size_t head = 0; // 写指针
+    static size_t size = 0; // 已缓存的字节数
+
+    bool write(const std::span<const char> text) {
+        for (size_t i = 0; i < text.size(); i++) {
+            if (size == CAPACITY) return false; // 满了，丢弃剩余部分
+
+            buffer[head] = text[i];
+            head = (head + 1) % CAPACITY;
+            size++;
+        }
+        return true;
+    }
+
+    bool print(const char *format, ...) {
+        std::array<char, MAX_LINE> line{};
+
+        va_list args;
+        va_start(args, format);
+        const int length = vsnprintf(line.data(), line.size(), format, args);
+        va_end(args);
+        if (length < 0) return false;
+
+        // vsnprintf 返回的是完整输出所需的长度，截断时只写入缓冲区中实际存在的部分
+        const size_t written = std::min(static_cast<size_t>(length), line.size() - 1);
+        return write({line.data(), written}) && written == static_cast<size_t>(length);
+    }
+
+    size_t drain(const size_t max_bytes) {
+        size_t budget = max_bytes;
+        while (budget > 0 && size > 0) {
+            // 读指针到缓冲区末尾之间的连续一段
+            const size_t tail = (head + CAPACITY - size) % CAPACITY;
+            size_t len = std::min(size, CAPACITY - tail);
+            if (len > budget) len = budget;
+
+            printf("%.*s", static_cast<int>(len), &buffer[tail]);
+            size -= len;
+            budget -= len;
+        }
+        return size;
+    }
+
+    bool empty() { return size == 0; }
+} // namespace LogBuffer
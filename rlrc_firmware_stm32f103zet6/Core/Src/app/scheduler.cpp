@@ -0,0 +1,78 @@
+#include "scheduler.hpp"
+
+#include <bit>
+
+TaskScheduler::TaskScheduler(const ClockFn clock) : clock(clock) {}
+
+TaskScheduler::TaskId TaskScheduler::add(const char *name, const TaskFn fn, const Priority priority,
+                                         const uint32_t deadline) {
+    const TaskId id = task_count++;
+
+    Task &task = tasks[id];
+    task.name = name;
+    task.fn = fn;
+    task.priority = priority;
+    task.deadline = deadline;
+
+    priority_masks[static_cast<uint8_t>(priority)] |= 1u << id;
+    return id;
+}
+
+void TaskScheduler::setDeadline(const TaskId id, const uint32_t deadline) { tasks[id].deadline = deadline; }
+
+// 可能在中断上下文中执行
+void TaskScheduler::post(const TaskId id) {
+    const uint32_t bit = 1u << id;
+
+    // 只有从「未就绪」变为「就绪」时才记录时间，重复 post 不会把等待时间清零
+    // 单核上中断一定执行完才回到主循环，主循环读到置位时 ready_since 已经写好
+    if ((ready_mask.fetch_or(bit) & bit) == 0) {
+        tasks[id].ready_since.store(clock(), std::memory_order_relaxed);
+    }
+}
+
+bool TaskScheduler::runOne() {
+    const uint32_t ready = ready_mask.load();
+    if (ready == 0) return false;
+
+    // 找到优先级最高的一组就绪任务，取其中 ID 最小的一个
+    TaskId id = 0;
+    for (const uint32_t mask: priority_masks) {
+        if (const uint32_t candidates = ready & mask; candidates != 0) {
+            id = static_cast<TaskId>(std::countr_zero(candidates));
+            break;
+        }
+    }
+
+    // 先清除就绪位再运行：任务运行期间的新 post 会让它在之后再运行一次
+    ready_mask.fetch_and(~(1u << id));
+
+    Task &task = tasks[id];
+    const uint32_t start = clock();
+    const uint32_t latency = start - task.ready_since.load(std::memory_order_relaxed);
+
+    task.fn();
+
+    const uint32_t elapsed = clock() - start;
+
+    TaskStats &stats = task.stats;
+    stats.runs++;
+    stats.total_time += elapsed;
+    if (elapsed > stats.max_time) stats.max_time = elapsed;
+    if (latency > stats.max_latency) stats.max_latency = latency;
+    if (task.deadline != 0 && latency + elapsed > task.deadline) stats.deadline_misses++;
+
+    return true;
+}
+
+bool TaskScheduler::idle() const { return ready_mask.load() == 0; }
+
+uint8_t TaskScheduler::taskCount() const { return task_count; }
+
+const char *TaskScheduler::taskName(const TaskId id) const { return tasks[id].name; }
+
+TaskScheduler::TaskStats TaskScheduler::takeStats(const TaskId id) {
+    const TaskStats result = tasks[id].stats;
+    tasks[id].stats = {};
+    return result;
+}
@@ -0,0 +1,90 @@
+#include "sequencer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+Sequencer &Sequencer::getInstance() {
+    static Sequencer instance;
+    return instance;
+}
+
+Sequencer::ErrorCode Sequencer::append(const uint32_t time_ms, const std::span<const uint8_t> packet) {
+    if (packet.empty() || packet.size() > MAX_PACKET_SIZE) return ErrorCode::INVALID_PACKET;
+    if (cue_count != 0 && time_ms < last_time) return ErrorCode::OUT_OF_ORDER;
+    if (CUE_HEADER_SIZE + packet.size() > BUFFER_SIZE - used) return ErrorCode::FULL;
+
+    std::memcpy(&buffer[used], &time_ms, sizeof(time_ms));
+    buffer[used + 4] = static_cast<uint8_t>(packet.size());
+    std::copy(packet.begin(), packet.end(), buffer.begin() + used + CUE_HEADER_SIZE);
+
+    used += CUE_HEADER_SIZE + packet.size();
+    cue_count++;
+    last_time = time_ms;
+    return ErrorCode::NONE;
+}
+
+void Sequencer::clear() {
+    stop();
+    used = 0;
+    cue_count = 0;
+    last_time = 0;
+}
+
+void Sequencer::start(const uint32_t now, const uint32_t loop_ms) {
+    running = cue_count != 0;
+    generation++;
+    base_time = now;
+    loop_period = loop_ms;
+    next_offset = 0;
+}
+
+void Sequencer::stop() {
+    running = false;
+    generation++;
+}
+
+bool Sequencer::isRunning() const { return running; }
+
+size_t Sequencer::cueCount() const { return cue_count; }
+
+uint32_t Sequencer::cueTime(const size_t offset) const {
+    uint32_t time;
+    std::memcpy(&time, &buffer[offset], sizeof(time));
+    return time;
+}
+
+void Sequencer::update(const uint32_t now, const DispatchFn dispatch) {
+    const uint32_t my_generation = generation;
+
+    while (running) {
+        // 一轮结束
+        if (next_offset >= used) {
+            if (loop_period == 0) {
+                running = false;
+                return;
+            }
+            // 下一轮的起点紧接着上一轮，最后一个条目之后的空档由循环周期决定
+            base_time += std::max(loop_period, last_time);
+            next_offset = 0;
+            continue;
+        }
+
+        // 一轮还没开始就已经落后一整轮以上 (例如被长时间的 Flash 擦除阻塞)：
+        // 不追赶、也不一口气补放这一轮的条目，从现在开始这一轮
+        if (next_offset == 0 && loop_period != 0) {
+            const uint32_t period = std::max(loop_period, last_time);
+            if (static_cast<int32_t>(now - base_time) >= static_cast<int32_t>(period)) base_time = now;
+        }
+
+        // 时间允许回绕
+        if (static_cast<int32_t>(now - (base_time + cueTime(next_offset))) < 0) return;
+
+        const size_t length = buffer[next_offset + 4];
+        const std::span<const uint8_t> packet{&buffer[next_offset + CUE_HEADER_SIZE], length};
+        next_offset += CUE_HEADER_SIZE + length;
+        dispatch(packet);
+
+        // 指令本身修改了序列 (例如重新开始或停止)，以新的状态为准
+        if (generation != my_generation) return;
+    }
+}
@@ -0,0 +1,68 @@
+#include "sprite_table.hpp"
+
+SpriteTable &SpriteTable::getInstance() {
+    static SpriteTable instance;
+    return instance;
+}
+
+SpriteTable::ErrorCode SpriteTable::upload(const uint8_t id, const uint8_t width, const uint8_t height,
+                                           const Color::Rgb *key, const std::span<const uint8_t> pixels) {
+    if (id >= SPRITE_COUNT) return ErrorCode::INVALID_ID;
+    if (width == 0 || height == 0 || width > MAX_SIZE || height > MAX_SIZE) return ErrorCode::INVALID_SIZE;
+    if (pixels.size() != static_cast<size_t>(width) * height * 3) return ErrorCode::BAD_LENGTH;
+
+    auto &sprite = sprites[id];
+    sprite.width = width;
+    sprite.height = height;
+    sprite.has_key = key != nullptr;
+    sprite.key = key != nullptr ? *key : Color::Rgb{};
+    for (uint16_t i = 0; i < width * height; ++i) {
+        sprite.pixels[i] = {pixels[i * 3], pixels[i * 3 + 1], pixels[i * 3 + 2]};
+    }
+    return ErrorCode::NONE;
+}
+
+SpriteTable::ErrorCode SpriteTable::blit(WS2812B &fb, const uint8_t id, const int16_t x, const int16_t y,
+                                         const uint8_t flags, const uint8_t alpha) const {
+    if (id >= SPRITE_COUNT) return ErrorCode::INVALID_ID;
+    const auto &sprite = sprites[id];
+    if (sprite.width == 0) return ErrorCode::EMPTY;
+
+    if (flags & CLEAR_FIRST) fb.clear();
+    if (alpha == 0) return ErrorCode::NONE;
+
+    // 先把精灵矩形裁剪到点阵范围，循环内不再做边界判断
+    const int16_t left = x < 0 ? 0 : x;
+    const int16_t top = y < 0 ? 0 : y;
+    const int16_t right = x + sprite.width < WS2812B::WIDTH ? x + sprite.width : WS2812B::WIDTH;
+    const int16_t bottom = y + sprite.height < WS2812B::HEIGHT ? y + sprite.height : WS2812B::HEIGHT;
+
+    // 翻转时源坐标反向遍历：u = base + step * (px - x)
+    const int16_t base_u = (flags & FLIP_X) ? sprite.width - 1 : 0;
+    const int16_t step_u = (flags & FLIP_X) ? -1 : 1;
+    const int16_t base_v = (flags & FLIP_Y) ? sprite.height - 1 : 0;
+    const int16_t step_v = (flags & FLIP_Y) ? -1 : 1;
+
+    for (int16_t py = top; py < bottom; ++py) {
+        const auto *row = &sprite.pixels[(base_v + step_v * (py - y)) * sprite.width];
+        for (int16_t px = left; px < right; ++px) {
+            const Color::Rgb src = row[base_u + step_u * (px - x)];
+            if (sprite.has_key && src == sprite.key) continue;
+
+            const auto dx = static_cast<uint8_t>(px);
+            const auto dy = static_cast<uint8_t>(py);
+            if (alpha == 255) {
+                fb.setPixel(dx, dy, src.r, src.g, src.b);
+                continue;
+            }
+
+            // dst + (src - dst) * alpha / 256，alpha = 255 的情况已在上面直接覆盖
+            const auto dst = fb.getPixel(dx, dy);
+            const auto mix = [alpha](const uint8_t d, const uint8_t s) {
+                return static_cast<uint8_t>(d + (((s - d) * alpha) >> 8));
+            };
+            fb.setPixel(dx, dy, mix(dst[0], src.r), mix(dst[1], src.g), mix(dst[2], src.b));
+        }
+    }
+    return ErrorCode::NONE;
+}
@@ -13,6 +13,18 @@ void UART_Receiver::init() {
     // 我们开启了 Circular 模式，RX_BUFFER_SIZE 在这里是一轮搬运的长度
     // 与 ringBuffer 对齐以后就形成了环形缓冲区
     HAL_UART_Receive_DMA(&huart3, ringBuffer.data(), ringBuffer.size());
+
+    // 开启空闲中断：每段数据收完后唤醒处于 __WFI() 的主循环
+    // DMA 只在半满/全满时产生中断，单靠它无法及时得知短包到达
+    __HAL_UART_CLEAR_IDLEFLAG(&huart3);
+    __HAL_UART_ENABLE_IT(&huart3, UART_IT_IDLE);
+}
+
+void UART_Receiver::restart() {
+    // 出错时 HAL 已经中止了 DMA 接收，重新启动后 DMA 从缓冲区开头写起
+    HAL_UART_AbortReceive(&huart3);
+    tail = 0;
+    init();
 }
 
 std::span<uint8_t> UART_Receiver::tryGetPacket(std::span<uint8_t> output_buffer) {
@@ -0,0 +1,23 @@
+#include "uart_transmitter.hpp"
+
+#include "cobs.hpp"
+
+UART_Transmitter &UART_Transmitter::getInstance() {
+    static UART_Transmitter instance;
+    return instance;
+}
+
+bool UART_Transmitter::send(const std::span<const uint8_t> packet) {
+    if (packet.size() > MAX_PACKET_SIZE || isBusy()) return false;
+
+    // 发送期间 HAL 直接从 txBuffer 读取，因此只在空闲时覆盖它
+    const size_t length = Cobs::encode(packet, txBuffer);
+    if (length == 0) return false;
+
+    return HAL_UART_Transmit_IT(&huart3, txBuffer.data(), static_cast<uint16_t>(length)) == HAL_OK;
+}
+
+bool UART_Transmitter::isBusy() const {
+    // F1 的 HAL 中 gState 只反映发送方向，RxState 才是 DMA 接收的状态
+    return huart3.gState != HAL_UART_STATE_READY;
+}
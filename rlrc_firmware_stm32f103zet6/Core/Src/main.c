@@ -28,6 +28,8 @@
 #include "maincxx.hpp"
 #include "retarget.h"
 extern void ws2812b_dma_complete_callback();
+extern void frame_timer_tick_callback();
+extern void uart_receiver_error_callback(uint32_t error_code);
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -167,6 +169,33 @@ void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim)
     }
 }
 
+/**
+  * @brief  定时器更新回调
+  * @param  htim TIM 句柄
+  * @retval None
+  */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    // TIM2 是帧节拍
+    if (htim->Instance == TIM2)
+    {
+        frame_timer_tick_callback();
+    }
+}
+
+/**
+  * @brief  串口错误回调 (溢出、噪声、帧错误等；DMA 接收模式下 HAL 会随之停止接收)
+  * @param  huart UART 句柄
+  * @retval None
+  */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART3)
+    {
+        uart_receiver_error_callback(huart->ErrorCode);
+    }
+}
+
 /* USER CODE END 4 */
 
 /**
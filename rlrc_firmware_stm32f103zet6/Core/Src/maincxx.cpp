@@ -1,19 +1,93 @@
 #include "maincxx.hpp"
 #include <array>
-#include <cmath>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 
 #include "ProtocolHandler.hpp"
+#include "animation_manager.hpp"
+#include "coroutine.hpp"
+#include "cycle_counter.hpp"
 #include "esp8266.hpp"
+#include "frame_timer.hpp"
+#include "log_buffer.hpp"
+#include "scheduler.hpp"
+#include "sequencer.hpp"
+#include "spsc_queue.hpp"
 #include "uart_receiver.hpp"
 #include "usart.h"
 #include "ws2812b.hpp"
 
-extern "C" void ws2812b_dma_complete_callback() { WS2812B::getInstance().on_dma_transfer_complete(); }
+// --- 任务 ---
+// 优先级从高到低：中断事件、数据包接收 > 动画计算与编码发送 > 日志输出、统计
+static TaskScheduler scheduler{CycleCounter::now};
+static TaskScheduler::TaskId eventTask;
+static TaskScheduler::TaskId packetTask;
+static TaskScheduler::TaskId effectTask;
+static TaskScheduler::TaskId logTask;
+static TaskScheduler::TaskId statsTask;
 
-void updateDiffusionAnimation(uint32_t timestamp);
-void hsv2rgb(uint8_t h, uint8_t s, uint8_t v, uint8_t &r, uint8_t &g, uint8_t &b);
+// --- 中断事件 ---
+// TIM1、DMA1 通道 2/3、USART3 的中断同为抢占优先级 0，互不打断，对队列来说是同一个生产者
+// TIM2 (帧节拍) 的优先级不同，不能写入这个队列，它直接 post 任务
+enum class IsrEventType : uint8_t {
+    PACKET_READY, // 串口空闲，可能收到了完整的包
+    FRAME_DONE,   // WS2812B 的 DMA 传输完成
+    UART_ERROR,   // 串口错误，data 为 HAL 错误码
+};
+
+struct IsrEvent {
+    IsrEventType type;
+    uint32_t data; // 事件附带的数据
+};
+
+static SpscQueue<IsrEvent, 16> isrEvents;
+static std::atomic_uint32_t droppedIsrEvents = 0; // 队列满时丢弃的事件数
+
+static void pushIsrEvent(const IsrEventType type, const uint32_t data = 0) {
+    if (!isrEvents.push({type, data})) {
+        droppedIsrEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+    scheduler.post(eventTask);
+}
+
+extern "C" void ws2812b_dma_complete_callback() {
+    WS2812B::getInstance().on_dma_transfer_complete();
+    pushIsrEvent(IsrEventType::FRAME_DONE);
+}
+extern "C" void frame_timer_tick_callback() {
+    FrameTimer::getInstance().on_tick();
+    scheduler.post(effectTask);
+}
+extern "C" void uart_receiver_idle_callback() { pushIsrEvent(IsrEventType::PACKET_READY); }
+extern "C" void uart_receiver_error_callback(const uint32_t error_code) {
+    pushIsrEvent(IsrEventType::UART_ERROR, error_code);
+}
+
+// DMA 已经空闲时，co_await dmaComplete 直接继续，不会错过已经发生过的完成事件
+// 完成中断只把事件放入队列，由事件任务在主循环上下文中触发，因此「检查空闲」与「挂起」之间不会漏掉完成事件
+Coro::Event Coro::dmaComplete{[] { return !WS2812B::getInstance().isBusy(); }};
+
+static void runEventTask();
+static void runPacketTask();
+static void runEffectTask();
+static void runLogTask();
+static void runStatsTask();
+static void dispatchPacket(std::span<const uint8_t> packet);
+static void applyFrameRate(uint16_t fps);
+static Coro::Task animationLoop();
+static Coro::Task sequencerLoop();
+static Coro::Task renderLoop();
+
+// 存储 uart_receiver 获得的包
+static constexpr uint16_t scratchBufferSize = 4096;
+static std::array<uint8_t, scratchBufferSize> scratchBuffer{};
+
+// 统计信息的汇报周期
+static constexpr uint32_t statsIntervalMs = 10'000;
+
+// 日志任务每次最多输出的字节数，避免长日志一次占用太久
+static constexpr size_t logChunkBytes = 64;
 
 
 // --- 主程序入口 ---
@@ -26,6 +100,14 @@ void maincxx() {
     printf("[INFO] ESP8266 enabled.\r\n");
     HAL_Delay(1000);
 
+    // 注册任务，deadline 为从就绪到运行结束的期限 (CPU 周期)
+    const uint32_t cyclesPerMs = SystemCoreClock / 1000;
+    eventTask = scheduler.add("event", runEventTask, TaskScheduler::Priority::HIGH);
+    packetTask = scheduler.add("packet", runPacketTask, TaskScheduler::Priority::HIGH, 2 * cyclesPerMs);
+    effectTask = scheduler.add("effect", runEffectTask, TaskScheduler::Priority::NORMAL);
+    logTask = scheduler.add("log", runLogTask, TaskScheduler::Priority::LOW);
+    statsTask = scheduler.add("stats", runStatsTask, TaskScheduler::Priority::LOW);
+
     // 启动 UART
     auto &uart_receiver = UART_Receiver::getInstance();
     uart_receiver.init();
@@ -33,101 +115,199 @@ void maincxx() {
     // __HAL_UART_CLEAR_NEFLAG(&huart3);  // 清除噪声错误
     // __HAL_UART_CLEAR_FEFLAG(&huart3);  // 清除帧错误
     // __HAL_UART_CLEAR_IDLEFLAG(&huart3);// 清除空闲标志
+    scheduler.post(packetTask); // 处理启动前可能已经收到的数据
+
+    // 效果任务的期限与效果的计算预算随帧率变化
+    applyFrameRate(FrameTimer::DEFAULT_FPS);
+
+    // 启动协程，各自运行到第一次等待帧节拍处挂起
+    // 等待者按创建顺序恢复：先执行序列中的指令，本帧的效果就能立刻反映出来；最后编码发送
+    static Coro::Task sequencer = sequencerLoop();
+    static Coro::Task animation = animationLoop();
+    static Coro::Task render = renderLoop();
+    if (!animation.valid() || !sequencer.valid() || !render.valid()) {
+        printf("[ERROR] Coroutine frame pool exhausted.\r\n");
+    }
+    sequencer.start();
+    animation.start();
+    render.start();
 
-    // 存储 uart_receiver 获得的包
-    constexpr uint16_t scratchBufferSize = 4096;
-    std::array<uint8_t, scratchBufferSize> scratchBuffer{};
+    // 启动帧节拍
+    // 每个节拍推进一次动画并刷新 (高于内容帧率的刷新让时间抖动生效)
+    // 帧内容无变化、抖动也没有改变任何码元时，render() 不会重新发送
+    auto &frame_timer = FrameTimer::getInstance();
+    frame_timer.init();
+    printf("[INFO] Frame timer started at %d FPS.\r\n", frame_timer.getFps());
 
     while (true) {
-        // 从接收器获取一个完整的包
-        auto packet = uart_receiver.tryGetPacket(scratchBuffer);
-
-        // 包不为空时，分发处理
-        if (!packet.empty()) {
-            switch (ProtocolHandler::dispatch(packet)) {
-                case ProtocolHandler::ErrorCode::OK:
-                    break;
-                case ProtocolHandler::ErrorCode::INVALID_BUFFER_LENGTH:
-                    printf("Invalid buffer length.");
-                    break;
-                case ProtocolHandler::ErrorCode::UNKNOWN_COMMAND:
-                    printf("Unknown command.");
-                    break;
-            }
+        if (scheduler.runOne()) continue;
+
+        // 无就绪任务时休眠，等待节拍、串口空闲或 DMA 完成中断唤醒
+        // 关中断后再检查一次，避免检查与 __WFI() 之间到达的中断被错过 (PRIMASK 置位时挂起的中断依然能唤醒 WFI)
+        __disable_irq();
+        if (scheduler.idle()) {
+            __WFI();
         }
+        __enable_irq();
+    }
+}
 
-        // 2. 驱动动画逻辑
-        if (ProtocolHandler::g_currentMode == 1) { // 假设 1 是扩散动画模式
-            updateDiffusionAnimation(HAL_GetTick());
+// --- 任务：处理中断送来的事件 ---
+static void runEventTask() {
+    while (const auto event = isrEvents.pop()) {
+        switch (event->type) {
+            case IsrEventType::PACKET_READY:
+                scheduler.post(packetTask);
+                break;
+            case IsrEventType::FRAME_DONE:
+                // 恢复等待 DMA 完成的协程 (上一帧发送期间到来的节拍所计算的帧)
+                Coro::dmaComplete.fire();
+                break;
+            case IsrEventType::UART_ERROR:
+                printf("[ERROR] UART error 0x%02lx, restarting receiver.\r\n", static_cast<unsigned long>(event->data));
+                UART_Receiver::getInstance().restart();
+                break;
         }
     }
 }
 
-// --- 辅助函数：HSV 转 RGB ---
-// 用于生成平滑的彩虹色
-// h: 0-255, s: 0-255, v: 0-255
-void hsv2rgb(uint8_t h, uint8_t s, uint8_t v, uint8_t &r, uint8_t &g, uint8_t &b) {
-    unsigned char region, remainder, p, q, t;
+// --- 任务：处理所有已经收完整的包 ---
+static void runPacketTask() {
+    auto &uart_receiver = UART_Receiver::getInstance();
+    bool received = false;
+    for (auto packet = uart_receiver.tryGetPacket(scratchBuffer); !packet.empty();
+         packet = uart_receiver.tryGetPacket(scratchBuffer)) {
+        dispatchPacket(packet);
+        received = true;
+    }
+    // 恢复等待数据包的协程 (例如需要多个包才能完成的协议流程)
+    if (received) Coro::packetAvailable.fire();
 
-    if (s == 0) { r = v; g = v; b = v; return; }
+    if (!LogBuffer::empty()) scheduler.post(logTask);
+}
 
-    region = h / 43;
-    remainder = (h - (region * 43)) * 6;
+// --- 任务：帧节拍到达，驱动动画逻辑 ---
+static void runEffectTask() {
+    auto &frame_timer = FrameTimer::getInstance();
+    if (!frame_timer.takeTick()) return;
 
-    p = (v * (255 - s)) >> 8;
-    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
-    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+    // 帧率被指令修改过，按新的帧周期重新计算期限
+    if (static uint16_t appliedFps = FrameTimer::DEFAULT_FPS; frame_timer.getFps() != appliedFps) {
+        appliedFps = frame_timer.getFps();
+        applyFrameRate(appliedFps);
+    }
 
-    switch (region) {
-        case 0: r = v; g = t; b = p; break;
-        case 1: r = q; g = v; b = p; break;
-        case 2: r = p; g = v; b = t; break;
-        case 3: r = p; g = q; b = v; break;
-        case 4: r = t; g = p; b = v; break;
-        default: r = v; g = p; b = q; break;
+    // 恢复所有在等待帧节拍的协程
+    Coro::nextTick.fire();
+
+    static uint32_t lastStatsTime = 0;
+    if (const uint32_t now = HAL_GetTick(); now - lastStatsTime >= statsIntervalMs) {
+        lastStatsTime = now;
+        scheduler.post(statsTask);
     }
 }
 
-// --- 动画函数：彩色扩散 ---
-void updateDiffusionAnimation(uint32_t timestamp) {
-    // 限制帧率：每 50ms 更新一次 (20 FPS)
-    static uint32_t last_frame_time = 0;
-    if (timestamp - last_frame_time < 50) return;
-    last_frame_time = timestamp;
-
-    auto& led = WS2812B::getInstance();
-
-    // 动画参数
-    float center_x = 2.0f;
-    float center_y = 2.0f;
-    // 时间因子：让波纹随时间向外移动 (除以 200 控制速度)
-    float time_phase = timestamp / 200.0f;
-
-    for (int y = 0; y < 5; y++) {
-        for (int x = 0; x < 5; x++) {
-            // 1. 计算当前像素到中心的距离
-            float dist = std::sqrt(std::pow(x - center_x, 2) + std::pow(y - center_y, 2));
-
-            // 2. 计算波浪值 (sin波)
-            // (dist - time_phase) 实现了向外移动的效果
-            float wave = std::sin(dist - time_phase);
-
-            // 3. 根据波浪值计算颜色
-            // 我们只在波峰附近点亮 (wave > 0.5)
-            if (wave > 0.0f) { // 稍微宽一点的波段
-                // 颜色随时间变化 (彩虹旋转)
-                uint8_t hue = (uint8_t)((timestamp / 10) % 255);
-                // 亮度随波浪高度衰减
-                uint8_t val = (uint8_t)(wave * 255);
-
-                uint8_t r, g, b;
-                hsv2rgb(hue, 255, val, r, g, b);
-                led.setPixel(x, y, r, g, b);
-            } else {
-                // 波谷位置熄灭
-                led.setPixel(x, y, 0, 0, 0);
-            }
-        }
+// --- 任务：分批输出日志 ---
+static void runLogTask() {
+    if (LogBuffer::drain(logChunkBytes) > 0) scheduler.post(logTask); // 还有剩余，下次空闲时继续
+}
+
+// --- 任务：打印帧起始抖动与各任务的运行统计 ---
+static void runStatsTask() {
+    if (const auto stats = FrameTimer::getInstance().takeStats(); stats.frames != 0) {
+        printf("[INFO] Frame jitter: %lu frames, min/avg/max %lu/%lu/%lu us, overruns %lu\r\n",
+               static_cast<unsigned long>(stats.frames),
+               static_cast<unsigned long>(CycleCounter::toMicros(stats.min_cycles)),
+               static_cast<unsigned long>(CycleCounter::toMicros(static_cast<uint32_t>(stats.total_cycles / stats.frames))),
+               static_cast<unsigned long>(CycleCounter::toMicros(stats.max_cycles)),
+               static_cast<unsigned long>(stats.overruns));
+    }
+
+    if (const auto dropped = droppedIsrEvents.exchange(0, std::memory_order_relaxed); dropped != 0) {
+        printf("[WARN] ISR event queue overflow, %lu events dropped\r\n", static_cast<unsigned long>(dropped));
+    }
+
+    auto &animation = AnimationManager::getInstance();
+    for (uint8_t mode = 0; mode < AnimationManager::MAX_EFFECTS; mode++) {
+        const auto stats = animation.takeStats(mode);
+        if (stats.frames == 0) continue;
+
+        printf("[INFO] Effect %-10s: %lu frames, avg/max %lu/%lu us, over budget %lu\r\n",
+               animation.effect(mode)->name(), static_cast<unsigned long>(stats.frames),
+               static_cast<unsigned long>(CycleCounter::toMicros(static_cast<uint32_t>(stats.total_cycles / stats.frames))),
+               static_cast<unsigned long>(CycleCounter::toMicros(stats.max_cycles)),
+               static_cast<unsigned long>(stats.overruns));
+    }
+
+    for (TaskScheduler::TaskId id = 0; id < scheduler.taskCount(); id++) {
+        const auto stats = scheduler.takeStats(id);
+        if (stats.runs == 0) continue;
+
+        printf("[INFO] Task %-6s: %lu runs, avg/max %lu/%lu us, max wait %lu us, deadline misses %lu\r\n",
+               scheduler.taskName(id), static_cast<unsigned long>(stats.runs),
+               static_cast<unsigned long>(CycleCounter::toMicros(static_cast<uint32_t>(stats.total_time / stats.runs))),
+               static_cast<unsigned long>(CycleCounter::toMicros(stats.max_time)),
+               static_cast<unsigned long>(CycleCounter::toMicros(stats.max_latency)),
+               static_cast<unsigned long>(stats.deadline_misses));
+    }
+}
+
+// --- 按帧周期设置效果任务的期限与效果的计算预算 ---
+static void applyFrameRate(const uint16_t fps) {
+    const uint32_t framePeriod = SystemCoreClock / fps;
+
+    // 效果任务应在一个帧周期内完成
+    scheduler.setDeadline(effectTask, framePeriod);
+    // 效果的计算时间不应超过半个帧节拍，给编码和其他任务留出余量
+    AnimationManager::getInstance().setFrameBudget(framePeriod / 2);
+}
+
+// --- 分发一个数据包，错误写入日志缓冲区 ---
+static void dispatchPacket(const std::span<const uint8_t> packet) {
+    switch (ProtocolHandler::dispatch(packet)) {
+        case ProtocolHandler::ErrorCode::OK:
+            break;
+        case ProtocolHandler::ErrorCode::INVALID_BUFFER_LENGTH:
+            LogBuffer::print("Invalid buffer length.\r\n");
+            break;
+        case ProtocolHandler::ErrorCode::UNKNOWN_COMMAND:
+            LogBuffer::print("Unknown command.\r\n");
+            break;
+        case ProtocolHandler::ErrorCode::INVALID_ARGUMENT:
+            LogBuffer::print("Invalid argument.\r\n");
+            break;
+        case ProtocolHandler::ErrorCode::BUSY:
+            LogBuffer::print("Device busy.\r\n");
+            break;
+    }
+}
+
+// --- 序列协程：每个帧节拍执行到期的演出条目 ---
+static Coro::Task sequencerLoop() {
+    auto &sequencer = Sequencer::getInstance();
+    while (true) {
+        co_await Coro::nextTick;
+        sequencer.update(HAL_GetTick(), dispatchPacket);
+    }
+}
+
+// --- 动画协程：每个帧节拍推进一次当前效果 ---
+// 各效果的帧周期由 AnimationManager 控制
+static Coro::Task animationLoop() {
+    auto &animation = AnimationManager::getInstance();
+    while (true) {
+        co_await Coro::nextTick;
+        animation.update(HAL_GetTick());
+    }
+}
+
+// --- 发送协程：每个帧节拍编码并发送一帧 ---
+// 上一帧的 DMA 还没结束时不再直接返回 RENDER_BUSY 等到下一个节拍重试，而是挂起到 DMA 完成后立即发送
+static Coro::Task renderLoop() {
+    auto &ws2812b = WS2812B::getInstance();
+    while (true) {
+        co_await Coro::nextTick;
+        co_await Coro::dmaComplete;
+        ws2812b.render();
     }
-    led.render();
 }
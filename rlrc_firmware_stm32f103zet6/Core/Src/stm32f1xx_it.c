@@ -60,6 +60,8 @@ extern TIM_HandleTypeDef htim1;
 extern DMA_HandleTypeDef hdma_usart3_rx;
 extern UART_HandleTypeDef huart3;
 /* USER CODE BEGIN EV */
+extern TIM_HandleTypeDef htim2;
+extern void uart_receiver_idle_callback(void);
 
 /* USER CODE END EV */
 
@@ -248,6 +250,11 @@ void TIM1_UP_IRQHandler(void)
 void USART3_IRQHandler(void)
 {
   /* USER CODE BEGIN USART3_IRQn 0 */
+    // 空闲中断：HAL 不处理 IDLE 标志，需要手动清除 (读 SR 后读 DR)，否则会反复进入中断
+    if (__HAL_UART_GET_FLAG(&huart3, UART_FLAG_IDLE) && __HAL_UART_GET_IT_SOURCE(&huart3, UART_IT_IDLE)) {
+        __HAL_UART_CLEAR_IDLEFLAG(&huart3);
+        uart_receiver_idle_callback();
+    }
   /* USER CODE END USART3_IRQn 0 */
   HAL_UART_IRQHandler(&huart3);
   /* USER CODE BEGIN USART3_IRQn 1 */
@@ -256,4 +263,12 @@ void USART3_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles TIM2 global interrupt (帧节拍).
+  */
+void TIM2_IRQHandler(void)
+{
+    HAL_TIM_IRQHandler(&htim2);
+}
+
 /* USER CODE END 1 */
@@ -9,11 +9,34 @@ target_sources(${CMAKE_PROJECT_NAME} PRIVATE
         ${CMAKE_SOURCE_DIR}/Core/Src/retarget.c
         ${CMAKE_SOURCE_DIR}/Core/Src/app/driver/ws2812b.cpp
         ${CMAKE_SOURCE_DIR}/Core/Src/app/driver/esp8266.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/driver/frame_timer.cpp
         ${CMAKE_SOURCE_DIR}/Core/Src/app/uart_receiver.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/uart_transmitter.cpp
         ${CMAKE_SOURCE_DIR}/Core/Src/app/ProtocolHandler.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/scheduler.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/log_buffer.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/coroutine.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/clip_store.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/sequencer.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/bytecode_vm.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/draw.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/sprite_table.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/effect.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/animation_manager.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/diffusion_effect.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/plasma_effect.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/cloud_effect.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/life_effect.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/fire_effect.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/text_effect.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/keyframe_effect.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/page_effect.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/clip_effect.cpp
+        ${CMAKE_SOURCE_DIR}/Core/Src/app/effect/vm_effect.cpp
 )
 
 target_include_directories(${CMAKE_PROJECT_NAME} PRIVATE
         ${CMAKE_SOURCE_DIR}/Core/Inc/app
         ${CMAKE_SOURCE_DIR}/Core/Inc/app/driver
+        ${CMAKE_SOURCE_DIR}/Core/Inc/app/effect
 )
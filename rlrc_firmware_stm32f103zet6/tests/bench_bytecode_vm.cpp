@@ -0,0 +1,95 @@
+/**
+ * 字节码虚拟机基准测试：解释执行的吞吐量 (像素/秒)
+ *
+ * 三个有代表性的程序：线性渐变 (最简单)、双正弦等离子 + HSV、值噪声。
+ * 按 60 FPS 的帧预算 (16.7 ms) 换算出主机上一帧最多能跑多少像素，作为不同程序之间的相对参考。
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "bytecode_vm.hpp"
+#include "test_support.hpp"
+
+namespace {
+    using Fixed::q16;
+    using Op = BytecodeVm::Op;
+
+    struct Program {
+        const char *name;
+        std::vector<uint8_t> bytes;
+
+        Program &op(const Op op) {
+            bytes.push_back(static_cast<uint8_t>(op));
+            return *this;
+        }
+
+        Program &constant(const q16 value) {
+            op(Op::CONST);
+            uint8_t raw[4];
+            std::memcpy(raw, &value, sizeof(raw));
+            bytes.insert(bytes.end(), raw, raw + 4);
+            return *this;
+        }
+    };
+
+    // r = x / w, g = y / h, b = 0.5
+    Program gradient() {
+        Program p{"gradient", {}};
+        p.op(Op::X).op(Op::W).op(Op::DIV).op(Op::Y).op(Op::H).op(Op::DIV).constant(Fixed::HALF);
+        return p;
+    }
+
+    // hsv(sin(x * 0.5 + t) * 0.25 + sin(y * 0.7 - t) * 0.25, 1, 1)
+    Program plasma() {
+        Program p{"plasma", {}};
+        p.op(Op::X).constant(Fixed::HALF).op(Op::MUL).op(Op::T).op(Op::ADD).op(Op::SIN);
+        p.constant(Fixed::ONE / 4).op(Op::MUL);
+        p.op(Op::Y).constant(Fixed::fromDouble(0.7)).op(Op::MUL).op(Op::T).op(Op::SUB).op(Op::SIN);
+        p.constant(Fixed::ONE / 4).op(Op::MUL).op(Op::ADD);
+        p.constant(Fixed::ONE).constant(Fixed::ONE).op(Op::HSV);
+        return p;
+    }
+
+    // v = noise(x * 0.3 + t, y * 0.3)，r = v, g = v * v, b = 0.2
+    Program noise() {
+        Program p{"noise", {}};
+        p.op(Op::X).constant(Fixed::fromDouble(0.3)).op(Op::MUL).op(Op::T).op(Op::ADD);
+        p.op(Op::Y).constant(Fixed::fromDouble(0.3)).op(Op::MUL).op(Op::NOISE);
+        p.op(Op::X).constant(Fixed::fromDouble(0.3)).op(Op::MUL).op(Op::T).op(Op::ADD);
+        p.op(Op::Y).constant(Fixed::fromDouble(0.3)).op(Op::MUL).op(Op::NOISE);
+        p.op(Op::X).constant(Fixed::fromDouble(0.3)).op(Op::MUL).op(Op::T).op(Op::ADD);
+        p.op(Op::Y).constant(Fixed::fromDouble(0.3)).op(Op::MUL).op(Op::NOISE);
+        p.op(Op::MUL).constant(Fixed::fromDouble(0.2));
+        return p;
+    }
+} // namespace
+
+int main() {
+    constexpr std::array<uint8_t, BytecodeVm::PARAM_COUNT> params{};
+    constexpr uint16_t WIDTH = 40; // 按 40x25 的坐标范围遍历像素
+
+    std::printf("Bytecode VM throughput\n");
+    std::printf("  %-10s %8s %10s %12s %16s\n", "program", "bytes", "ns/pixel", "Mpixel/s", "pixels @ 60 FPS");
+    for (const Program &program: {gradient(), plasma(), noise()}) {
+        BytecodeVm vm;
+        CHECK(vm.load(program.bytes) == BytecodeVm::ErrorCode::NONE);
+
+        uint32_t sink = 0;
+        const double ns = Bench::nsPerCall(1'000'000, [&](const unsigned i) {
+            const BytecodeVm::Inputs in{
+                .x = Fixed::fromInt(static_cast<int32_t>(i % WIDTH)),
+                .y = Fixed::fromInt(static_cast<int32_t>(i / WIDTH % 25)),
+                .t = static_cast<q16>(i / 1000 * 1092), // 每 1000 像素前进约 1/60 秒
+                .i = Fixed::fromInt(static_cast<int32_t>(i % 1000)),
+            };
+            const auto rgb = vm.run(in, params);
+            sink += static_cast<uint32_t>(rgb[0] ^ rgb[1] ^ rgb[2]);
+        });
+        Bench::keep(sink);
+        std::printf("  %-10s %8zu %10.1f %12.1f %16.0f\n", program.name, program.bytes.size(), ns, 1e3 / ns,
+                    1e9 / 60 / ns);
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * 颜色转换基准测试：每个像素的耗时
+ *
+ * 对比除法 + switch 的 hsv2rgb()、查色相表的 Color::hsv()、直接查 256 项色相表，
+ * 以及逐像素插值的 16 色调色板与 256 项颜色表 (火焰效果在编译期把调色板展开成这样的表)。
+ * 每种方法转换 1000 个像素为一轮，输入每轮不同。
+ * 整行批量版本 (span 的 hsv2rgb 与 Palette16::map) 先生成输入缓冲再整体转换，结果必须与逐像素版本相同。
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+
+#include "color.hpp"
+#include "fire_effect.hpp"
+#include "test_support.hpp"
+
+namespace {
+    using Color::Rgb;
+
+    constexpr unsigned PIXELS = 1000;
+
+    std::array<Rgb, PIXELS> out{};
+
+    constexpr const Color::Palette16 &HEAT = FireEffect::HEAT_COLORS;
+
+    // 火焰效果原先手写的 256 项颜色表：黑 -> 红 -> 黄 -> 白
+    constexpr std::array<Rgb, 256> HEAT_TABLE = [] {
+        std::array<Rgb, 256> table{};
+        for (int heat = 0; heat < 256; ++heat) {
+            const int t192 = heat * 191 / 255;
+            const auto ramp = static_cast<uint8_t>((t192 & 0x3F) << 2);
+            if (t192 & 0x80) {
+                table[heat] = {255, 255, ramp};
+            } else if (t192 & 0x40) {
+                table[heat] = {255, ramp, 0};
+            } else {
+                table[heat] = {ramp, 0, 0};
+            }
+        }
+        return table;
+    }();
+
+    constexpr uint8_t input(const unsigned i, const unsigned p, const unsigned salt) {
+        return static_cast<uint8_t>((i * 31 + p * 7) * salt >> 3);
+    }
+
+    std::array<Color::Hsv, PIXELS> hsv_in{};
+    std::array<uint8_t, PIXELS> index_in{};
+
+    template<typename Fn>
+    void row(const char *name, Fn &&convert) {
+        const double ns = Bench::nsPerCall(20'000, [&](const unsigned i) {
+            for (unsigned p = 0; p < PIXELS; ++p) out[p] = convert(i, p);
+            Bench::keep(out);
+        });
+        std::printf("  %-24s %10.2f\n", name, ns / PIXELS);
+    }
+
+    // 整行批量转换：fill 生成第 i 轮的输入，convert 一次转换全部像素
+    template<typename Fill, typename Fn>
+    void batch(const char *name, Fill &&fill, Fn &&convert) {
+        const double ns = Bench::nsPerCall(20'000, [&](const unsigned i) {
+            fill(i);
+            convert();
+            Bench::keep(out);
+        });
+        std::printf("  %-24s %10.2f\n", name, ns / PIXELS);
+    }
+
+    void fillHsv(const unsigned i) {
+        for (unsigned p = 0; p < PIXELS; ++p) hsv_in[p] = {input(i, p, 13), input(i, p, 29), input(i, p, 47)};
+    }
+
+    void fillIndex(const unsigned i) {
+        for (unsigned p = 0; p < PIXELS; ++p) index_in[p] = Color::scale8(input(i, p, 13), 240);
+    }
+} // namespace
+
+int main() {
+    std::printf("Color conversion, %u pixels (ns per pixel)\n", PIXELS);
+    row("hsv2rgb (div + switch)", [](const unsigned i, const unsigned p) {
+        Rgb c;
+        Color::hsv2rgb(input(i, p, 13), input(i, p, 29), input(i, p, 47), c.r, c.g, c.b);
+        return c;
+    });
+    row("Color::hsv (LUT)", [](const unsigned i, const unsigned p) {
+        return Color::hsv(input(i, p, 13), input(i, p, 29), input(i, p, 47));
+    });
+    row("HUE_LUT (s = v = 255)", [](const unsigned i, const unsigned p) { return Color::HUE_LUT[input(i, p, 13)]; });
+    row("256-entry heat table", [](const unsigned i, const unsigned p) {
+        return FireEffect::HEAT_PALETTE[input(i, p, 13)];
+    });
+    row("Palette16 (0-240)", [](const unsigned i, const unsigned p) {
+        return HEAT[Color::scale8(input(i, p, 13), 240)];
+    });
+    batch("hsv2rgb (span)", fillHsv, [] { Color::hsv2rgb(hsv_in, out); });
+    batch("Palette16::map (span)", fillIndex, [] { HEAT.map(index_in, out); });
+
+    // 批量版本与逐像素版本逐个比较
+    fillHsv(7);
+    Color::hsv2rgb(hsv_in, out);
+    for (unsigned p = 0; p < PIXELS; ++p) CHECK(out[p] == Color::hsv(hsv_in[p].h, hsv_in[p].s, hsv_in[p].v));
+    fillIndex(7);
+    HEAT.map(index_in, out);
+    for (unsigned p = 0; p < PIXELS; ++p) CHECK(out[p] == HEAT[index_in[p]]);
+
+    // 16 色调色板与原先手写的表的最大差异
+    int worst = 0;
+    for (int heat = 0; heat < 256; ++heat) {
+        const Rgb a = HEAT_TABLE[heat], b = FireEffect::HEAT_PALETTE[heat];
+        worst = std::max({worst, std::abs(a.r - b.r), std::abs(a.g - b.g), std::abs(a.b - b.b)});
+    }
+    std::printf("\nPalette16 heat vs 256-entry table: max channel difference %d\n", worst);
+    return 0;
+}
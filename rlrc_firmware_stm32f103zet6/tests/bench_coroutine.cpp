@@ -0,0 +1,106 @@
+/**
+ * 协程基准测试：协程与手写状态机的每次唤醒开销
+ *
+ * 两种写法实现同一个流程 (与固件的发送协程相同)：等帧节拍 -> 等 DMA 完成 -> 处理一帧，
+ * 每轮依次触发一次节拍和一次 DMA 完成，分别测 1 个和 3 个并发流程，每项取多次运行中的最小值。
+ * - 协程：Coro::Event::fire() 按槽位检查等待标志并 resume
+ * - 手写状态机：状态存放在结构体中，事件到来时逐个调用 (不内联，相当于在另一个翻译单元中) 并 switch 状态
+ *
+ * 协程每次唤醒是一次间接调用加按挂起点的跳转，而状态机是直接调用，实测协程每轮约为状态机的 2~3 倍
+ * (每次唤醒多 2~3 ns)。基准在协程超过状态机 MAX_RATIO 倍时失败，防止运行时的唤醒路径继续变慢。
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+
+#include "coroutine.hpp"
+#include "test_support.hpp"
+
+namespace {
+    Coro::Event tick;
+    Coro::Event dma;
+    uint32_t frames = 0;
+
+    [[gnu::noinline]] void processFrame(const uint32_t id) { frames += id; }
+
+    Coro::Task flow(const uint32_t id) {
+        while (true) {
+            co_await tick;
+            co_await dma;
+            processFrame(id);
+        }
+    }
+
+    struct Machine {
+        enum class State : uint8_t { WAIT_TICK, WAIT_DMA };
+        State state = State::WAIT_TICK;
+        uint32_t id = 0;
+
+        [[gnu::noinline]] void onTick() {
+            if (state == State::WAIT_TICK) state = State::WAIT_DMA;
+        }
+
+        [[gnu::noinline]] void onDma() {
+            switch (state) {
+                case State::WAIT_DMA:
+                    state = State::WAIT_TICK;
+                    processFrame(id);
+                    break;
+                case State::WAIT_TICK:
+                    break;
+            }
+        }
+    };
+
+    constexpr unsigned ITERATIONS = 1'000'000;
+    constexpr int RUNS = 7;
+    constexpr double MAX_RATIO = 4.0;
+
+    struct Result {
+        double coroutine;
+        double machine;
+    };
+
+    // 两种写法交替运行、各取最小值，机器负载的波动同时作用于两者
+    template<size_t N>
+    Result compare() {
+        std::array<Coro::Task, N> tasks;
+        for (size_t i = 0; i < N; ++i) {
+            tasks[i] = flow(static_cast<uint32_t>(i + 1));
+            CHECK(tasks[i].valid());
+            tasks[i].start();
+        }
+        static std::array<Machine, N> list{};
+        for (size_t i = 0; i < N; ++i) list[i].id = static_cast<uint32_t>(i + 1);
+
+        Result best{1e9, 1e9};
+        for (int run = 0; run < RUNS; ++run) {
+            best.coroutine = std::min(best.coroutine, Bench::nsPerCall(ITERATIONS, [](unsigned) {
+                tick.fire();
+                dma.fire();
+            }));
+            best.machine = std::min(best.machine, Bench::nsPerCall(ITERATIONS, [](unsigned) {
+                for (auto &machine: list) machine.onTick();
+                for (auto &machine: list) machine.onDma();
+            }));
+        }
+        return best;
+    }
+} // namespace
+
+int main() {
+    const Result one = compare<1>();
+    const Result three = compare<3>();
+    Bench::keep(frames);
+
+    std::printf("tick -> DMA -> frame flow (ns per round)\n");
+    std::printf("  %-10s %12s %14s %8s\n", "flows", "coroutine", "state machine", "ratio");
+    std::printf("  %-10d %12.2f %14.2f %8.2f\n", 1, one.coroutine, one.machine, one.coroutine / one.machine);
+    std::printf("  %-10d %12.2f %14.2f %8.2f\n", 3, three.coroutine, three.machine, three.coroutine / three.machine);
+
+    CHECK(one.coroutine <= one.machine * MAX_RATIO);
+    CHECK(three.coroutine <= three.machine * MAX_RATIO);
+    return 0;
+}
@@ -0,0 +1,59 @@
+/**
+ * 设备端绘图图元基准测试：光栅化一次的耗时
+ *
+ * 分别以默认的 5x5 和 40x25 (1000 颗灯珠) 编译。
+ * 每次调用的颜色都不同，像素总会真正改写并置脏；「setPixel x LED_COUNT」一行是逐像素写满整帧的开销，
+ * 即 APP 不用图元、自己拆成 SetPixel 时 MCU 上至少要做的工作 (不含协议解析)。
+ */
+
+#include <cstdio>
+
+#include "draw.hpp"
+#include "test_support.hpp"
+
+namespace {
+    auto &strip = WS2812B::getInstance();
+
+    constexpr int16_t W = WS2812B::WIDTH;
+    constexpr int16_t H = WS2812B::HEIGHT;
+
+    constexpr Draw::Rgb color(const unsigned i) {
+        return {static_cast<uint8_t>(i), static_cast<uint8_t>(i * 3), static_cast<uint8_t>(i * 7)};
+    }
+
+    template<typename Fn>
+    void row(const char *name, Fn &&draw) {
+        const double ns = Bench::nsPerCall(20'000, [&](const unsigned i) {
+            draw(i);
+            Bench::keep(strip);
+        });
+        std::printf("  %-22s %12.0f %12.2f\n", name, ns, ns / WS2812B::LED_COUNT);
+    }
+} // namespace
+
+int main() {
+    std::printf("Draw primitives, %u LEDs (ns per call)\n", WS2812B::LED_COUNT);
+    std::printf("  %-22s %12s %12s\n", "primitive", "ns/call", "ns/LED");
+    row("fillRect (full)", [](const unsigned i) { Draw::fillRect(strip, 0, 0, W, H, color(i)); });
+    row("fillRect (clipped)", [](const unsigned i) { Draw::fillRect(strip, -W / 2, -H / 2, W, H, color(i)); });
+    row("line (diagonal)", [](const unsigned i) { Draw::line(strip, 0, 0, W - 1, H - 1, color(i)); });
+    row("line (clipped)", [](const unsigned i) { Draw::line(strip, -W, H / 2, 2 * W, H / 2, color(i)); });
+    row("linearGradient", [](const unsigned i) {
+        Draw::linearGradient(strip, 0, 0, W - 1, H - 1, color(i), color(i + 128));
+    });
+    row("radialGradient", [](const unsigned i) {
+        Draw::radialGradient(strip, W / 2, H / 2, W / 2, color(i), color(i + 128));
+    });
+    row("shift (wrap)", [](unsigned) { Draw::shift(strip, 1, 1, true); });
+    row("shift (fill black)", [](const unsigned i) {
+        Draw::shift(strip, 1, 0, false);
+        Draw::fillRect(strip, 0, 0, 1, H, color(i)); // 补上一列，下一次平移仍有内容
+    });
+    row("setPixel x LED_COUNT", [](const unsigned i) {
+        const Draw::Rgb c = color(i);
+        for (uint8_t y = 0; y < H; ++y) {
+            for (uint8_t x = 0; x < W; ++x) strip.setPixel(x, y, c.r, c.g, c.b);
+        }
+    });
+    return 0;
+}
@@ -0,0 +1,47 @@
+/**
+ * 火焰效果基准测试：计算并写入一帧的耗时
+ *
+ * 分别以默认的 5x5 和 40x25 (1000 颗灯珠) 编译。
+ * 每帧包括逐格冷却、热量上移、每列一次噪声采样决定是否产生火星、查表上色写入帧缓冲；
+ * 几组参数分别对应默认、关闭噪声调制、矮火焰 (冷却强) 和满屏火星。
+ */
+
+#include <cstdio>
+
+#include "fire_effect.hpp"
+#include "test_support.hpp"
+
+namespace {
+    auto &strip = WS2812B::getInstance();
+
+    double frame(const uint8_t cooling, const uint8_t sparking, const uint8_t flicker) {
+        FireEffect fire;
+        const uint8_t params[] = {cooling, sparking, flicker};
+        CHECK(fire.setParams(0, params));
+        fire.enter(strip);
+        // 先烧一会儿，让热量分布稳定下来再计时
+        for (uint32_t t = 0; t < 200 * 16; t += 16) fire.update(t, strip);
+        return Bench::nsPerCall(50'000, [&](const unsigned i) { fire.update(3200 + i * 16, strip); });
+    }
+} // namespace
+
+int main() {
+    struct Case {
+        const char *name;
+        uint8_t cooling, sparking, flicker;
+    };
+    const Case cases[] = {
+        {"default", 80, 120, 160},
+        {"no flicker", 80, 120, 0},
+        {"short", 200, 120, 160},
+        {"all sparks", 20, 255, 160},
+    };
+
+    std::printf("Fire, %u LEDs (ns per frame)\n", WS2812B::LED_COUNT);
+    std::printf("  %-12s %12s %12s\n", "params", "ns/frame", "ns/LED");
+    for (const Case &c : cases) {
+        const double ns = frame(c.cooling, c.sparking, c.flicker);
+        std::printf("  %-12s %12.0f %12.2f\n", c.name, ns, ns / WS2812B::LED_COUNT);
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * 关键帧插值基准测试：每个帧节拍插出一帧中间帧的耗时
+ *
+ * 分别以默认的 5x5 和 40x25 (1000 颗灯珠) 编译。
+ * 每种缓动曲线播放一段很长的关键帧，t 在段内递增，测 KeyframeEffect::update() 的耗时
+ * (求 alpha、逐通道插值、写入帧缓冲)；「停留」一行是关键帧播完后停在最后一帧时的开销。
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "keyframe_effect.hpp"
+#include "test_support.hpp"
+
+namespace {
+    auto &strip = WS2812B::getInstance();
+    auto &keyframes = KeyframeEffect::getInstance();
+
+    constexpr uint16_t SEGMENT_MS = 60'000;
+    constexpr unsigned ITERATIONS = 20'000;
+
+    std::vector<uint8_t> pattern(const uint8_t seed) {
+        std::vector<uint8_t> pixels(WS2812B::LED_COUNT * 3);
+        for (size_t i = 0; i < pixels.size(); ++i) pixels[i] = static_cast<uint8_t>(i * 37 + seed * 101);
+        return pixels;
+    }
+
+    double tween(const Easing::Curve curve) {
+        keyframes.flush();
+        keyframes.enter(strip);
+        CHECK(keyframes.push(pattern(1), SEGMENT_MS, curve));
+
+        static uint32_t t = 0;
+        t += SEGMENT_MS; // 新的一段从当前时刻开始
+        keyframes.update(t, strip);
+        const uint32_t start = t;
+        // t 每次前进 2 ms，整段 60 s 内不会播完
+        return Bench::nsPerCall(ITERATIONS, [start](const unsigned i) { keyframes.update(start + 2 * i, strip); });
+    }
+
+    double hold() {
+        // 上一段的 t 已经远超段长：队列为空，停在最后一个关键帧上
+        static uint32_t t = 10'000'000;
+        return Bench::nsPerCall(ITERATIONS, [](const unsigned i) { keyframes.update(t + i, strip); });
+    }
+} // namespace
+
+int main() {
+    const char *names[] = {"linear", "ease in", "ease out", "ease in-out"};
+
+    std::printf("Keyframe tween, %u LEDs\n", WS2812B::LED_COUNT);
+    std::printf("  %-12s %12s %12s\n", "curve", "ns/frame", "ns/LED");
+    for (uint8_t curve = 0; curve < static_cast<uint8_t>(Easing::Curve::COUNT); ++curve) {
+        const double ns = tween(static_cast<Easing::Curve>(curve));
+        std::printf("  %-12s %12.0f %12.2f\n", names[curve], ns, ns / WS2812B::LED_COUNT);
+    }
+    const double ns = hold();
+    std::printf("  %-12s %12.0f %12.2f\n", "hold", ns, ns / WS2812B::LED_COUNT);
+    return 0;
+}
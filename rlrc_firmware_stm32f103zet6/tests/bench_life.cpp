@@ -0,0 +1,65 @@
+/**
+ * 位棋盘元胞自动机基准测试：计算一代的耗时
+ *
+ * 与逐个细胞数邻居的朴素实现对比；宽度从一个字到多个字，看每 32 个细胞的开销。
+ * 最后一行是 LifeEffect 在当前点阵尺寸上的一帧 (计算一代、检测停滞、按存活代数着色写入帧缓冲)。
+ */
+
+#include <cstdio>
+
+#include "life.hpp"
+#include "life_effect.hpp"
+#include "life_reference.hpp"
+#include "test_support.hpp"
+
+namespace {
+    template<uint8_t W, uint8_t H>
+    void row(const bool wrap) {
+        Life::Board<W, H> board;
+        NaiveLife<W, H> naive;
+        uint32_t state = 1;
+        for (uint8_t y = 0; y < H; ++y) {
+            for (uint8_t x = 0; x < W; ++x) {
+                state = state * 1103515245u + 12345u;
+                board.set(x, y, (state >> 16) % 3 == 0);
+                naive.set(x, y, (state >> 16) % 3 == 0);
+            }
+        }
+
+        // 用 B36/S23 让画面一直有变化，不会很快死光
+        constexpr Life::Rule RULE{(1u << 3) | (1u << 6), (1u << 2) | (1u << 3)};
+        const double packed = Bench::nsPerCall(200'000, [&](unsigned) {
+            board.step(RULE, wrap);
+            Bench::keep(board);
+        });
+        const double simple = Bench::nsPerCall(20'000, [&](unsigned) {
+            naive.step(RULE, wrap);
+            Bench::keep(naive);
+        });
+
+        char size[16];
+        std::snprintf(size, sizeof(size), "%ux%u", W, H);
+        std::printf("  %-7s %-5s %10.0f %10.0f %8.1fx %10.2f\n", size, wrap ? "wrap" : "edge", packed, simple,
+                    simple / packed, packed / W / H);
+    }
+} // namespace
+
+int main() {
+    std::printf("Life step (ns per generation)\n");
+    std::printf("  %-7s %-5s %10s %10s %9s %10s\n", "size", "edge", "bitboard", "naive", "speedup", "ns/cell");
+    for (const bool wrap : {true, false}) {
+        row<5, 5>(wrap);
+        row<32, 32>(wrap);
+        row<40, 25>(wrap);
+        row<64, 16>(wrap);
+        row<100, 10>(wrap);
+    }
+
+    // 每次 update 都满一代的时长，每帧都计算新的一代
+    auto &strip = WS2812B::getInstance();
+    LifeEffect life;
+    life.enter(strip);
+    const double ns = Bench::nsPerCall(100'000, [&](const unsigned i) { life.update(i * 1000u, strip); });
+    std::printf("\nLifeEffect, %u LEDs (ns per frame)\n  %10.0f\n", WS2812B::LED_COUNT, ns);
+    return 0;
+}
@@ -0,0 +1,37 @@
+/**
+ * 定点噪声基准测试：每个采样的耗时
+ *
+ * 按 1000 颗灯珠、每颗一个采样换算出一帧的耗时，判断整屏逐像素噪声能跑多少 FPS。
+ */
+
+#include <cstdio>
+
+#include "noise.hpp"
+#include "test_support.hpp"
+
+namespace {
+    using Fixed::q16;
+
+    // 坐标每次都不同，避免命中相同的格点
+    constexpr q16 coord(const unsigned i, const unsigned salt) {
+        return static_cast<q16>((i * 40503u + salt * 9973u) & 0xFFFFFF);
+    }
+
+    template<typename Fn>
+    void row(const char *name, Fn &&fn) {
+        q16 sink = 0;
+        const double ns = Bench::nsPerCall(2'000'000, [&](const unsigned i) { sink += fn(i); });
+        Bench::keep(sink);
+        std::printf("  %-18s %10.1f %14.1f\n", name, ns, ns);
+    }
+} // namespace
+
+int main() {
+    std::printf("Fixed-point noise (per sample)\n");
+    std::printf("  %-18s %10s %14s\n", "function", "ns", "us/1000 LEDs");
+    row("valueNoise (2D)", [](const unsigned i) { return Fixed::valueNoise(coord(i, 1), coord(i, 2)); });
+    row("perlin2", [](const unsigned i) { return Noise::perlin2(coord(i, 1), coord(i, 2)); });
+    row("perlin3", [](const unsigned i) { return Noise::perlin3(coord(i, 1), coord(i, 2), coord(i, 3)); });
+    row("fbm3, 3 octaves", [](const unsigned i) { return Noise::fbm3(coord(i, 1), coord(i, 2), coord(i, 3), 3); });
+    return 0;
+}
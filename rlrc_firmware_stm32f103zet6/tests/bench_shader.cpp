@@ -0,0 +1,104 @@
+/**
+ * 着色管线基准测试：Shader::Pipeline 与等价的手写循环
+ *
+ * 扩散 (Centered -> RadialWave -> HueCycle) 与等离子 (Cartesian -> Plasma -> Rainbow -> Brightness)
+ * 各写一份逐像素计算完全相同的手写版本，先检查两者画出的帧完全相同，再分别计时。
+ * 分别以默认的 5x5 和 40x25 (1000 颗灯珠) 编译。
+ */
+
+#include <cstdio>
+
+#include "shader.hpp"
+#include "test_support.hpp"
+
+namespace {
+    using Fixed::q16;
+    using Params = std::array<uint8_t, Effect::MAX_PARAMS>;
+
+    auto &strip = WS2812B::getInstance();
+
+    constexpr Params DIFFUSION_PARAMS{5, 100, 255};
+    constexpr Params PLASMA_PARAMS{3, 20, 200};
+
+    using DiffusionShader = Shader::Pipeline<Shader::Centered, Shader::RadialWave<0>, Shader::HueCycle<1, 2>>;
+    using PlasmaShader =
+            Shader::Pipeline<Shader::Cartesian, Shader::Plasma<0>, Shader::Rainbow<1>, Shader::Brightness<2>>;
+
+    void handDiffusion(const uint32_t t, const Params &params, WS2812B &fb) {
+        const q16 phase = Shader::detail::phaseTurns(t, params[0]);
+        const Color::Rgb base = Color::hsv(static_cast<uint8_t>(static_cast<uint64_t>(t) * params[1] / 1000 % 255),
+                                           params[2], 255);
+
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; y++) {
+            for (uint8_t x = 0; x < WS2812B::WIDTH; x++) {
+                const q16 px = (2 * x - (WS2812B::WIDTH - 1)) * Fixed::HALF;
+                const q16 py = (2 * y - (WS2812B::HEIGHT - 1)) * Fixed::HALF;
+                const q16 dist = Fixed::sqrt(Fixed::mul(px, px) + Fixed::mul(py, py));
+                const uint8_t value = Fixed::toByte(Fixed::sinTurns(Fixed::mul(dist, Fixed::INV_TWO_PI) - phase));
+                fb.setPixel(x, y, Color::scale8(base.r, value), Color::scale8(base.g, value),
+                            Color::scale8(base.b, value));
+            }
+        }
+    }
+
+    void handPlasma(const uint32_t t, const Params &params, WS2812B &fb) {
+        const q16 phase = Shader::detail::phaseTurns(t, params[0]);
+        const auto offset = static_cast<uint8_t>(static_cast<uint64_t>(t) * params[1] / 1000);
+        const uint8_t level = params[2];
+        constexpr q16 K = Fixed::fromDouble(1.0 / 6);
+
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; y++) {
+            for (uint8_t x = 0; x < WS2812B::WIDTH; x++) {
+                const q16 u = Fixed::mul(Fixed::fromInt(x), K);
+                const q16 v = Fixed::mul(Fixed::fromInt(y), K);
+                const q16 dist = Fixed::sqrt(Fixed::mul(u, u) + Fixed::mul(v, v));
+                const q16 sum = Fixed::sinTurns(u + phase) + Fixed::sinTurns(v - phase) +
+                                Fixed::sinTurns((u + v) / 2 + phase / 2) + Fixed::sinTurns(dist + phase);
+                const q16 field = (sum / 4 + Fixed::ONE) / 2;
+                const Color::Rgb c = Color::HUE_LUT[static_cast<uint8_t>((field >> 8) + offset)];
+                fb.setPixel(x, y, Color::scale8(c.r, level), Color::scale8(c.g, level), Color::scale8(c.b, level));
+            }
+        }
+    }
+
+    // 两种写法在若干时刻画出的帧必须逐像素相同
+    template<typename ShaderFn, typename HandFn>
+    void checkSame(ShaderFn shader, HandFn hand) {
+        for (uint32_t t = 0; t < 100'000; t += 7'777) {
+            shader(t);
+            std::array<std::array<uint8_t, 3>, WS2812B::LED_COUNT> expected{};
+            for (uint16_t i = 0; i < WS2812B::LED_COUNT; ++i) {
+                expected[i] = strip.getPixel(i % WS2812B::WIDTH, i / WS2812B::WIDTH);
+            }
+            hand(t);
+            for (uint16_t i = 0; i < WS2812B::LED_COUNT; ++i) {
+                CHECK(strip.getPixel(i % WS2812B::WIDTH, i / WS2812B::WIDTH) == expected[i]);
+            }
+        }
+    }
+
+    template<typename ShaderFn, typename HandFn>
+    void compare(const char *name, ShaderFn shader, HandFn hand) {
+        checkSame(shader, hand);
+        // 交替测两遍，减小频率变化等带来的偏差
+        const double shader_a = Bench::nsPerCall(5'000, [&](const unsigned i) { shader(i * 3); });
+        const double hand_a = Bench::nsPerCall(5'000, [&](const unsigned i) { hand(i * 3); });
+        const double shader_b = Bench::nsPerCall(5'000, [&](const unsigned i) { shader(i * 3); });
+        const double hand_b = Bench::nsPerCall(5'000, [&](const unsigned i) { hand(i * 3); });
+        const double shader_ns = std::min(shader_a, shader_b);
+        const double hand_ns = std::min(hand_a, hand_b);
+        std::printf("  %-10s %12.0f %12.0f %8.2f\n", name, shader_ns, hand_ns, shader_ns / hand_ns);
+    }
+} // namespace
+
+int main() {
+    std::printf("Shader pipeline vs hand-written loop, %u LEDs (ns per frame)\n", WS2812B::LED_COUNT);
+    std::printf("  %-10s %12s %12s %8s\n", "effect", "pipeline", "hand", "ratio");
+    compare(
+            "diffusion", [](const uint32_t t) { DiffusionShader::render({t, DIFFUSION_PARAMS}, strip); },
+            [](const uint32_t t) { handDiffusion(t, DIFFUSION_PARAMS, strip); });
+    compare(
+            "plasma", [](const uint32_t t) { PlasmaShader::render({t, PLASMA_PARAMS}, strip); },
+            [](const uint32_t t) { handPlasma(t, PLASMA_PARAMS, strip); });
+    return 0;
+}
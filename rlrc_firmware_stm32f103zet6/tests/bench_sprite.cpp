@@ -0,0 +1,82 @@
+/**
+ * 精灵合成基准测试：blit() 一次的耗时
+ *
+ * 分别以默认的 5x5 和 40x25 (1000 颗灯珠) 编译。
+ * 单个 8x8 精灵在各种模式 (不透明、翻转、关键色、半透明、部分裁剪、先清屏) 下的耗时，
+ * 以及用 8x8 精灵铺满整帧与逐像素 setPixel 写满整帧的对比。
+ * 精灵的位置每次都变，像素总会真正改写并置脏。
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "sprite_table.hpp"
+#include "test_support.hpp"
+
+namespace {
+    auto &strip = WS2812B::getInstance();
+    auto &sprites = SpriteTable::getInstance();
+
+    constexpr int16_t W = WS2812B::WIDTH;
+    constexpr int16_t H = WS2812B::HEIGHT;
+    constexpr uint8_t SIZE = SpriteTable::MAX_SIZE;
+
+    enum : uint8_t { OPAQUE = 0, KEYED = 1 };
+
+    void upload() {
+        std::vector<uint8_t> pixels(SIZE * SIZE * 3);
+        for (size_t i = 0; i < pixels.size(); ++i) pixels[i] = static_cast<uint8_t>(i * 7 + 1);
+        // 每隔几个像素放一个关键色 (黑色)，约 1/4 透明
+        for (size_t i = 0; i < pixels.size(); i += 12) pixels[i] = pixels[i + 1] = pixels[i + 2] = 0;
+
+        constexpr Color::Rgb key{0, 0, 0};
+        CHECK(sprites.upload(OPAQUE, SIZE, SIZE, nullptr, pixels) == SpriteTable::ErrorCode::NONE);
+        CHECK(sprites.upload(KEYED, SIZE, SIZE, &key, pixels) == SpriteTable::ErrorCode::NONE);
+    }
+
+    template<typename Fn>
+    void row(const char *name, Fn &&draw) {
+        const double ns = Bench::nsPerCall(50'000, [&](const unsigned i) {
+            draw(i);
+            Bench::keep(strip);
+        });
+        std::printf("  %-24s %12.0f\n", name, ns);
+    }
+
+    // 在 (0, 0)、(1, 0)、(2, 0) 之间来回移动，5x5 上也总是部分可见
+    constexpr int16_t step(const unsigned i) { return static_cast<int16_t>(i % 3); }
+} // namespace
+
+int main() {
+    upload();
+
+    std::printf("Sprite blit, %u LEDs (ns per call)\n", WS2812B::LED_COUNT);
+    std::printf("  %-24s %12s\n", "8x8 sprite", "ns/blit");
+    row("opaque", [](const unsigned i) { sprites.blit(strip, OPAQUE, step(i), 0, 0, 255); });
+    row("opaque, flip x+y", [](const unsigned i) {
+        sprites.blit(strip, OPAQUE, step(i), 0, SpriteTable::FLIP_X | SpriteTable::FLIP_Y, 255);
+    });
+    row("color key", [](const unsigned i) { sprites.blit(strip, KEYED, step(i), 0, 0, 255); });
+    row("alpha 128", [](const unsigned i) { sprites.blit(strip, OPAQUE, step(i), 0, 0, 128); });
+    row("half off-screen", [](const unsigned i) {
+        sprites.blit(strip, OPAQUE, static_cast<int16_t>(step(i) - SIZE / 2), -SIZE / 2, 0, 255);
+    });
+    row("clear first", [](const unsigned i) {
+        sprites.blit(strip, OPAQUE, step(i), 0, SpriteTable::CLEAR_FIRST, 255);
+    });
+
+    std::printf("\n  %-24s %12s\n", "full frame", "ns/frame");
+    row("8x8 tiles", [](const unsigned i) {
+        for (int16_t y = 0; y < H; y += SIZE) {
+            for (int16_t x = 0; x < W; x += SIZE) {
+                sprites.blit(strip, OPAQUE, static_cast<int16_t>(x - step(i)), y, 0, 255);
+            }
+        }
+    });
+    row("setPixel x LED_COUNT", [](const unsigned i) {
+        for (uint8_t y = 0; y < H; ++y) {
+            for (uint8_t x = 0; x < W; ++x) strip.setPixel(x, y, static_cast<uint8_t>(i), 2, 3);
+        }
+    });
+    return 0;
+}
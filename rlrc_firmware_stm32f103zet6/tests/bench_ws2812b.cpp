@@ -0,0 +1,53 @@
+/**
+ * 编码器基准测试：时间抖动的额外编码开销
+ *
+ * 分别以默认的 5x5 和 -DLED_MATRIX_WIDTH=40 -DLED_MATRIX_HEIGHT=25 (1000 颗灯珠) 编译。
+ * - 整帧变化：每帧所有灯珠都换颜色，关闭/开启抖动
+ * - 静止画面：关闭抖动时 render() 直接跳过；开启抖动时带小数部分的灯珠每帧都要重新编码
+ * 预算参考：主循环的帧节拍为 100 FPS，编码应只占 10 ms 帧周期的一小部分。
+ */
+
+#include <cstdio>
+
+#include "test_support.hpp"
+#include "ws2812b.hpp"
+
+namespace {
+    auto &strip = WS2812B::getInstance();
+
+    void renderFrame() {
+        strip.render();
+        strip.on_dma_transfer_complete();
+    }
+
+    double changingFrames(const bool dithering) {
+        strip.setDithering(dithering);
+        return Bench::nsPerCall(2000, [](const unsigned i) {
+            strip.setAll(static_cast<uint8_t>(i), static_cast<uint8_t>(i * 3), static_cast<uint8_t>(i * 7));
+            renderFrame();
+        });
+    }
+
+    double staticFrame(const bool dithering) {
+        strip.setDithering(dithering);
+        strip.setAll(40, 90, 140); // 校正值都带小数部分
+        renderFrame();
+        return Bench::nsPerCall(2000, [](unsigned) { renderFrame(); });
+    }
+} // namespace
+
+int main() {
+    strip.setPowerBudget(0);
+
+    const double change_off = changingFrames(false);
+    const double change_on = changingFrames(true);
+    const double static_off = staticFrame(false);
+    const double static_on = staticFrame(true);
+
+    std::printf("WS2812B encode, %u LEDs (ns per render)\n", WS2812B::LED_COUNT);
+    std::printf("  %-26s %10s %10s %10s\n", "", "no dither", "dither", "extra");
+    std::printf("  %-26s %10.0f %10.0f %10.0f\n", "all LEDs change", change_off, change_on, change_on - change_off);
+    std::printf("  %-26s %10.0f %10.0f %10.0f\n", "static frame", static_off, static_on, static_on - static_off);
+    std::printf("  dither cost per LED per frame: %.1f ns\n", static_on / WS2812B::LED_COUNT);
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "host_hal.hpp"
+
+#include <cstring>
+
+#include "main.h"
+
+namespace {
+    uint32_t tick = 0;
+    uint32_t dma_starts = 0;
+    const uint16_t *dma_buffer = nullptr;
+    TIM_TypeDef tim1{}; // __HAL_TIM_SET_AUTORELOAD 会写入 ARR
+
+    // 模拟的 CLIPS 区域，大小与链接脚本一致；HAL 的 Flash 地址是 32 位的，使用它的测试以非 PIE 方式链接
+    constexpr uint32_t CLIPS_SIZE = 256 * 1024;
+    bool flash_locked = true;
+    uint32_t flash_erases = 0;
+} // namespace
+
+// 链接脚本中 CLIPS 区域的起止地址
+extern "C" {
+alignas(FLASH_PAGE_SIZE) uint8_t _sclips[CLIPS_SIZE];
+}
+asm(".globl _eclips\n.set _eclips, _sclips + 262144");
+static_assert(CLIPS_SIZE == 262144, "与 _eclips 的定义一致");
+
+TIM_HandleTypeDef htim1 = [] {
+    TIM_HandleTypeDef handle{};
+    handle.Instance = &tim1;
+    return handle;
+}();
+
+extern "C" uint32_t HAL_GetTick(void) { return tick; }
+
+extern "C" HAL_StatusTypeDef HAL_TIM_PWM_Start_DMA(TIM_HandleTypeDef *, uint32_t, const uint32_t *data, uint16_t) {
+    dma_starts++;
+    dma_buffer = reinterpret_cast<const uint16_t *>(data);
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_FLASH_Unlock(void) {
+    flash_locked = false;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_FLASH_Lock(void) {
+    flash_locked = true;
+    return HAL_OK;
+}
+
+// 与真实的 Flash 一样：按页擦除为 0xFF，只有擦除过的半字才能编程
+extern "C" HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *erase, uint32_t *page_error) {
+    const uintptr_t base = reinterpret_cast<uintptr_t>(_sclips);
+    const uintptr_t address = erase->PageAddress;
+    if (flash_locked || address < base || address + erase->NbPages * FLASH_PAGE_SIZE > base + CLIPS_SIZE ||
+        (address - base) % FLASH_PAGE_SIZE != 0) {
+        *page_error = erase->PageAddress;
+        return HAL_ERROR;
+    }
+    std::memset(&_sclips[address - base], 0xFF, erase->NbPages * FLASH_PAGE_SIZE);
+    flash_erases += erase->NbPages;
+    *page_error = 0xFFFFFFFF;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_FLASH_Program(const uint32_t type, const uint32_t address, const uint64_t data) {
+    const uintptr_t base = reinterpret_cast<uintptr_t>(_sclips);
+    if (flash_locked || type != FLASH_TYPEPROGRAM_HALFWORD || address < base || address + 2 > base + CLIPS_SIZE ||
+        address % 2 != 0) {
+        return HAL_ERROR;
+    }
+    uint8_t *cell = &_sclips[address - base];
+    if (cell[0] != 0xFF || cell[1] != 0xFF) return HAL_ERROR;
+    cell[0] = static_cast<uint8_t>(data);
+    cell[1] = static_cast<uint8_t>(data >> 8);
+    return HAL_OK;
+}
+
+namespace HostHal {
+    void setTick(const uint32_t ms) { tick = ms; }
+
+    void advanceTick(const uint32_t ms) { tick += ms; }
+
+    uint32_t dmaStartCount() { return dma_starts; }
+
+    const uint16_t *lastDmaBuffer() { return dma_buffer; }
+
+    std::span<uint8_t> clipsFlash() { return _sclips; }
+
+    uint32_t flashEraseCount() { return flash_erases; }
+} // namespace HostHal
@@ -0,0 +1,41 @@
+/**
+ * 主机测试用的 HAL 桩
+ *
+ * HAL_GetTick() 返回一个由测试控制的模拟时钟；HAL_TIM_PWM_Start_DMA() 不做传输，
+ * 只记下最近一次启动时的缓冲区，测试可以从中解码出实际发送的码元。
+ * Flash 的擦除与编程作用在一块 RAM 中模拟的 CLIPS 区域上 (_sclips/_eclips)，行为与 F1 相同：
+ * 按 2 KB 页擦除为 0xFF，只能按半字编程已擦除的位置。
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+
+namespace HostHal {
+    /**
+     * @brief 设置 HAL_GetTick() 的返回值 (ms)
+     */
+    void setTick(uint32_t ms);
+
+    void advanceTick(uint32_t ms);
+
+    /**
+     * @brief HAL_TIM_PWM_Start_DMA() 被调用的次数
+     */
+    uint32_t dmaStartCount();
+
+    /**
+     * @brief 最近一次 HAL_TIM_PWM_Start_DMA() 传入的缓冲区 (码元为 uint16_t)
+     */
+    const uint16_t *lastDmaBuffer();
+
+    /**
+     * @brief 模拟的 CLIPS 区域，测试可以直接查看或改写其中的字节
+     */
+    std::span<uint8_t> clipsFlash();
+
+    /**
+     * @brief HAL_FLASHEx_Erase() 累计擦除的页数
+     */
+    uint32_t flashEraseCount();
+} // namespace HostHal
@@ -0,0 +1,45 @@
+/**
+ * 元胞自动机的朴素参考实现：逐个细胞数 8 个邻居
+ *
+ * 用来核对 Life::Board 的位运算结果，并作为基准测试中的对照。
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "life.hpp"
+
+template<uint8_t WIDTH, uint8_t HEIGHT>
+struct NaiveLife {
+    std::array<uint8_t, WIDTH * HEIGHT> cells{};
+
+    [[nodiscard]] bool get(const int x, const int y) const { return cells[y * WIDTH + x] != 0; }
+
+    void set(const int x, const int y, const bool alive) { cells[y * WIDTH + x] = alive ? 1 : 0; }
+
+    void step(const Life::Rule rule, const bool wrap) {
+        std::array<uint8_t, WIDTH * HEIGHT> next{};
+        for (int y = 0; y < HEIGHT; ++y) {
+            for (int x = 0; x < WIDTH; ++x) {
+                unsigned neighbours = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        if (dx == 0 && dy == 0) continue;
+                        int nx = x + dx, ny = y + dy;
+                        if (wrap) {
+                            nx = (nx + WIDTH) % WIDTH;
+                            ny = (ny + HEIGHT) % HEIGHT;
+                        } else if (nx < 0 || nx >= WIDTH || ny < 0 || ny >= HEIGHT) {
+                            continue;
+                        }
+                        neighbours += get(nx, ny);
+                    }
+                }
+                const uint16_t mask = get(x, y) ? rule.survive : rule.birth;
+                next[y * WIDTH + x] = (mask >> neighbours) & 1u;
+            }
+        }
+        cells = next;
+    }
+};
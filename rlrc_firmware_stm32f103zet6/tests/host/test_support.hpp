@@ -0,0 +1,42 @@
+/**
+ * 主机测试的公共工具：断言与计时
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @brief 条件不成立时打印位置并以失败状态退出
+ */
+#define CHECK(condition)                                                                                               \
+    do {                                                                                                               \
+        if (!(condition)) {                                                                                            \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);                                  \
+            std::exit(1);                                                                                              \
+        }                                                                                                              \
+    } while (0)
+
+namespace Bench {
+    /**
+     * @brief 阻止编译器把结果优化掉
+     */
+    template<typename T>
+    void keep(const T &value) {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    /**
+     * @brief 重复运行 fn (先预热)，返回每次调用的平均耗时 (ns)
+     */
+    template<typename Fn>
+    double nsPerCall(const unsigned iterations, Fn &&fn) {
+        for (unsigned i = 0; i < iterations / 10 + 1; ++i) fn(i);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < iterations; ++i) fn(i);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    }
+} // namespace Bench
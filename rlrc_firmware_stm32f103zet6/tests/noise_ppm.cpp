@@ -0,0 +1,50 @@
+/**
+ * 把定点噪声画成 PPM 图片，用肉眼检查质量 (格点痕迹、方向性、倍频程叠加效果)
+ *
+ * 用法：noise_ppm [输出目录]
+ * 生成 perlin2.ppm、perlin3.ppm (z = 0.5 的切片)、fbm3.ppm (4 个倍频程)，各 512x256，每 64 像素一个噪声格。
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "noise.hpp"
+
+namespace {
+    using Fixed::q16;
+
+    constexpr int WIDTH = 512;
+    constexpr int HEIGHT = 256;
+    constexpr q16 PIXEL = Fixed::ONE / 64;
+
+    template<typename Fn>
+    bool write(const std::string &path, Fn &&sample) {
+        FILE *file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            std::printf("cannot open %s\n", path.c_str());
+            return false;
+        }
+
+        std::fprintf(file, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+        for (int y = 0; y < HEIGHT; ++y) {
+            for (int x = 0; x < WIDTH; ++x) {
+                // [-1, 1] -> 0-255 的灰度
+                const q16 n = sample(x * PIXEL, y * PIXEL);
+                const uint8_t gray = Fixed::toByte((n + Fixed::ONE) / 2);
+                const uint8_t rgb[3] = {gray, gray, gray};
+                std::fwrite(rgb, 1, sizeof(rgb), file);
+            }
+        }
+        std::fclose(file);
+        std::printf("wrote %s\n", path.c_str());
+        return true;
+    }
+} // namespace
+
+int main(const int argc, char **argv) {
+    const std::string dir = argc > 1 ? std::string(argv[1]) + "/" : "";
+    bool ok = write(dir + "perlin2.ppm", [](const q16 x, const q16 y) { return Noise::perlin2(x, y); });
+    ok &= write(dir + "perlin3.ppm", [](const q16 x, const q16 y) { return Noise::perlin3(x, y, Fixed::HALF); });
+    ok &= write(dir + "fbm3.ppm", [](const q16 x, const q16 y) { return Noise::fbm3(x, y, Fixed::HALF, 4); });
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+/**
+ * 字节码虚拟机：程序检查的边界与算术的边界情况
+ *
+ * 以 UBSan/ASan 编译：满长程序越界写、INT32_MIN % -1、有符号溢出等都会直接报错退出。
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "bytecode_vm.hpp"
+#include "test_support.hpp"
+
+namespace {
+    using Fixed::q16;
+    using Op = BytecodeVm::Op;
+
+    constexpr q16 MIN = std::numeric_limits<q16>::min();
+    constexpr q16 MAX = std::numeric_limits<q16>::max();
+
+    struct Program {
+        std::vector<uint8_t> bytes;
+
+        Program &op(const Op op) {
+            bytes.push_back(static_cast<uint8_t>(op));
+            return *this;
+        }
+
+        Program &constant(const q16 value) {
+            op(Op::CONST);
+            uint8_t raw[4];
+            std::memcpy(raw, &value, sizeof(raw));
+            bytes.insert(bytes.end(), raw, raw + 4);
+            return *this;
+        }
+    };
+
+    constexpr BytecodeVm::Inputs INPUTS{.x = Fixed::fromInt(2), .y = Fixed::fromInt(3), .t = 0, .i = 0};
+    constexpr std::array<uint8_t, BytecodeVm::PARAM_COUNT> PARAMS{};
+
+    // 对 a, b 执行一条二元运算，结果作为 R 返回 (G, B 为 0)
+    q16 binary(const Op op, const q16 a, const q16 b) {
+        BytecodeVm vm;
+        Program program;
+        program.constant(a).constant(b).op(op).constant(0).constant(0);
+        CHECK(vm.load(program.bytes) == BytecodeVm::ErrorCode::NONE);
+        return vm.run(INPUTS, PARAMS)[0];
+    }
+
+    q16 unary(const Op op, const q16 a) {
+        BytecodeVm vm;
+        Program program;
+        program.constant(a).op(op).constant(0).constant(0);
+        CHECK(vm.load(program.bytes) == BytecodeVm::ErrorCode::NONE);
+        return vm.run(INPUTS, PARAMS)[0];
+    }
+
+    void testProgramSize() {
+        // 恰好 MAX_PROGRAM_SIZE 字节、没有 END：末尾补的 END 不能写出 code 之外
+        Program full;
+        full.op(Op::X).op(Op::Y).op(Op::I);
+        while (full.bytes.size() + 2 <= BytecodeVm::MAX_PROGRAM_SIZE) full.op(Op::X).op(Op::ADD);
+        while (full.bytes.size() < BytecodeVm::MAX_PROGRAM_SIZE) full.op(Op::ABS);
+        CHECK(full.bytes.size() == BytecodeVm::MAX_PROGRAM_SIZE);
+
+        BytecodeVm vm;
+        CHECK(vm.load(full.bytes) == BytecodeVm::ErrorCode::NONE);
+        const auto rgb = vm.run(INPUTS, PARAMS);
+        CHECK(rgb[0] == Fixed::fromInt(2) && rgb[1] == Fixed::fromInt(3));
+
+        full.op(Op::ABS);
+        CHECK(vm.load(full.bytes) == BytecodeVm::ErrorCode::TOO_LARGE);
+        CHECK(vm.loaded()); // 失败时保留原程序
+
+        Program truncated;
+        truncated.op(Op::X).op(Op::Y).op(Op::CONST).op(Op::X);
+        CHECK(vm.load(truncated.bytes) == BytecodeVm::ErrorCode::TRUNCATED);
+        Program underflow;
+        underflow.op(Op::ADD);
+        CHECK(vm.load(underflow.bytes) == BytecodeVm::ErrorCode::STACK_UNDERFLOW);
+        Program two;
+        two.op(Op::X).op(Op::Y).op(Op::END).op(Op::X);
+        CHECK(vm.load(two.bytes) == BytecodeVm::ErrorCode::BAD_RESULT);
+    }
+
+    void testArithmeticEdges() {
+        CHECK(binary(Op::MOD, MIN, -1) == 0);
+        CHECK(binary(Op::MOD, Fixed::fromInt(7), -1) == 0);
+        CHECK(binary(Op::MOD, Fixed::fromInt(7), 0) == 0);
+        CHECK(binary(Op::MOD, Fixed::fromInt(-7), Fixed::fromInt(3)) == Fixed::fromInt(2));
+        CHECK(binary(Op::MOD, Fixed::fromInt(7), Fixed::fromInt(-3)) == Fixed::fromInt(-2));
+
+        CHECK(binary(Op::DIV, MIN, -1) == MAX);
+        CHECK(binary(Op::DIV, MAX, 1) == MAX);
+        CHECK(binary(Op::DIV, MIN, 1) == MIN);
+        CHECK(binary(Op::DIV, Fixed::fromInt(1), 0) == 0);
+        CHECK(binary(Op::DIV, Fixed::fromInt(3), Fixed::fromInt(-2)) == Fixed::fromDouble(-1.5));
+
+        CHECK(binary(Op::ADD, MAX, 1) == MIN);
+        CHECK(binary(Op::SUB, MIN, 1) == MAX);
+        CHECK(unary(Op::NEG, MIN) == MIN);
+        CHECK(unary(Op::ABS, MIN) == MIN);
+        CHECK(unary(Op::ABS, Fixed::fromInt(-5)) == Fixed::fromInt(5));
+
+        // 极端输入的内建函数同样不能出问题
+        for (const q16 value: {MIN, MAX, -1, 0, 1}) {
+            unary(Op::SIN, value);
+            unary(Op::COS, value);
+            unary(Op::SQRT, value);
+            unary(Op::FLOOR, value);
+            binary(Op::MUL, value, MAX);
+            binary(Op::NOISE, value, MIN);
+        }
+    }
+} // namespace
+
+int main() {
+    testProgramSize();
+    testArithmeticEdges();
+    std::printf("test_bytecode_vm: OK\n");
+    return 0;
+}
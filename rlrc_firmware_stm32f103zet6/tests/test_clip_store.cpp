@@ -0,0 +1,222 @@
+/**
+ * Flash 动画片段：延迟擦除、Header 最后写入、上传的错误检查，以及 RAW/PALETTE 两种格式的解码
+ *
+ * Flash 由 host/hal_stub.cpp 在 RAM 中模拟，擦除与编程的规则与 F1 相同。
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "clip_effect.hpp"
+#include "clip_store.hpp"
+#include "host_hal.hpp"
+#include "test_support.hpp"
+
+namespace {
+    using ErrorCode = ClipStore::ErrorCode;
+    using Format = ClipStore::Format;
+
+    auto &store = ClipStore::getInstance();
+    auto &strip = WS2812B::getInstance();
+
+    constexpr size_t HEADER_SIZE = 16;
+
+    std::span<uint8_t> slotBytes(const uint8_t slot) {
+        return HostHal::clipsFlash().subspan(slot * store.slotSize(), store.slotSize());
+    }
+
+    // 按 chunk 字节分块上传
+    ErrorCode upload(const std::vector<uint8_t> &data, const size_t chunk) {
+        for (size_t offset = 0; offset < data.size(); offset += chunk) {
+            const size_t size = std::min(chunk, data.size() - offset);
+            const ErrorCode error = store.write(offset, std::span(data).subspan(offset, size));
+            if (error != ErrorCode::NONE) return error;
+        }
+        return ErrorCode::NONE;
+    }
+
+    std::vector<uint8_t> pattern(const size_t size, const uint8_t seed) {
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>(seed + i * 7);
+        return data;
+    }
+
+    void testEmptySlot() {
+        CHECK(store.slotSize() == 32 * 1024);
+        for (uint8_t slot = 0; slot < ClipStore::SLOT_COUNT; ++slot) CHECK(!store.clip(slot));
+        CHECK(!store.clip(ClipStore::SLOT_COUNT));
+    }
+
+    // begin() 只擦第一页，后面的页在数据写到时才擦；Header 在 end() 之前保持擦除状态
+    void testLazyEraseAndHeaderLast() {
+        constexpr uint16_t FRAMES = 60; // 60 * 75 字节，跨 3 页
+        const ClipStore::ClipInfo info{Format::RAW, 0, FRAMES, 40};
+        const auto data = pattern(FRAMES * WS2812B::LED_COUNT * 3, 1);
+        const auto slot = slotBytes(2);
+
+        // 第二页中预先留下旧数据，检查它在数据写到之前没有被擦除
+        slot[ClipStore::PAGE_SIZE + 100] = 0x5A;
+
+        const uint32_t erases = HostHal::flashEraseCount();
+        CHECK(store.begin(2, info) == ErrorCode::NONE);
+        CHECK(HostHal::flashEraseCount() == erases + 1);
+        CHECK(slot[ClipStore::PAGE_SIZE + 100] == 0x5A);
+
+        // 写到第一页末尾为止 (Header 占去 16 字节)
+        const size_t first_page = ClipStore::PAGE_SIZE - HEADER_SIZE;
+        CHECK(store.write(0, std::span(data).first(first_page)) == ErrorCode::NONE);
+        CHECK(HostHal::flashEraseCount() == erases + 1);
+        CHECK(slot[ClipStore::PAGE_SIZE + 100] == 0x5A);
+
+        CHECK(store.write(first_page, std::span(data).subspan(first_page, 2)) == ErrorCode::NONE);
+        CHECK(HostHal::flashEraseCount() == erases + 2);
+        CHECK(slot[ClipStore::PAGE_SIZE + 100] == 0xFF);
+
+        CHECK(store.write(first_page + 2, std::span(data).subspan(first_page + 2)) == ErrorCode::NONE);
+        CHECK(HostHal::flashEraseCount() == erases + 3);
+
+        // 数据已经写满，但 Header 还没写，片段仍然无效
+        for (size_t i = 0; i < HEADER_SIZE; ++i) CHECK(slot[i] == 0xFF);
+        CHECK(!store.clip(2));
+
+        CHECK(store.end() == ErrorCode::NONE);
+        const auto clip = store.clip(2);
+        CHECK(clip);
+        CHECK(clip->info.format == Format::RAW && clip->info.frame_count == FRAMES);
+        CHECK(clip->info.frame_period_ms == 40 && clip->info.palette_count == 0);
+        for (size_t i = 0; i < data.size(); ++i) CHECK(slot[HEADER_SIZE + i] == data[i]);
+
+        const auto last = clip->frame(FRAMES - 1);
+        CHECK(last.size() == WS2812B::LED_COUNT * 3u);
+        CHECK(last.data() == &slot[HEADER_SIZE + (FRAMES - 1) * WS2812B::LED_COUNT * 3]);
+        CHECK(clip->frame(FRAMES).empty());
+    }
+
+    // 重新上传时 begin() 立即使旧片段失效；中途放弃的上传不会留下有效片段
+    void testReuploadInvalidates() {
+        CHECK(store.clip(2));
+        CHECK(store.begin(2, {Format::RAW, 0, 1, 10}) == ErrorCode::NONE);
+        CHECK(!store.clip(2));
+        CHECK(store.write(0, pattern(10, 3)) == ErrorCode::NONE);
+
+        // 改为上传另一个槽位，槽位 2 的旧 Header 已被擦除
+        CHECK(store.begin(3, {Format::RAW, 0, 1, 10}) == ErrorCode::NONE);
+        CHECK(!store.clip(2));
+        CHECK(store.end() == ErrorCode::INCOMPLETE);
+    }
+
+    void testUploadErrors() {
+        CHECK(store.begin(ClipStore::SLOT_COUNT, {Format::RAW, 0, 1, 10}) == ErrorCode::INVALID_SLOT);
+        CHECK(store.begin(0, {Format::COUNT, 0, 1, 10}) == ErrorCode::INVALID_CLIP);
+        CHECK(store.begin(0, {Format::RAW, 0, 0, 10}) == ErrorCode::INVALID_CLIP);
+        CHECK(store.begin(0, {Format::PALETTE, 0, 1, 10}) == ErrorCode::INVALID_CLIP);
+        CHECK(store.begin(0, {Format::PALETTE, 257, 1, 10}) == ErrorCode::INVALID_CLIP);
+        const auto too_many = static_cast<uint16_t>(store.slotSize() / (WS2812B::LED_COUNT * 3) + 1);
+        CHECK(store.begin(0, {Format::RAW, 0, too_many, 10}) == ErrorCode::TOO_LARGE);
+
+        CHECK(store.begin(0, {Format::PALETTE, 2, 1, 10}) == ErrorCode::NONE);
+        const auto data = pattern(2 * 3 + WS2812B::LED_COUNT, 5);
+        CHECK(store.write(1, std::span(data).first(4)) == ErrorCode::BAD_OFFSET);
+        CHECK(store.write(0, std::span(data).first(4)) == ErrorCode::NONE);
+        CHECK(store.end() == ErrorCode::INCOMPLETE);
+        const std::vector<uint8_t> extra(data.size(), 0);
+        CHECK(store.write(4, extra) == ErrorCode::OVERFLOW);
+        CHECK(store.write(4, std::span(data).subspan(4)) == ErrorCode::NONE);
+        CHECK(store.end() == ErrorCode::NONE);
+        CHECK(store.end() == ErrorCode::NOT_WRITING);
+        CHECK(store.write(0, data) == ErrorCode::NOT_WRITING);
+        CHECK(store.clip(0));
+    }
+
+    // Header 中的数据长度与参数不符 (例如写坏的 Flash) 时不当作有效片段
+    void testCorruptHeader() {
+        const auto slot = slotBytes(0);
+        const uint8_t saved = slot[12];
+        slot[12] ^= 1; // data_size 的最低字节
+        CHECK(!store.clip(0));
+        slot[12] = saved;
+        CHECK(store.clip(0));
+    }
+
+    // RAW 格式按帧整体拷进帧缓冲，每帧时长到了才换下一帧，循环播放
+    void testRawPlayback() {
+        const auto frames = pattern(2 * WS2812B::LED_COUNT * 3, 9);
+        CHECK(store.begin(4, {Format::RAW, 0, 2, 50}) == ErrorCode::NONE);
+        CHECK(upload(frames, 33) == ErrorCode::NONE);
+        CHECK(store.end() == ErrorCode::NONE);
+
+        auto &effect = ClipEffect::getInstance();
+        CHECK(!effect.play(5, true));
+        CHECK(effect.play(4, true));
+
+        const auto expect = [&](const uint16_t frame) {
+            for (uint16_t i = 0; i < WS2812B::LED_COUNT; ++i) {
+                const auto rgb = strip.getPixel(i % WS2812B::WIDTH, i / WS2812B::WIDTH);
+                const size_t at = (frame * WS2812B::LED_COUNT + i) * 3;
+                CHECK(rgb[0] == frames[at] && rgb[1] == frames[at + 1] && rgb[2] == frames[at + 2]);
+            }
+        };
+        effect.update(1000, strip);
+        expect(0);
+        effect.update(1049, strip);
+        expect(0);
+        effect.update(1050, strip);
+        expect(1);
+        effect.update(1100, strip);
+        expect(0);
+
+        // 不循环时停在最后一帧
+        CHECK(effect.play(4, false));
+        effect.update(2000, strip);
+        expect(0);
+        effect.update(2500, strip);
+        expect(1);
+    }
+
+    // PALETTE 格式逐灯查表，越界的下标显示为黑色
+    // 5x5 下数据为 2 * 3 + 25 = 31 字节，最后一个半字的高字节补 0xFF
+    void testPalettePlayback() {
+        const std::vector<uint8_t> palette{255, 0, 0, 0, 0, 255};
+        std::vector<uint8_t> data = palette;
+        for (uint16_t i = 0; i < WS2812B::LED_COUNT; ++i) data.push_back(static_cast<uint8_t>(i % 3)); // 2 越界
+        CHECK(data.size() == 31);
+
+        CHECK(store.begin(5, {Format::PALETTE, 2, 1, 100}) == ErrorCode::NONE);
+        CHECK(upload(data, 5) == ErrorCode::NONE);
+        CHECK(store.end() == ErrorCode::NONE);
+        CHECK(slotBytes(5)[HEADER_SIZE + 30] == data[30]);
+        CHECK(slotBytes(5)[HEADER_SIZE + 31] == 0xFF);
+
+        const auto clip = store.clip(5);
+        CHECK(clip && clip->info.format == Format::PALETTE && clip->info.palette_count == 2);
+        CHECK(clip->frame(0).size() == WS2812B::LED_COUNT);
+
+        auto &effect = ClipEffect::getInstance();
+        strip.setAll(7, 7, 7);
+        CHECK(effect.play(5, true));
+        effect.update(0, strip);
+        for (uint16_t i = 0; i < WS2812B::LED_COUNT; ++i) {
+            const auto rgb = strip.getPixel(i % WS2812B::WIDTH, i / WS2812B::WIDTH);
+            const uint8_t index = i % 3;
+            if (index < 2) {
+                CHECK(rgb[0] == palette[index * 3] && rgb[1] == palette[index * 3 + 1]);
+                CHECK(rgb[2] == palette[index * 3 + 2]);
+            } else {
+                CHECK(rgb[0] == 0 && rgb[1] == 0 && rgb[2] == 0);
+            }
+        }
+    }
+} // namespace
+
+int main() {
+    testEmptySlot();
+    testLazyEraseAndHeaderLast();
+    testReuploadInvalidates();
+    testUploadErrors();
+    testCorruptHeader();
+    testRawPlayback();
+    testPalettePlayback();
+    std::printf("test_clip_store: OK\n");
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * COBS 编码/解码：文件头的示例、254 字节分段边界，以及编码-解码往返
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "cobs.hpp"
+#include "test_support.hpp"
+
+namespace {
+    // 编码后去掉分界符再原地解码，应得到原始数据
+    std::vector<uint8_t> roundTrip(const std::vector<uint8_t> &input) {
+        std::vector<uint8_t> encoded(input.size() + input.size() / 254 + 2);
+        const size_t length = Cobs::encode(input, encoded);
+        CHECK(length >= 2 && length <= encoded.size());
+        CHECK(encoded[length - 1] == Cobs::TAIL);
+        // 分界符之前不能出现 00
+        for (size_t i = 0; i + 1 < length; ++i) CHECK(encoded[i] != Cobs::TAIL);
+
+        const auto decoded = Cobs::decode(std::span(encoded).first(length - 1));
+        return {decoded.begin(), decoded.end()};
+    }
+
+    void testExample() {
+        const std::vector<uint8_t> input = {0x11, 0x22, 0x00, 0x33, 0x00, 0x44};
+        std::vector<uint8_t> encoded(8);
+        CHECK(Cobs::encode(input, encoded) == 8);
+        CHECK((encoded == std::vector<uint8_t>{0x03, 0x11, 0x22, 0x02, 0x33, 0x02, 0x44, 0x00}));
+        CHECK(roundTrip(input) == input);
+    }
+
+    void testBoundaries() {
+        CHECK(roundTrip({}).empty());
+        CHECK((roundTrip({0x00}) == std::vector<uint8_t>{0x00}));
+        CHECK((roundTrip({0x00, 0x00}) == std::vector<uint8_t>{0x00, 0x00}));
+
+        // 253/254/255 个非零字节附近会触发 0xFF 分段
+        for (const size_t size : {253u, 254u, 255u, 508u, 509u}) {
+            std::vector<uint8_t> input(size);
+            for (size_t i = 0; i < size; ++i) input[i] = static_cast<uint8_t>(i % 255 + 1);
+            CHECK(roundTrip(input) == input);
+
+            input.back() = 0x00;
+            CHECK(roundTrip(input) == input);
+        }
+    }
+
+    void testOutputTooSmall() {
+        const std::vector<uint8_t> input = {0x01, 0x02, 0x03};
+        std::vector<uint8_t> encoded(4);
+        CHECK(Cobs::encode(input, encoded) == 0);
+    }
+}
+
+int main() {
+    testExample();
+    testBoundaries();
+    testOutputTooSmall();
+    std::printf("test_cobs: OK\n");
+    return 0;
+}
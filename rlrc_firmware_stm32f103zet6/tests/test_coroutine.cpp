@@ -0,0 +1,128 @@
+/**
+ * 协程运行时：事件的恢复顺序、就绪条件、数据包事件与帧池耗尽
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "coroutine.hpp"
+#include "test_support.hpp"
+
+namespace {
+    std::vector<int> trace;
+
+    // 测试结束时协程帧被销毁，各测试使用各自的事件，不留下悬空的等待者
+    Coro::Event tick;
+    Coro::Event done;
+    Coro::Event otherTick;
+
+    bool doneReady = false;
+    Coro::Event readyEvent{[] { return doneReady; }};
+
+    Coro::Task waitTwice(const int id) {
+        while (true) {
+            co_await tick;
+            trace.push_back(id);
+            co_await done;
+            trace.push_back(id + 10);
+        }
+    }
+
+    // 多个协程每次都按创建顺序 (帧池槽位) 恢复，与开始等待的先后无关；恢复期间重新挂起的协程留到下一次触发
+    void testResumeOrder() {
+        trace.clear();
+        Coro::Task a = waitTwice(1);
+        Coro::Task b = waitTwice(2);
+        Coro::Task c = waitTwice(3);
+        CHECK(a.valid() && b.valid() && c.valid());
+        c.start();
+        a.start();
+        b.start();
+
+        tick.fire();
+        CHECK((trace == std::vector<int>{1, 2, 3}));
+        tick.fire(); // 都在等 done
+        CHECK(trace.size() == 3);
+
+        done.fire();
+        CHECK((trace == std::vector<int>{1, 2, 3, 11, 12, 13}));
+        for (int round = 0; round < 4; ++round) {
+            trace.clear();
+            tick.fire();
+            done.fire();
+            CHECK((trace == std::vector<int>{1, 2, 3, 11, 12, 13}));
+        }
+    }
+
+    Coro::Task waitReady() {
+        while (true) {
+            co_await readyEvent;
+            trace.push_back(7);
+            co_await otherTick;
+        }
+    }
+
+    // 条件已满足时 co_await 不挂起
+    void testCondition() {
+        trace.clear();
+        doneReady = false;
+        Coro::Task task = waitReady();
+        task.start();
+        CHECK(trace.empty());
+        readyEvent.fire();
+        CHECK(trace.size() == 1);
+
+        doneReady = true;
+        otherTick.fire(); // 返回后 readyEvent 已就绪，直接继续
+        CHECK(trace.size() == 2);
+        otherTick.fire();
+        CHECK(trace.size() == 3);
+    }
+
+    // 需要两个数据包才能完成的协议流程
+    Coro::Task collectPair() {
+        while (true) {
+            co_await Coro::packetAvailable;
+            trace.push_back(20);
+            co_await Coro::packetAvailable;
+            trace.push_back(21);
+        }
+    }
+
+    void testPacketAvailable() {
+        trace.clear();
+        Coro::Task task = collectPair();
+        task.start();
+        CHECK(trace.empty());
+        Coro::packetAvailable.fire();
+        Coro::packetAvailable.fire();
+        Coro::packetAvailable.fire();
+        CHECK((trace == std::vector<int>{20, 21, 20}));
+    }
+
+    Coro::Task idle() {
+        while (true) co_await tick;
+    }
+
+    // 帧池耗尽时返回无效的 Task，释放后可以再次分配
+    void testPoolExhaustion() {
+        std::vector<Coro::Task> tasks;
+        for (size_t i = 0; i < Coro::FramePool::SLOT_COUNT; ++i) {
+            tasks.push_back(idle());
+            CHECK(tasks.back().valid());
+        }
+        CHECK(!idle().valid());
+
+        tasks.pop_back();
+        CHECK(idle().valid());
+    }
+} // namespace
+
+int main() {
+    testResumeOrder();
+    testCondition();
+    testPacketAvailable();
+    testPoolExhaustion();
+    std::printf("test_coroutine: OK\n");
+    return 0;
+}
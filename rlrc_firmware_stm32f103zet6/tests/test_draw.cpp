@@ -0,0 +1,227 @@
+/**
+ * 绘图图元：直线 (八个象限、水平/竖直/对角、端点在点阵外)、矩形裁剪、线性与径向渐变、整帧平移
+ *
+ * 每个用例先清屏，再逐像素与期望的图案比较。图案按行写成字符串，'#' 为绘制的颜色，'.' 为黑色。
+ */
+
+#include <cstdio>
+#include <initializer_list>
+
+#include "draw.hpp"
+#include "test_support.hpp"
+
+namespace {
+    // 期望的图案按板载的 5x5 点阵书写
+    static_assert(WS2812B::WIDTH == 5 && WS2812B::HEIGHT == 5);
+
+    auto &strip = WS2812B::getInstance();
+
+    constexpr Color::Rgb INK{10, 20, 30};
+
+    using Pixel = std::array<uint8_t, 3>;
+
+    void expectPattern(std::initializer_list<const char *> rows) {
+        uint8_t y = 0;
+        for (const char *row: rows) {
+            for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) {
+                const Pixel expected = row[x] == '#' ? Pixel{INK.r, INK.g, INK.b} : Pixel{0, 0, 0};
+                CHECK(strip.getPixel(x, y) == expected);
+            }
+            y++;
+        }
+        CHECK(y == WS2812B::HEIGHT);
+    }
+
+    void drawLine(const int16_t x0, const int16_t y0, const int16_t x1, const int16_t y1) {
+        strip.clear();
+        Draw::line(strip, x0, y0, x1, y1, INK);
+    }
+
+    // 斜率 1/3 与 3 的直线没有落在两像素正中间的点，每个象限的结果唯一
+    void testLineOctants() {
+        drawLine(0, 0, 3, 1);
+        expectPattern({"##...", "..##.", ".....", ".....", "....."});
+        drawLine(0, 0, 1, 3);
+        expectPattern({"#....", "#....", ".#...", ".#...", "....."});
+        drawLine(4, 0, 3, 3);
+        expectPattern({"....#", "....#", "...#.", "...#.", "....."});
+        drawLine(4, 0, 1, 1);
+        expectPattern({"...##", ".##..", ".....", ".....", "....."});
+        drawLine(4, 4, 1, 3);
+        expectPattern({".....", ".....", ".....", ".##..", "...##"});
+        drawLine(4, 4, 3, 1);
+        expectPattern({".....", "...#.", "...#.", "....#", "....#"});
+        drawLine(0, 4, 1, 1);
+        expectPattern({".....", ".#...", ".#...", "#....", "#...."});
+        drawLine(0, 4, 3, 3);
+        expectPattern({".....", ".....", ".....", "..##.", "##..."});
+    }
+
+    void testLineSpecialCases() {
+        drawLine(1, 2, 3, 2);
+        expectPattern({".....", ".....", ".###.", ".....", "....."});
+        drawLine(2, 3, 2, 0);
+        expectPattern({"..#..", "..#..", "..#..", "..#..", "....."});
+        drawLine(4, 0, 0, 4);
+        expectPattern({"....#", "...#.", "..#..", ".#...", "#...."});
+        drawLine(2, 2, 2, 2);
+        expectPattern({".....", ".....", "..#..", ".....", "....."});
+
+        // 端点在点阵外：只画出点阵内的部分
+        drawLine(-3, -3, 7, 7);
+        expectPattern({"#....", ".#...", "..#..", "...#.", "....#"});
+        drawLine(-100, 1, 100, 1);
+        expectPattern({".....", "#####", ".....", ".....", "....."});
+        drawLine(-32768, 4, 32767, 4);
+        expectPattern({".....", ".....", ".....", ".....", "#####"});
+        drawLine(6, 0, 6, 4);
+        expectPattern({".....", ".....", ".....", ".....", "....."});
+    }
+
+    void fillRect(const int16_t x, const int16_t y, const uint16_t w, const uint16_t h) {
+        strip.clear();
+        Draw::fillRect(strip, x, y, w, h, INK);
+    }
+
+    void testFillRect() {
+        fillRect(1, 1, 2, 3);
+        expectPattern({".....", ".##..", ".##..", ".##..", "....."});
+        fillRect(-1, -1, 2, 2);
+        expectPattern({"#....", ".....", ".....", ".....", "....."});
+        fillRect(3, 2, 10, 10);
+        expectPattern({".....", ".....", "...##", "...##", "...##"});
+        fillRect(-1000, -1000, 65535, 65535);
+        expectPattern({"#####", "#####", "#####", "#####", "#####"});
+        fillRect(1, 1, 0, 3);
+        expectPattern({".....", ".....", ".....", ".....", "....."});
+        fillRect(-5, 0, 5, 5);
+        expectPattern({".....", ".....", ".....", ".....", "....."});
+        fillRect(32767, 32767, 65535, 65535);
+        expectPattern({".....", ".....", ".....", ".....", "....."});
+    }
+
+    constexpr Color::Rgb BLACK{0, 0, 0};
+    constexpr Color::Rgb WHITE{255, 255, 255};
+
+    // 每一列 (或每一行) 的灰度相同时，逐像素检查
+    void expectColumns(const std::array<uint8_t, WS2812B::WIDTH> &levels) {
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+            for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) {
+                CHECK((strip.getPixel(x, y) == Pixel{levels[x], levels[x], levels[x]}));
+            }
+        }
+    }
+
+    void testLinearGradient() {
+        // t = 0, 64, 128, 192, 256
+        Draw::linearGradient(strip, 0, 0, 4, 0, BLACK, WHITE);
+        expectColumns({0, 63, 127, 191, 255});
+
+        // 两端之外保持端点颜色
+        Draw::linearGradient(strip, 1, 3, 3, 3, BLACK, WHITE);
+        expectColumns({0, 0, 127, 255, 255});
+
+        // 反方向
+        Draw::linearGradient(strip, 4, 0, 0, 0, BLACK, WHITE);
+        expectColumns({255, 191, 127, 63, 0});
+
+        // 竖直方向：每行相同
+        Draw::linearGradient(strip, 2, 0, 2, 4, BLACK, WHITE);
+        constexpr std::array<uint8_t, WS2812B::HEIGHT> ROWS{0, 63, 127, 191, 255};
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+            for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) {
+                CHECK((strip.getPixel(x, y) == Pixel{ROWS[y], ROWS[y], ROWS[y]}));
+            }
+        }
+
+        // 端点相距很远：|d|^2 超出 32 位，点阵正好位于中点附近，t = (x + 30000) * 256 / 60000
+        Draw::linearGradient(strip, -30000, 0, 30000, 0, BLACK, WHITE);
+        expectColumns({127, 127, 127, 127, 127});
+        Draw::linearGradient(strip, -32768, 0, 32767, 0, BLACK, WHITE);
+        expectColumns({127, 127, 127, 127, 127});
+        Draw::linearGradient(strip, 0, 0, 32767, 32767, BLACK, WHITE);
+        expectColumns({0, 0, 0, 0, 0});
+
+        // 两端重合：整帧为 from
+        Draw::linearGradient(strip, 2, 2, 2, 2, WHITE, BLACK);
+        expectColumns({255, 255, 255, 255, 255});
+    }
+
+    void testRadialGradient() {
+        // 半径 0：整帧为 to
+        Draw::radialGradient(strip, 2, 2, 0, WHITE, BLACK);
+        expectColumns({0, 0, 0, 0, 0});
+
+        // 半径 2：圆心为 from，距离 1 处 t = 128，距离 2 及以外为 to
+        Draw::radialGradient(strip, 2, 2, 2, BLACK, WHITE);
+        CHECK((strip.getPixel(2, 2) == Pixel{0, 0, 0}));
+        CHECK((strip.getPixel(1, 2) == Pixel{127, 127, 127}));
+        CHECK((strip.getPixel(2, 3) == Pixel{127, 127, 127}));
+        CHECK((strip.getPixel(1, 1) == Pixel{180, 180, 180})); // sqrt(2) * 128 = 181
+        CHECK((strip.getPixel(0, 2) == Pixel{255, 255, 255}));
+        CHECK((strip.getPixel(0, 0) == Pixel{255, 255, 255}));
+
+        // 圆心很远、半径很大：距离 1000 / 半径 4000，t = 64
+        Draw::radialGradient(strip, -1000, 2, 4000, BLACK, WHITE);
+        expectColumns({63, 63, 63, 63, 63});
+        Draw::radialGradient(strip, -32768, -32768, 65535, BLACK, WHITE);
+        expectColumns({180, 180, 180, 180, 180});
+    }
+
+    // 每个像素的颜色编码了它原来的位置
+    void fillIndexed() {
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+            for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) strip.setPixel(x, y, x, y, 1);
+        }
+    }
+
+    // 移动后 (x, y) 处应是原来 (sx, sy) 处的像素，sx 或 sy 为 -1 表示黑色
+    template<typename Source>
+    void expectShifted(Source &&source) {
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+            for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) {
+                const auto [sx, sy] = source(x, y);
+                const Pixel expected = sx < 0 || sy < 0 ? Pixel{0, 0, 0}
+                                                        : Pixel{static_cast<uint8_t>(sx), static_cast<uint8_t>(sy), 1};
+                CHECK(strip.getPixel(x, y) == expected);
+            }
+        }
+    }
+
+    void testShift() {
+        fillIndexed();
+        Draw::shift(strip, 2, -1, false);
+        expectShifted([](const int x, const int y) {
+            const int sx = x - 2, sy = y + 1;
+            return std::array{sx >= 0 && sy < 5 ? sx : -1, sx >= 0 && sy < 5 ? sy : -1};
+        });
+
+        fillIndexed();
+        Draw::shift(strip, -1, -3, true);
+        expectShifted([](const int x, const int y) { return std::array{(x + 1) % 5, (y + 3) % 5}; });
+
+        // 位移超过点阵尺寸：环绕时按取模，否则整帧变黑
+        fillIndexed();
+        Draw::shift(strip, -7, 12, true);
+        expectShifted([](const int x, const int y) { return std::array{(x + 7) % 5, (y + 3) % 5}; });
+
+        fillIndexed();
+        Draw::shift(strip, -5, 0, false);
+        expectShifted([](int, int) { return std::array{-1, -1}; });
+
+        fillIndexed();
+        Draw::shift(strip, 0, 0, false);
+        expectShifted([](const int x, const int y) { return std::array{x, y}; });
+    }
+} // namespace
+
+int main() {
+    testLineOctants();
+    testLineSpecialCases();
+    testFillRect();
+    testLinearGradient();
+    testRadialGradient();
+    testShift();
+    std::printf("test_draw: OK\n");
+    return 0;
+}
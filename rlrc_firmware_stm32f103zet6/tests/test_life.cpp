@@ -0,0 +1,109 @@
+/**
+ * 位棋盘元胞自动机：与逐个细胞数邻居的朴素实现逐代比对
+ *
+ * 覆盖单字、恰好一个字、跨越多个字 (33、40、64、70 列) 的宽度，边界相连与不相连，多种 B/S 规则
+ * (含 B0、8 个邻居等边界情况)，以及随机生成的规则。
+ */
+
+#include <cstdio>
+
+#include "life.hpp"
+#include "life_reference.hpp"
+#include "test_support.hpp"
+
+namespace {
+    uint32_t random_state = 12345;
+
+    uint32_t next() {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+        return random_state;
+    }
+
+    constexpr Life::Rule RULES[] = {
+        Life::CONWAY,
+        // HighLife B36/S23
+        {(1u << 3) | (1u << 6), (1u << 2) | (1u << 3)},
+        // Seeds B2/S
+        {1u << 2, 0},
+        // Day & Night B3678/S34678
+        {(1u << 3) | (1u << 6) | (1u << 7) | (1u << 8), (1u << 3) | (1u << 4) | (1u << 6) | (1u << 7) | (1u << 8)},
+        // B01/S8：没有邻居的死细胞也会复活，8 个邻居才能存活
+        {(1u << 0) | (1u << 1), 1u << 8},
+        // 全部复活、全部存活
+        {0x1FF, 0x1FF},
+    };
+
+    template<uint8_t W, uint8_t H>
+    void compare(const Life::Board<W, H> &board, const NaiveLife<W, H> &naive) {
+        for (uint8_t y = 0; y < H; ++y) {
+            for (uint8_t x = 0; x < W; ++x) CHECK(board.get(x, y) == naive.get(x, y));
+        }
+    }
+
+    template<uint8_t W, uint8_t H>
+    void run(const Life::Rule rule, const bool wrap, const unsigned generations) {
+        Life::Board<W, H> board;
+        NaiveLife<W, H> naive;
+        for (uint8_t y = 0; y < H; ++y) {
+            for (uint8_t x = 0; x < W; ++x) {
+                const bool alive = next() % 3 == 0;
+                board.set(x, y, alive);
+                naive.set(x, y, alive);
+            }
+        }
+
+        for (unsigned g = 0; g < generations; ++g) {
+            board.step(rule, wrap);
+            naive.step(rule, wrap);
+            compare(board, naive);
+
+            // 棋盘外的位始终为 0：population 与朴素计数一致
+            unsigned alive = 0;
+            for (const uint8_t cell : naive.cells) alive += cell;
+            CHECK(board.population() == alive);
+        }
+    }
+
+    template<uint8_t W, uint8_t H>
+    void testSize() {
+        for (const Life::Rule rule : RULES) {
+            run<W, H>(rule, true, 30);
+            run<W, H>(rule, false, 30);
+        }
+        for (unsigned i = 0; i < 20; ++i) {
+            const Life::Rule rule{static_cast<uint16_t>(next() & 0x1FF), static_cast<uint16_t>(next() & 0x1FF)};
+            run<W, H>(rule, i % 2 == 0, 10);
+        }
+    }
+
+    // 滑翔机跨过字边界 (第 31/32 列) 和左右边界后形状不变
+    void testGliderAcrossWords() {
+        Life::Board<40, 16> board;
+        const uint8_t shape[][2] = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+        for (const auto &cell : shape) board.set(static_cast<uint8_t>(28 + cell[0]), cell[1], true);
+
+        // 每 4 代向右下移动一格；40 代后移动 10 格，跨过字边界并从右边界绕回左侧
+        for (unsigned g = 0; g < 40; ++g) board.step(Life::CONWAY, true);
+        CHECK(board.population() == 5);
+        for (const auto &cell : shape) {
+            CHECK(board.get(static_cast<uint8_t>((38 + cell[0]) % 40), static_cast<uint8_t>(cell[1] + 10)));
+        }
+    }
+} // namespace
+
+int main() {
+    testSize<1, 3>();
+    testSize<2, 2>();
+    testSize<5, 5>();
+    testSize<31, 6>();
+    testSize<32, 6>();
+    testSize<33, 7>();
+    testSize<40, 25>();
+    testSize<64, 4>();
+    testSize<70, 5>();
+    testGliderAcrossWords();
+    std::printf("test_life: OK\n");
+    return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * 日志缓冲区：格式化写入、单条与整体容量的截断，以及分批输出
+ *
+ * drain() 的输出走 stdout，这里只检查剩余字节数；内容通过再次写满前后的剩余空间间接验证。
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "log_buffer.hpp"
+#include "test_support.hpp"
+
+namespace {
+    size_t buffered() {
+        // drain(0) 不输出，只返回剩余字节数
+        return LogBuffer::drain(0);
+    }
+
+    void testPrint() {
+        CHECK(LogBuffer::empty());
+        CHECK(LogBuffer::print("[ESP->BIN] Set FPS: %d\r\n", 250));
+        CHECK(buffered() == std::string("[ESP->BIN] Set FPS: 250\r\n").size());
+
+        // 分批输出
+        CHECK(LogBuffer::drain(10) == buffered());
+        CHECK(buffered() == 25 - 10);
+        CHECK(LogBuffer::drain(100) == 0);
+        CHECK(LogBuffer::empty());
+    }
+
+    void testLongLineTruncated() {
+        const std::string long_text(LogBuffer::MAX_LINE * 2, 'x');
+        CHECK(!LogBuffer::print("%s", long_text.c_str()));
+        CHECK(buffered() == LogBuffer::MAX_LINE - 1);
+        LogBuffer::drain(LogBuffer::CAPACITY);
+    }
+
+    void testBufferFull() {
+        // 写满后剩余部分被丢弃，输出后又能继续写入
+        const std::string chunk(100, 'y');
+        size_t written = 0;
+        while (LogBuffer::print("%s", chunk.c_str())) written += chunk.size();
+        CHECK(written == LogBuffer::CAPACITY / chunk.size() * chunk.size());
+        CHECK(buffered() == LogBuffer::CAPACITY);
+
+        CHECK(LogBuffer::drain(LogBuffer::CAPACITY) == 0);
+        CHECK(LogBuffer::print("%s", chunk.c_str()));
+        LogBuffer::drain(LogBuffer::CAPACITY);
+    }
+}
+
+int main() {
+    testPrint();
+    testLongLineTruncated();
+    testBufferFull();
+    std::printf("\ntest_log_buffer: OK\n");
+    return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * 定点噪声：输出范围、连续性与周期
+ *
+ * 与 noise_ppm 生成的图片一起检查噪声质量：这里只验证能自动判断的性质。
+ */
+
+#include <algorithm>
+#include <cstdio>
+
+#include "noise.hpp"
+#include "test_support.hpp"
+
+namespace {
+    using Fixed::q16;
+
+    constexpr q16 STEP = Fixed::ONE / 1024;
+
+    // 输出在 [-1, 1] 内，且整个平面上确实覆盖了正负两侧
+    void testRange() {
+        q16 low2 = 0, high2 = 0, low3 = 0, high3 = 0, low_fbm = 0, high_fbm = 0;
+        for (q16 y = 0; y < Fixed::fromInt(16); y += Fixed::ONE / 8) {
+            for (q16 x = 0; x < Fixed::fromInt(16); x += Fixed::ONE / 8) {
+                const q16 n2 = Noise::perlin2(x, y);
+                const q16 n3 = Noise::perlin3(x, y, x / 3 + Fixed::HALF / 3);
+                const q16 f = Noise::fbm3(x, y, Fixed::fromInt(5) / 3, 4);
+                low2 = std::min(low2, n2), high2 = std::max(high2, n2);
+                low3 = std::min(low3, n3), high3 = std::max(high3, n3);
+                low_fbm = std::min(low_fbm, f), high_fbm = std::max(high_fbm, f);
+            }
+        }
+        CHECK(low2 >= -Fixed::ONE && high2 <= Fixed::ONE);
+        CHECK(low3 >= -Fixed::ONE && high3 <= Fixed::ONE);
+        CHECK(low_fbm >= -Fixed::ONE && high_fbm <= Fixed::ONE);
+        CHECK(low2 < -Fixed::ONE / 2 && high2 > Fixed::ONE / 2);
+        CHECK(low3 < -Fixed::ONE / 2 && high3 > Fixed::ONE / 2);
+        std::printf("range: perlin2 [%.3f, %.3f], perlin3 [%.3f, %.3f], fbm3 [%.3f, %.3f]\n", low2 / 65536.0,
+                    high2 / 65536.0, low3 / 65536.0, high3 / 65536.0, low_fbm / 65536.0, high_fbm / 65536.0);
+    }
+
+    // 沿各轴走一小步，输出只变化一点点，跨越格点时也没有跳变
+    void testContinuity() {
+        q16 worst = 0;
+        for (q16 y = Fixed::ONE / 7; y < Fixed::fromInt(4); y += Fixed::ONE / 5) {
+            q16 previous2 = Noise::perlin2(0, y);
+            q16 previous3 = Noise::perlin3(0, y, y / 2);
+            for (q16 x = STEP; x < Fixed::fromInt(8); x += STEP) {
+                const q16 n2 = Noise::perlin2(x, y);
+                const q16 n3 = Noise::perlin3(x, y, y / 2);
+                worst = std::max({worst, Fixed::abs(n2 - previous2), Fixed::abs(n3 - previous3)});
+                previous2 = n2;
+                previous3 = n3;
+            }
+        }
+        // 梯度分量不超过 1，理论上每步最多变化约 sqrt(3) * STEP
+        CHECK(worst < 4 * STEP);
+        std::printf("continuity: max change %.4f per step of %.4f\n", worst / 65536.0, STEP / 65536.0);
+    }
+
+    // 以 256 为周期；wrap() 折回后结果不变，随时间增长的坐标不会溢出
+    void testPeriod() {
+        for (q16 x = 0; x < Fixed::fromInt(3); x += Fixed::ONE / 3) {
+            const q16 y = x / 2 + Fixed::ONE / 5;
+            CHECK(Noise::perlin2(x, y) == Noise::perlin2(x + Fixed::fromInt(256), y));
+            CHECK(Noise::perlin3(x, y, x) == Noise::perlin3(x, y, x + Fixed::fromInt(256)));
+            CHECK(Noise::perlin3(x, y, Noise::wrap(x + Fixed::fromInt(1000))) ==
+                  Noise::perlin3(x, y, x + Fixed::fromInt(1000 - 768)));
+        }
+    }
+} // namespace
+
+int main() {
+    testRange();
+    testContinuity();
+    testPeriod();
+    std::printf("test_noise: OK\n");
+    return 0;
+}
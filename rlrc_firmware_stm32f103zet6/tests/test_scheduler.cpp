@@ -0,0 +1,184 @@
+/**
+ * 调度器：模拟时钟下的调度顺序与最坏等待时间
+ *
+ * 时钟是一个由测试推进的计数器 (单位：µs)。任务运行时推进时钟表示自身的耗时，
+ * 推进过程中到期的「中断」会在对应时刻调用 post()，与固件中中断打断任务、任务结束后才被调度的情形一致。
+ */
+
+#include <array>
+#include <cstdio>
+#include <vector>
+
+#include "scheduler.hpp"
+#include "test_support.hpp"
+
+namespace {
+    uint32_t now = 0;
+    uint32_t clock() { return now; }
+
+    TaskScheduler *active = nullptr;
+
+    // 周期性的中断源：每 period 触发一次，post 对应任务
+    struct Interrupt {
+        uint32_t period;
+        uint32_t next;
+        TaskScheduler::TaskId task;
+    };
+    std::vector<Interrupt> interrupts;
+
+    // 推进时钟，期间到期的中断依次 post
+    void advance(const uint32_t duration) {
+        const uint32_t end = now + duration;
+        while (true) {
+            Interrupt *first = nullptr;
+            for (auto &irq: interrupts) {
+                if (irq.next <= end && (first == nullptr || irq.next < first->next)) first = &irq;
+            }
+            if (first == nullptr) break;
+            if (first->next > now) now = first->next;
+            active->post(first->task);
+            first->next += first->period;
+        }
+        now = end;
+    }
+
+    std::vector<char> order;
+
+    // 优先级高者先运行，同优先级按添加顺序；重复 post 只运行一次，运行中被 post 会再运行一次
+    void testOrdering() {
+        TaskScheduler scheduler{clock};
+        active = &scheduler;
+        order.clear();
+
+        static TaskScheduler *self = nullptr;
+        static TaskScheduler::TaskId low_id = 0;
+        self = &scheduler;
+        const auto low = scheduler.add("low", [] { order.push_back('L'); }, TaskScheduler::Priority::LOW);
+        const auto normal_a = scheduler.add("a", [] { order.push_back('a'); }, TaskScheduler::Priority::NORMAL);
+        const auto normal_b = scheduler.add("b", [] {
+            order.push_back('b');
+            self->post(low_id); // 运行中 post 已就绪的任务：不会重复
+        }, TaskScheduler::Priority::NORMAL);
+        const auto high = scheduler.add("high", [] { order.push_back('H'); }, TaskScheduler::Priority::HIGH);
+        low_id = low;
+
+        scheduler.post(low);
+        scheduler.post(normal_b);
+        scheduler.post(normal_a);
+        scheduler.post(high);
+        scheduler.post(high);
+        while (scheduler.runOne()) {}
+
+        CHECK((order == std::vector<char>{'H', 'a', 'b', 'L'}));
+        CHECK(scheduler.idle());
+        CHECK(scheduler.takeStats(high).runs == 1);
+
+        // 任务运行中 post 自己：之后再运行一次
+        static int reposts = 0;
+        reposts = 0;
+        static TaskScheduler::TaskId self_id = 0;
+        self_id = scheduler.add("self", [] {
+            if (++reposts < 3) self->post(self_id);
+        }, TaskScheduler::Priority::LOW);
+        scheduler.post(self_id);
+        while (scheduler.runOne()) {}
+        CHECK(reposts == 3);
+    }
+
+    // 修改期限后，按新的期限统计超时
+    void testSetDeadline() {
+        TaskScheduler scheduler{clock};
+        active = &scheduler;
+        now = 0;
+
+        const auto task = scheduler.add("task", [] { advance(5'000); }, TaskScheduler::Priority::NORMAL, 10'000);
+        scheduler.post(task);
+        while (scheduler.runOne()) {}
+        CHECK(scheduler.takeStats(task).deadline_misses == 0);
+
+        // 帧率从 100 提高到 250 FPS，期限缩短为 4ms
+        scheduler.setDeadline(task, 4'000);
+        scheduler.post(task);
+        while (scheduler.runOne()) {}
+        CHECK(scheduler.takeStats(task).deadline_misses == 1);
+
+        // 0 表示不检查
+        scheduler.setDeadline(task, 0);
+        scheduler.post(task);
+        while (scheduler.runOne()) {}
+        CHECK(scheduler.takeStats(task).deadline_misses == 0);
+    }
+
+    // 固件的任务组合：数据包 (HIGH)、效果与编码 (NORMAL)、日志 (LOW)
+    // 任务不可抢占，高优先级任务的最坏等待 = 最长的其他任务的一次运行时间
+    void testWorstCaseLatency() {
+        TaskScheduler scheduler{clock};
+        active = &scheduler;
+        now = 0;
+
+        constexpr uint32_t PACKET_US = 150;
+        constexpr uint32_t EFFECT_US = 2'000;
+        constexpr uint32_t RENDER_US = 800;
+        constexpr uint32_t LOG_US = 600;
+
+        static TaskScheduler::TaskId render_id = 0;
+        static TaskScheduler *self = nullptr;
+        self = &scheduler;
+
+        const auto packet = scheduler.add("packet", [] { advance(PACKET_US); }, TaskScheduler::Priority::HIGH,
+                                          EFFECT_US + PACKET_US);
+        const auto effect = scheduler.add("effect", [] {
+            advance(EFFECT_US);
+            self->post(render_id);
+        }, TaskScheduler::Priority::NORMAL, 10'000);
+        render_id = scheduler.add("render", [] { advance(RENDER_US); }, TaskScheduler::Priority::NORMAL, 10'000);
+        const auto log = scheduler.add("log", [] { advance(LOG_US); }, TaskScheduler::Priority::LOW);
+
+        // 100 FPS 帧节拍；数据包间隔与帧节拍互质，覆盖到各种相位
+        interrupts = {{10'000, 0, effect}, {997, 500, packet}, {3'001, 1'500, log}};
+
+        while (now < 10'000'000) {
+            if (!scheduler.runOne()) advance(1); // 空闲：等待下一个中断
+        }
+        interrupts.clear();
+
+        const auto packet_stats = scheduler.takeStats(packet);
+        const auto effect_stats = scheduler.takeStats(effect);
+        const auto render_stats = scheduler.takeStats(render_id);
+        const auto log_stats = scheduler.takeStats(log);
+
+        std::printf("simulated 10 s, worst-case wait (us): packet %u, effect %u, render %u, log %u\n",
+                    packet_stats.max_latency, effect_stats.max_latency, render_stats.max_latency,
+                    log_stats.max_latency);
+        std::printf("runs: packet %u, effect %u, render %u, log %u\n", packet_stats.runs, effect_stats.runs,
+                    render_stats.runs, log_stats.runs);
+
+        // 数据包最多被一次最长的效果计算挡住，且确实出现过接近该上限的情形
+        CHECK(packet_stats.max_latency <= EFFECT_US);
+        CHECK(packet_stats.max_latency > EFFECT_US - 997);
+        CHECK(packet_stats.deadline_misses == 0);
+        // 等待期间到达的数据包与未运行的那次合并 (由任务一次处理完接收缓冲区)
+        // 每帧的效果计算约挡住两次中断，故运行次数约少 1/10
+        constexpr uint32_t PACKET_POSTS = (10'000'000 - 500) / 997 + 1;
+        CHECK(packet_stats.runs <= PACKET_POSTS && packet_stats.runs > PACKET_POSTS * 8 / 10);
+
+        // 每一帧都计算并编码了一次，且都在帧周期内完成
+        CHECK(effect_stats.runs == 1000);
+        CHECK(render_stats.runs == 1000);
+        CHECK(effect_stats.deadline_misses == 0 && render_stats.deadline_misses == 0);
+        CHECK(effect_stats.max_time == EFFECT_US);
+
+        // 低优先级任务不会饿死
+        constexpr uint32_t LOG_POSTS = (10'000'000 - 1'500) / 3'001 + 1;
+        CHECK(log_stats.runs <= LOG_POSTS && log_stats.runs > LOG_POSTS * 8 / 10);
+        CHECK(log_stats.max_latency < 10'000);
+    }
+} // namespace
+
+int main() {
+    testOrdering();
+    testSetDeadline();
+    testWorstCaseLatency();
+    std::printf("test_scheduler: OK\n");
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * 演出序列：模拟时钟下的定时精度
+ *
+ * 帧节拍带随机抖动，记录每条指令实际执行的时刻，与「起点 + 轮次 * 周期 + 条目时间」比较：
+ * 不得提前，延迟不超过一个节拍间隔；多轮循环后误差不累积；时钟回绕与长时间阻塞后的行为符合预期。
+ */
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "sequencer.hpp"
+#include "test_support.hpp"
+
+namespace {
+    auto &sequencer = Sequencer::getInstance();
+
+    struct Fired {
+        uint8_t cue;
+        uint32_t time;
+    };
+    std::vector<Fired> fired;
+    uint32_t now = 0;
+
+    void record(const std::span<const uint8_t> packet) { fired.push_back({packet[0], now}); }
+
+    void appendCue(const uint32_t time_ms, const uint8_t id) {
+        const uint8_t packet[] = {id, 0x04, 0x01};
+        CHECK(sequencer.append(time_ms, packet) == Sequencer::ErrorCode::NONE);
+    }
+
+    // 以带抖动的帧节拍推进时钟，直到 end
+    void runTicks(const uint32_t end, std::mt19937 &rng, const uint32_t tick_ms, const uint32_t jitter_ms) {
+        std::uniform_int_distribution<uint32_t> jitter(0, jitter_ms);
+        while (static_cast<int32_t>(end - now) > 0) {
+            now += tick_ms + jitter(rng);
+            sequencer.update(now, record);
+        }
+    }
+
+    // 循环播放多轮：每条指令都不早于计划时刻，延迟不超过一个节拍间隔，且误差不随轮次累积
+    void testLoopTiming(const uint32_t start_time) {
+        constexpr uint32_t TIMES[] = {0, 2'500, 2'500, 7'000};
+        constexpr uint32_t LOOP_MS = 10'000;
+        constexpr uint32_t LOOPS = 360; // 一小时
+        constexpr uint32_t TICK_MS = 10;
+        constexpr uint32_t JITTER_MS = 3;
+
+        sequencer.clear();
+        for (uint8_t i = 0; i < 4; ++i) appendCue(TIMES[i], i);
+
+        fired.clear();
+        now = start_time;
+        std::mt19937 rng(42);
+        sequencer.start(now, LOOP_MS);
+        sequencer.update(now, record);
+        // 最后一个节拍落在下一轮开始之前
+        runTicks(start_time + LOOPS * LOOP_MS - TICK_MS - JITTER_MS, rng, TICK_MS, JITTER_MS);
+
+        CHECK(fired.size() == LOOPS * 4);
+        uint32_t worst = 0;
+        for (size_t i = 0; i < fired.size(); ++i) {
+            const uint32_t loop = static_cast<uint32_t>(i / 4);
+            CHECK(fired[i].cue == i % 4);
+            const uint32_t planned = start_time + loop * LOOP_MS + TIMES[i % 4];
+            const auto late = static_cast<int32_t>(fired[i].time - planned);
+            CHECK(late >= 0);
+            CHECK(late < static_cast<int32_t>(TICK_MS + JITTER_MS));
+            worst = std::max(worst, static_cast<uint32_t>(late));
+        }
+        // 同一时刻的两条指令在同一个节拍中执行
+        CHECK(fired[1].time == fired[2].time);
+        std::printf("start %10u: %u loops, %zu cues, worst lateness %u ms (tick %u ms + jitter up to %u ms)\n",
+                    start_time, LOOPS, fired.size(), worst, TICK_MS, JITTER_MS);
+    }
+
+    // 被阻塞超过一整轮后不补放错过的轮次，从恢复的时刻开始新的一轮
+    void testStallResync() {
+        sequencer.clear();
+        appendCue(0, 0);
+        appendCue(500, 1);
+
+        fired.clear();
+        now = 1'000;
+        sequencer.start(now, 1'000);
+        sequencer.update(now, record);
+        now += 600;
+        sequencer.update(now, record);
+        CHECK(fired.size() == 2);
+
+        now += 5'000; // 阻塞 5 s
+        sequencer.update(now, record);
+        CHECK(fired.size() == 3 && fired[2].cue == 0 && fired[2].time == now);
+        const uint32_t resumed = now;
+        now = resumed + 499;
+        sequencer.update(now, record);
+        CHECK(fired.size() == 3);
+        now = resumed + 500;
+        sequencer.update(now, record);
+        CHECK(fired.size() == 4 && fired[3].cue == 1);
+    }
+
+    // 只播放一遍：最后一条之后停止
+    void testOneShot() {
+        sequencer.clear();
+        appendCue(100, 0);
+        appendCue(200, 1);
+        CHECK(sequencer.append(150, std::span<const uint8_t>{}) == Sequencer::ErrorCode::INVALID_PACKET);
+        const uint8_t packet[] = {9};
+        CHECK(sequencer.append(150, packet) == Sequencer::ErrorCode::OUT_OF_ORDER);
+
+        fired.clear();
+        now = 0;
+        sequencer.start(now, 0);
+        std::mt19937 rng(7);
+        runTicks(1'000, rng, 10, 0);
+        CHECK(fired.size() == 2 && fired[0].time == 100 && fired[1].time == 200);
+        CHECK(!sequencer.isRunning());
+    }
+
+    // 指令在执行期间停止序列：同一节拍中剩下的条目不再执行
+    void testDispatchStops() {
+        sequencer.clear();
+        appendCue(0, 0);
+        appendCue(0, 1);
+        fired.clear();
+        now = 0;
+        sequencer.start(now, 0);
+        sequencer.update(now, [](const std::span<const uint8_t> packet) {
+            record(packet);
+            sequencer.stop();
+        });
+        CHECK(fired.size() == 1 && !sequencer.isRunning());
+    }
+} // namespace
+
+int main() {
+    testLoopTiming(0);
+    testLoopTiming(0xFFFF'FFFFu - 1'800'000); // 半小时后 HAL_GetTick() 回绕
+    testStallResync();
+    testOneShot();
+    testDispatchStops();
+    std::printf("test_sequencer: OK\n");
+    return 0;
+}
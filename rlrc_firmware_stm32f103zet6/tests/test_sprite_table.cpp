@@ -0,0 +1,165 @@
+/**
+ * 精灵表：翻转、关键色透明、整体不透明度、CLEAR_FIRST、越过四边与负坐标的裁剪，以及上传与 blit 的错误检查
+ *
+ * 用一个 3x2 的非对称精灵 (ABC / DEF，每个字母一种颜色)，期望的画面按行写成字符串：
+ * 字母为精灵的像素，'z' 为事先铺好的背景色，'.' 为黑色。
+ */
+
+#include <cstdio>
+#include <initializer_list>
+
+#include "sprite_table.hpp"
+#include "test_support.hpp"
+
+namespace {
+    // 期望的画面按板载的 5x5 点阵书写
+    static_assert(WS2812B::WIDTH == 5 && WS2812B::HEIGHT == 5);
+
+    using ErrorCode = SpriteTable::ErrorCode;
+    using Color::Rgb;
+    using Pixel = std::array<uint8_t, 3>;
+
+    auto &sprites = SpriteTable::getInstance();
+    auto &strip = WS2812B::getInstance();
+
+    constexpr uint8_t PLAIN = 0; // 不透明
+    constexpr uint8_t KEYED = 1; // E 为关键色
+
+    constexpr Rgb A{200, 0, 50}, B{0, 200, 50}, C{0, 0, 200}, D{200, 200, 0}, E{0, 255, 0}, F{50, 60, 70};
+    constexpr Rgb BACKGROUND{100, 100, 100};
+
+    Pixel colorOf(const char c) {
+        Rgb rgb{0, 0, 0};
+        switch (c) {
+            case 'A': rgb = A; break;
+            case 'B': rgb = B; break;
+            case 'C': rgb = C; break;
+            case 'D': rgb = D; break;
+            case 'E': rgb = E; break;
+            case 'F': rgb = F; break;
+            case 'z': rgb = BACKGROUND; break;
+            default: break;
+        }
+        return {rgb.r, rgb.g, rgb.b};
+    }
+
+    void expectPattern(std::initializer_list<const char *> rows) {
+        uint8_t y = 0;
+        for (const char *row: rows) {
+            for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) CHECK(strip.getPixel(x, y) == colorOf(row[x]));
+            y++;
+        }
+        CHECK(y == WS2812B::HEIGHT);
+    }
+
+    void upload() {
+        constexpr std::array<uint8_t, 18> PIXELS{
+            A.r, A.g, A.b, B.r, B.g, B.b, C.r, C.g, C.b,
+            D.r, D.g, D.b, E.r, E.g, E.b, F.r, F.g, F.b,
+        };
+        CHECK(sprites.upload(PLAIN, 3, 2, nullptr, PIXELS) == ErrorCode::NONE);
+        CHECK(sprites.upload(KEYED, 3, 2, &E, PIXELS) == ErrorCode::NONE);
+    }
+
+    // 铺满背景色后 blit
+    void blitOver(const uint8_t id, const int16_t x, const int16_t y, const uint8_t flags, const uint8_t alpha = 255) {
+        strip.setAll(BACKGROUND.r, BACKGROUND.g, BACKGROUND.b);
+        CHECK(sprites.blit(strip, id, x, y, flags, alpha) == ErrorCode::NONE);
+    }
+
+    void testFlips() {
+        blitOver(PLAIN, 1, 1, 0);
+        expectPattern({"zzzzz", "zABCz", "zDEFz", "zzzzz", "zzzzz"});
+        blitOver(PLAIN, 1, 1, SpriteTable::FLIP_X);
+        expectPattern({"zzzzz", "zCBAz", "zFEDz", "zzzzz", "zzzzz"});
+        blitOver(PLAIN, 1, 1, SpriteTable::FLIP_Y);
+        expectPattern({"zzzzz", "zDEFz", "zABCz", "zzzzz", "zzzzz"});
+        blitOver(PLAIN, 1, 1, SpriteTable::FLIP_X | SpriteTable::FLIP_Y);
+        expectPattern({"zzzzz", "zFEDz", "zCBAz", "zzzzz", "zzzzz"});
+    }
+
+    void testColorKey() {
+        blitOver(KEYED, 2, 3, 0);
+        expectPattern({"zzzzz", "zzzzz", "zzzzz", "zzABC", "zzDzF"});
+        blitOver(KEYED, 2, 3, SpriteTable::FLIP_X);
+        expectPattern({"zzzzz", "zzzzz", "zzzzz", "zzCBA", "zzFzD"});
+    }
+
+    // 精灵越过点阵的四条边：只绘制点阵内的部分，翻转后裁掉的是另一侧
+    void testClipping() {
+        blitOver(PLAIN, -1, -1, 0);
+        expectPattern({"EFzzz", "zzzzz", "zzzzz", "zzzzz", "zzzzz"});
+        blitOver(PLAIN, -1, -1, SpriteTable::FLIP_X | SpriteTable::FLIP_Y);
+        expectPattern({"BAzzz", "zzzzz", "zzzzz", "zzzzz", "zzzzz"});
+        blitOver(PLAIN, 3, 4, 0);
+        expectPattern({"zzzzz", "zzzzz", "zzzzz", "zzzzz", "zzzAB"});
+        blitOver(PLAIN, 4, -1, SpriteTable::FLIP_X);
+        expectPattern({"zzzzF", "zzzzz", "zzzzz", "zzzzz", "zzzzz"});
+        blitOver(PLAIN, -2, 3, SpriteTable::FLIP_Y);
+        expectPattern({"zzzzz", "zzzzz", "zzzzz", "Fzzzz", "Czzzz"});
+
+        // 完全在点阵外
+        for (const auto [x, y]: {std::array<int16_t, 2>{-3, 0}, {5, 0}, {0, -2}, {0, 5}, {-32768, -32768},
+                                 {32767, 32767}}) {
+            blitOver(PLAIN, x, y, 0);
+            expectPattern({"zzzzz", "zzzzz", "zzzzz", "zzzzz", "zzzzz"});
+        }
+    }
+
+    // dst + (src - dst) * alpha / 256；alpha = 0 不绘制；关键色在混合时同样跳过
+    void testAlpha() {
+        blitOver(KEYED, 0, 0, 0, 128);
+        CHECK((strip.getPixel(0, 0) == Pixel{150, 50, 75}));   // A
+        CHECK((strip.getPixel(1, 0) == Pixel{50, 150, 75}));   // B
+        CHECK((strip.getPixel(2, 0) == Pixel{50, 50, 150}));   // C
+        CHECK((strip.getPixel(0, 1) == Pixel{150, 150, 50}));  // D
+        CHECK((strip.getPixel(1, 1) == Pixel{100, 100, 100})); // E 为关键色
+        CHECK((strip.getPixel(2, 1) == Pixel{75, 80, 85}));    // F
+        CHECK((strip.getPixel(3, 0) == Pixel{100, 100, 100}));
+
+        blitOver(PLAIN, 0, 0, 0, 64);
+        CHECK((strip.getPixel(0, 0) == Pixel{125, 75, 87}));
+        CHECK((strip.getPixel(1, 1) == Pixel{75, 138, 75}));
+
+        blitOver(PLAIN, 0, 0, 0, 0);
+        expectPattern({"zzzzz", "zzzzz", "zzzzz", "zzzzz", "zzzzz"});
+    }
+
+    // CLEAR_FIRST 先清空整帧 (alpha = 0 时也清空)，再与黑色混合
+    void testClearFirst() {
+        blitOver(KEYED, 1, 2, SpriteTable::CLEAR_FIRST);
+        expectPattern({".....", ".....", ".ABC.", ".D.F.", "....."});
+        blitOver(PLAIN, 3, 3, SpriteTable::CLEAR_FIRST | SpriteTable::FLIP_X);
+        expectPattern({".....", ".....", ".....", "...CB", "...FE"});
+        blitOver(PLAIN, 0, 0, SpriteTable::CLEAR_FIRST, 0);
+        expectPattern({".....", ".....", ".....", ".....", "....."});
+        blitOver(PLAIN, 0, 0, SpriteTable::CLEAR_FIRST, 128);
+        CHECK((strip.getPixel(0, 0) == Pixel{100, 0, 25}));
+        CHECK((strip.getPixel(3, 0) == Pixel{0, 0, 0}));
+    }
+
+    void testErrors() {
+        const std::array<uint8_t, 3> one{1, 2, 3};
+        CHECK(sprites.upload(SpriteTable::SPRITE_COUNT, 1, 1, nullptr, one) == ErrorCode::INVALID_ID);
+        CHECK(sprites.upload(2, 0, 1, nullptr, one) == ErrorCode::INVALID_SIZE);
+        CHECK(sprites.upload(2, SpriteTable::MAX_SIZE + 1, 1, nullptr, one) == ErrorCode::INVALID_SIZE);
+        CHECK(sprites.upload(2, 1, 2, nullptr, one) == ErrorCode::BAD_LENGTH);
+
+        strip.setAll(BACKGROUND.r, BACKGROUND.g, BACKGROUND.b);
+        CHECK(sprites.blit(strip, SpriteTable::SPRITE_COUNT, 0, 0, 0, 255) == ErrorCode::INVALID_ID);
+        CHECK(sprites.blit(strip, 2, 0, 0, SpriteTable::CLEAR_FIRST, 255) == ErrorCode::EMPTY);
+        expectPattern({"zzzzz", "zzzzz", "zzzzz", "zzzzz", "zzzzz"}); // 出错时不清屏
+    }
+} // namespace
+
+int main() {
+    upload();
+    testFlips();
+    testColorKey();
+    testClipping();
+    testAlpha();
+    testClearFirst();
+    testErrors();
+    std::printf("test_sprite_table: OK\n");
+    return 0;
+}
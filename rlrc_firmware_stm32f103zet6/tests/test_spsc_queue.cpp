@@ -0,0 +1,90 @@
+/**
+ * SPSC 队列：单线程语义，以及生产者/消费者各一个线程的压力测试
+ *
+ * 压力测试中生产者按序号连续入队多字段的元素，消费者检查序号连续、各字段一致 (没有读到写了一半的元素)。
+ * 容量很小，两端会频繁地在队列满/空的边界上交替，覆盖计数器发布与槽位复用的竞争窗口。
+ */
+
+#include <cstdio>
+#include <thread>
+
+#include "spsc_queue.hpp"
+#include "test_support.hpp"
+
+namespace {
+    struct Item {
+        uint32_t sequence;
+        uint32_t scrambled; // sequence 的散列，检查元素是否完整
+        uint64_t wide;      // 跨越多个字的字段
+    };
+
+    constexpr Item makeItem(const uint32_t sequence) {
+        return {sequence, sequence * 2654435761u, (static_cast<uint64_t>(~sequence) << 32) | sequence};
+    }
+
+    void testSingleThread() {
+        SpscQueue<uint32_t, 4> queue;
+        CHECK(queue.empty());
+        CHECK(!queue.pop());
+
+        // 多次绕过环形缓冲区的末尾
+        uint32_t next_push = 0;
+        uint32_t next_pop = 0;
+        for (int round = 0; round < 10; ++round) {
+            while (queue.push(next_push)) ++next_push;
+            CHECK(queue.size() == 4);
+            for (int i = 0; i < 3; ++i) {
+                const auto value = queue.pop();
+                CHECK(value && *value == next_pop);
+                ++next_pop;
+            }
+            CHECK(queue.size() == 1);
+        }
+        while (const auto value = queue.pop()) CHECK(*value == next_pop++);
+        CHECK(next_pop == next_push);
+        CHECK(queue.empty());
+    }
+
+    template<size_t Capacity>
+    void stress(const uint32_t count) {
+        static SpscQueue<Item, Capacity> queue;
+        uint32_t full = 0;
+
+        std::thread producer([count, &full] {
+            for (uint32_t sequence = 0; sequence < count; ++sequence) {
+                while (!queue.push(makeItem(sequence))) {
+                    if (++full % 64 == 0) std::this_thread::yield();
+                }
+            }
+        });
+
+        uint32_t expected = 0;
+        uint32_t empty = 0;
+        while (expected < count) {
+            const auto item = queue.pop();
+            if (!item) {
+                // 先自旋一会儿，让两端真正并发；偶尔让出 CPU，单核的主机上生产者才有机会运行
+                if (++empty % 64 == 0) std::this_thread::yield();
+                continue;
+            }
+            const Item reference = makeItem(expected);
+            CHECK(item->sequence == reference.sequence);
+            CHECK(item->scrambled == reference.scrambled);
+            CHECK(item->wide == reference.wide);
+            ++expected;
+        }
+        producer.join();
+        CHECK(queue.empty());
+
+        std::printf("capacity %2zu: %u items, producer saw full %u times, consumer saw empty %u times\n", Capacity,
+                    count, full, empty);
+    }
+} // namespace
+
+int main() {
+    testSingleThread();
+    stress<2>(100'000);
+    stress<16>(1'000'000);
+    std::printf("test_spsc_queue: OK\n");
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * 文字跑马灯：短文字静止居中、滚动的循环周期，以及滚动位置在两列之间时的亮度混合
+ *
+ * 期望值由 Font::column() 按「左列 * (256 - frac) + 右列 * frac」独立算出，另有几处手写的像素值。
+ */
+
+#include <cstdio>
+#include <string_view>
+
+#include "font.hpp"
+#include "test_support.hpp"
+#include "text_effect.hpp"
+
+namespace {
+    // 手写的像素位置按板载的 5x5 点阵，字体正好占满 5 行
+    static_assert(WS2812B::WIDTH == 5 && WS2812B::HEIGHT == Font::GLYPH_HEIGHT);
+
+    auto &strip = WS2812B::getInstance();
+    auto &effect = TextEffect::getInstance();
+
+    constexpr Color::Rgb COLOR{200, 100, 50};
+    // 100 像素每秒：每 10 ms 滚动一列，每 5 ms 半列
+    constexpr uint16_t SPEED = 100 * 256;
+
+    void show(const std::string_view text, const uint16_t speed) {
+        effect.setText({reinterpret_cast<const uint8_t *>(text.data()), text.size()}, COLOR, speed);
+    }
+
+    // 文字第 x 列的位图，超出文字范围为 0
+    uint8_t textColumn(const std::string_view text, const int32_t x) {
+        const auto width = static_cast<int32_t>(text.size() * Font::ADVANCE) - 1;
+        if (x < 0 || x >= width) return 0;
+        return Font::column(text[x / Font::ADVANCE], static_cast<uint8_t>(x % Font::ADVANCE));
+    }
+
+    Color::Rgb scaled(const uint8_t level) {
+        return {Color::scale8(COLOR.r, level), Color::scale8(COLOR.g, level), Color::scale8(COLOR.b, level)};
+    }
+
+    // 屏幕第 0 列位于文字的 offset / 256 列处
+    void expectFrame(const std::string_view text, const int32_t offset) {
+        const int32_t whole = offset >> 8;
+        const uint32_t frac = offset & 0xFF;
+        for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) {
+            const uint8_t left = textColumn(text, whole + x);
+            const uint8_t right = textColumn(text, whole + x + 1);
+            for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+                const uint32_t level = ((left >> y) & 1u) * (256 - frac) + ((right >> y) & 1u) * frac;
+                const Color::Rgb c = scaled(static_cast<uint8_t>(level > 255 ? 255 : level));
+                CHECK((strip.getPixel(x, y) == std::array<uint8_t, 3>{c.r, c.g, c.b}));
+            }
+        }
+    }
+
+    bool lit(const uint8_t x, const uint8_t y) { return strip.getPixel(x, y) != std::array<uint8_t, 3>{0, 0, 0}; }
+
+    // 放得下的文字静止时居中；放不下时左对齐
+    void testStaticCentring() {
+        show("L", 0);
+        effect.update(0, strip);
+        expectFrame("L", -256);
+
+        // "L" 宽 3 列，两侧各空 1 列
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) {
+            CHECK(!lit(0, y) && !lit(4, y));
+            CHECK(lit(1, y));
+            CHECK(lit(2, y) == (y == 4) && lit(3, y) == (y == 4));
+        }
+        CHECK((strip.getPixel(1, 0) == std::array<uint8_t, 3>{200, 100, 50}));
+
+        show("LI", 0);
+        effect.update(0, strip);
+        expectFrame("LI", 0);
+    }
+
+    // 从右边缘外进入，完全移出左边缘后重新开始：周期为 (文字宽度 + 屏宽) 列
+    void testWrapPeriod() {
+        constexpr std::string_view TEXT = "L1";
+        constexpr uint32_t START = 1000;
+        constexpr uint32_t PERIOD_MS = (7 + WS2812B::WIDTH) * 10;
+
+        show(TEXT, SPEED);
+        effect.update(START, strip);
+        expectFrame(TEXT, -WS2812B::WIDTH * 256);
+        for (uint8_t x = 0; x < WS2812B::WIDTH; ++x) {
+            for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) CHECK(!lit(x, y));
+        }
+
+        for (uint32_t ms = 0; ms < 2 * PERIOD_MS; ms += 10) {
+            effect.update(START + ms, strip);
+            expectFrame(TEXT, static_cast<int32_t>(ms % PERIOD_MS) * 256 / 10 - WS2812B::WIDTH * 256);
+        }
+
+        // 最后一帧只剩文字最右一列在屏幕第 0 列，下一帧回到开头
+        effect.update(START + PERIOD_MS - 10, strip);
+        CHECK(lit(0, 4) && !lit(1, 4));
+        effect.update(START + PERIOD_MS, strip);
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) CHECK(!lit(0, y));
+    }
+
+    // frac = 0 时只显示左列；frac = 128 时两列各占一半，两列都亮时饱和为 255
+    void testSubPixelBlend() {
+        show("I", SPEED);
+        effect.update(0, strip);
+
+        // 5 ms：offset = 128 - 5 * 256，屏幕第 4 列的右侧是 'I' 的第 0 列
+        effect.update(5, strip);
+        expectFrame("I", 128 - WS2812B::WIDTH * 256);
+        CHECK((strip.getPixel(4, 0) == std::array<uint8_t, 3>{100, 50, 25}));
+        CHECK((strip.getPixel(4, 2) == std::array<uint8_t, 3>{0, 0, 0}));
+
+        // 15 ms：屏幕第 4 列在 'I' 的第 0、1 列之间
+        effect.update(15, strip);
+        expectFrame("I", 128 - 4 * 256);
+        CHECK((strip.getPixel(4, 0) == std::array<uint8_t, 3>{200, 100, 50})); // 两列都亮
+        CHECK((strip.getPixel(4, 2) == std::array<uint8_t, 3>{100, 50, 25})); // 只有右列亮
+
+        // 20 ms：frac = 0，第 4 列正好是 'I' 的第 1 列
+        effect.update(20, strip);
+        expectFrame("I", -3 * 256);
+        for (uint8_t y = 0; y < WS2812B::HEIGHT; ++y) CHECK(lit(4, y));
+        CHECK(!lit(3, 2));
+    }
+} // namespace
+
+int main() {
+    testStaticCentring();
+    testWrapPeriod();
+    testSubPixelBlend();
+    std::printf("test_text_effect: OK\n");
+    return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * 灯带编码器：冗余渲染跳过、时间抖动、限流重编码时的抖动误差
+ *
+ * 从 HAL_TIM_PWM_Start_DMA() 收到的缓冲区中解码出实际发送的通道值，与按 8.8 定点公式模拟的结果逐帧比较。
+ */
+
+#include <cstdio>
+
+#include "host_hal.hpp"
+#include "test_support.hpp"
+#include "ws2812b.hpp"
+
+namespace {
+    auto &strip = WS2812B::getInstance();
+
+    // 解码最近一次发送的缓冲区中某颗灯珠某个逻辑通道的值
+    uint8_t sentChannel(const uint16_t led, const LedChip::Channel channel) {
+        const uint16_t *buffer = HostHal::lastDmaBuffer();
+        CHECK(buffer != nullptr);
+        uint8_t slot = 0;
+        while (ActiveLedChip::CHANNEL_ORDER[slot] != channel) slot++;
+
+        uint8_t value = 0;
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            const uint16_t pulse = buffer[led * WS2812B::BITS_PER_LED + slot * 8 + bit];
+            CHECK(pulse == WS2812B::PWM_HIGH_VAL || pulse == WS2812B::PWM_LOW_VAL);
+            value = static_cast<uint8_t>(value << 1 | (pulse == WS2812B::PWM_HIGH_VAL));
+        }
+        return value;
+    }
+
+    // 模拟一次 render()，DMA 立即完成
+    void renderFrame() {
+        strip.render();
+        strip.on_dma_transfer_complete();
+    }
+
+    // 校正后的 8.8 定点值
+    uint16_t corrected(const uint8_t value, const uint8_t power_limit) {
+        const uint32_t scale = ((strip.getBrightness() + 1) * (power_limit + 1)) >> 8;
+        return static_cast<uint16_t>((WS2812B::GAMMA_LUT_R[value] * scale) >> 8);
+    }
+
+    // 默认不抖动；帧内容不变时不重复发送
+    void testSkipsUnchangedFrames() {
+        CHECK(!strip.isDithering());
+        strip.setPowerBudget(0);
+        strip.setAll(10, 20, 30);
+        renderFrame();
+        const uint32_t sent = HostHal::dmaStartCount();
+        const uint32_t skipped = strip.getSkippedRenderCount();
+        CHECK(sent == 1);
+        CHECK(sentChannel(0, LedChip::G) == (corrected(20, 255) + 0x80) >> 8);
+
+        for (int i = 0; i < 10; ++i) renderFrame();
+        CHECK(HostHal::dmaStartCount() == sent);
+        CHECK(strip.getSkippedRenderCount() == skipped + 10);
+
+        strip.setPixel(1, 0, 10, 20, 200);
+        renderFrame();
+        CHECK(HostHal::dmaStartCount() == sent + 1);
+    }
+
+    // 静止画面开启抖动：逐帧输出与误差累积的模拟一致，只有输出变化的帧才重新发送
+    void testDitheringSendsOnlyChangedFrames() {
+        constexpr uint8_t VALUE = 40;
+        strip.setAll(VALUE, VALUE, VALUE);
+        renderFrame();
+        uint8_t previous = sentChannel(0, LedChip::R);
+
+        strip.setDithering(true); // 误差清零
+        const uint16_t v16 = corrected(VALUE, 255);
+        CHECK((v16 & 0xFF) != 0);
+
+        uint8_t error = 0;
+        uint32_t sum = 0;
+        uint32_t expected_sends = 0;
+        const uint32_t sent = HostHal::dmaStartCount();
+        for (int frame = 0; frame < 256; ++frame) {
+            const auto acc = static_cast<uint16_t>(v16 + error);
+            const auto expected = static_cast<uint8_t>(acc >> 8);
+            error = static_cast<uint8_t>(acc);
+            if (expected != previous) expected_sends++;
+            previous = expected;
+
+            renderFrame();
+            for (uint16_t led = 0; led < WS2812B::LED_COUNT; ++led) {
+                CHECK(sentChannel(led, LedChip::R) == expected);
+                CHECK(sentChannel(led, LedChip::B) == expected);
+            }
+            sum += expected;
+        }
+        CHECK(HostHal::dmaStartCount() - sent == expected_sends);
+        CHECK(expected_sends < 256); // 有输出不变的帧被跳过
+        CHECK(sum == v16);           // 256 帧的平均值恰好等于 8.8 定点值
+    }
+
+    // 限流系数变化导致同一帧编码两遍时，抖动误差只按最终的系数推进一次
+    void testPowerLimitReencodeAdvancesDitherOnce() {
+        constexpr uint8_t VALUE = 180;
+        strip.setPowerBudget(0);
+        strip.setAll(VALUE, VALUE, VALUE);
+        renderFrame();
+        CHECK(strip.getPowerLimit() == 255);
+        const uint32_t unlimited = strip.getEstimatedCurrent();
+
+        strip.setDithering(false);
+        strip.setDithering(true); // 误差清零
+        strip.setPowerBudget(static_cast<uint16_t>(unlimited / 2));
+
+        uint8_t error = 0;
+        int limit_changes = 0;
+        uint8_t last_limit = 255;
+        for (int frame = 0; frame < 64; ++frame) {
+            renderFrame();
+            const uint8_t limit = strip.getPowerLimit();
+            if (limit != last_limit) limit_changes++;
+            last_limit = limit;
+
+            const auto acc = static_cast<uint16_t>(corrected(VALUE, limit) + error);
+            error = static_cast<uint8_t>(acc);
+            for (uint16_t led = 0; led < WS2812B::LED_COUNT; ++led) {
+                CHECK(sentChannel(led, LedChip::R) == acc >> 8);
+            }
+        }
+        CHECK(limit_changes >= 1);
+        CHECK(strip.getEstimatedCurrent() <= unlimited / 2);
+    }
+} // namespace
+
+int main() {
+    testSkipsUnchangedFrames();
+    testDitheringSendsOnlyChangedFrames();
+    testPowerLimitReencodeAdvancesDitherOnce();
+    std::printf("test_ws2812b: OK\n");
+    return 0;
+}
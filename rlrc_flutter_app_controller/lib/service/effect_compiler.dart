@@ -0,0 +1,261 @@
+import 'dart:typed_data';
+
+/// 把一段小型表达式语言编译成 STM32 字节码虚拟机的程序 (见固件 bytecode_vm.hpp)
+///
+/// 语法示例：
+/// ```
+/// hue = x / w + t * 0.2
+/// hsv(hue, 1, 0.5 + 0.5 * sin(y + t))
+/// ```
+/// - 语句用换行或 `;` 分隔，`名字 = 表达式` 定义变量 (编译时内联展开)
+/// - 最后一条语句给出颜色：`hsv(h, s, v)` (h 以圈为单位) 或 `r, g, b`，各分量 0-1
+/// - 输入：x, y (坐标), t (秒), i (像素序号), w, h (点阵宽高), p0-p7 (效果参数，0-255)
+/// - 运算：+ - * / % 和括号，函数 sin cos abs fract floor sqrt min max noise
+class EffectCompiler {
+  /// 指令表，必须与固件保持一致
+  static const _opEnd = 0x00;
+  static const _opConst = 0x01;
+  static const _opParam = 0x08;
+  static const _opHsv = 0x30;
+  static const _inputs = {'x': 0x02, 'y': 0x03, 't': 0x04, 'i': 0x05, 'w': 0x06, 'h': 0x07};
+  static const _binaryOps = {'+': 0x10, '-': 0x11, '*': 0x12, '/': 0x13, '%': 0x14};
+  static const _unaryFunctions = {
+    'abs': 0x21,
+    'sin': 0x22,
+    'cos': 0x23,
+    'fract': 0x24,
+    'floor': 0x25,
+    'sqrt': 0x26,
+  };
+  static const _binaryFunctions = {'min': 0x15, 'max': 0x16, 'noise': 0x17};
+  static const _opNeg = 0x20;
+
+  /// 固件的限制
+  static const maxProgramSize = 256;
+  static const stackSize = 16;
+
+  /// 编译源码，出错时抛出 [FormatException]
+  static Uint8List compile(String source) => _Compiler(source).compile();
+}
+
+/// 一段已编译的代码及其执行时需要的最大栈深度 (表达式执行完后净压入 1 个值，颜色语句为 3 个)
+class _Code {
+  _Code(this.bytes, this.maxDepth);
+
+  final List<int> bytes;
+  final int maxDepth;
+
+  static _Code constant(double value) {
+    final q16 = (value * 65536).round().clamp(-0x80000000, 0x7FFFFFFF);
+    return _Code([EffectCompiler._opConst, for (var shift = 0; shift < 32; shift += 8) (q16 >> shift) & 0xFF], 1);
+  }
+
+  static _Code op(int opcode) => _Code([opcode], 1);
+
+  /// 依次执行 [operands] (各压入 1 个值)，再执行 [opcode] (为 null 时不追加指令)
+  static _Code apply(int? opcode, List<_Code> operands) {
+    final bytes = <int>[];
+    var maxDepth = 0;
+    for (var k = 0; k < operands.length; k++) {
+      bytes.addAll(operands[k].bytes);
+      // 第 k 个操作数执行时，栈上已有前面 k 个值
+      maxDepth = maxDepth > k + operands[k].maxDepth ? maxDepth : k + operands[k].maxDepth;
+    }
+    if (opcode != null) bytes.add(opcode);
+    return _Code(bytes, maxDepth);
+  }
+}
+
+class _Compiler {
+  _Compiler(this.source);
+
+  final String source;
+  final _tokens = <String>[];
+  final _variables = <String, _Code>{};
+  var _pos = 0;
+
+  Uint8List compile() {
+    _tokenize();
+
+    // 拆分语句
+    final statements = <List<String>>[[]];
+    for (final token in _tokens) {
+      if (token == ';' || token == '\n') {
+        if (statements.last.isNotEmpty) statements.add([]);
+      } else {
+        statements.last.add(token);
+      }
+    }
+    if (statements.last.isEmpty) statements.removeLast();
+    if (statements.isEmpty) throw const FormatException('Empty program');
+
+    _Code? color;
+    for (var s = 0; s < statements.length; s++) {
+      _tokens
+        ..clear()
+        ..addAll(statements[s]);
+      _pos = 0;
+
+      final isLast = s == statements.length - 1;
+      if (!isLast) {
+        final name = _next();
+        if (!_isIdentifier(name) || _next() != '=') throw FormatException('Expected "name = expression"', name);
+        if (EffectCompiler._inputs.containsKey(name) || _isParam(name)) {
+          throw FormatException('Cannot assign to input', name);
+        }
+        _variables[name] = _expression();
+      } else {
+        color = _color();
+      }
+      if (_pos != _tokens.length) throw FormatException('Unexpected token', _tokens[_pos]);
+    }
+
+    final bytes = [...color!.bytes, EffectCompiler._opEnd];
+    if (color.maxDepth > EffectCompiler.stackSize) throw const FormatException('Expression too deep');
+    if (bytes.length > EffectCompiler.maxProgramSize) {
+      throw FormatException('Program too large (${bytes.length} > ${EffectCompiler.maxProgramSize} bytes)');
+    }
+    return Uint8List.fromList(bytes);
+  }
+
+  // 颜色语句：hsv(h, s, v) 或 r, g, b，执行后栈上恰好 3 个值
+  _Code _color() {
+    if (_peek() == 'hsv' && _peekAt(1) == '(') {
+      _pos += 2;
+      final args = _arguments();
+      if (args.length != 3) throw const FormatException('hsv() takes 3 arguments');
+      return _Code.apply(EffectCompiler._opHsv, args);
+    }
+
+    final channels = [_expression()];
+    while (_peek() == ',') {
+      _pos++;
+      channels.add(_expression());
+    }
+    if (channels.length != 3) throw const FormatException('Last statement must be hsv(h, s, v) or r, g, b');
+    return _Code.apply(null, channels);
+  }
+
+  // expression := term (('+' | '-') term)*
+  _Code _expression() {
+    var left = _term();
+    while (_peek() == '+' || _peek() == '-') {
+      final op = _next();
+      left = _Code.apply(EffectCompiler._binaryOps[op]!, [left, _term()]);
+    }
+    return left;
+  }
+
+  // term := unary (('*' | '/' | '%') unary)*
+  _Code _term() {
+    var left = _unary();
+    while (_peek() == '*' || _peek() == '/' || _peek() == '%') {
+      final op = _next();
+      left = _Code.apply(EffectCompiler._binaryOps[op]!, [left, _unary()]);
+    }
+    return left;
+  }
+
+  // unary := '-' unary | primary
+  _Code _unary() {
+    if (_peek() == '-') {
+      _pos++;
+      // 负常数直接折叠
+      final number = double.tryParse(_peek() ?? '');
+      if (number != null) {
+        _pos++;
+        return _Code.constant(-number);
+      }
+      return _Code.apply(EffectCompiler._opNeg, [_unary()]);
+    }
+    return _primary();
+  }
+
+  _Code _primary() {
+    final token = _next();
+
+    final number = double.tryParse(token);
+    if (number != null) return _Code.constant(number);
+
+    if (token == '(') {
+      final inner = _expression();
+      _expect(')');
+      return inner;
+    }
+
+    if (!_isIdentifier(token)) throw FormatException('Unexpected token', token);
+
+    if (_peek() == '(') {
+      _pos++;
+      final args = _arguments();
+      final unary = EffectCompiler._unaryFunctions[token];
+      if (unary != null) {
+        if (args.length != 1) throw FormatException('$token() takes 1 argument');
+        return _Code.apply(unary, args);
+      }
+      final binary = EffectCompiler._binaryFunctions[token];
+      if (binary != null) {
+        if (args.length != 2) throw FormatException('$token() takes 2 arguments');
+        return _Code.apply(binary, args);
+      }
+      throw FormatException('Unknown function', token);
+    }
+
+    final input = EffectCompiler._inputs[token];
+    if (input != null) return _Code.op(input);
+    if (_isParam(token)) return _Code([EffectCompiler._opParam, int.parse(token.substring(1))], 1);
+
+    final variable = _variables[token];
+    if (variable != null) return variable;
+    throw FormatException('Unknown name', token);
+  }
+
+  // 已读过 '('，读取逗号分隔的参数直到 ')'
+  List<_Code> _arguments() {
+    final args = <_Code>[];
+    if (_peek() != ')') {
+      args.add(_expression());
+      while (_peek() == ',') {
+        _pos++;
+        args.add(_expression());
+      }
+    }
+    _expect(')');
+    return args;
+  }
+
+  // --- 词法分析 ---
+
+  void _tokenize() {
+    final pattern = RegExp(r'[ \t\r]*(?:(#[^\n]*)|(\n)|(\d+\.?\d*|\.\d+)|([A-Za-z_]\w*)|([-+*/%(),;=]))');
+    var index = 0;
+    while (index < source.length) {
+      final match = pattern.matchAsPrefix(source, index);
+      if (match == null || match.end == index) {
+        if (source.substring(index).trim().isEmpty) break;
+        throw FormatException('Unexpected character', source, index);
+      }
+      index = match.end;
+      if (match[1] != null) continue; // 注释
+      final token = match[2] ?? match[3] ?? match[4] ?? match[5];
+      if (token != null) _tokens.add(token);
+    }
+  }
+
+  String? _peek() => _peekAt(0);
+
+  String? _peekAt(int offset) => _pos + offset < _tokens.length ? _tokens[_pos + offset] : null;
+
+  String _next() {
+    if (_pos >= _tokens.length) throw const FormatException('Unexpected end of statement');
+    return _tokens[_pos++];
+  }
+
+  void _expect(String token) {
+    if (_next() != token) throw FormatException('Expected "$token"');
+  }
+
+  static bool _isIdentifier(String token) => RegExp(r'^[A-Za-z_]\w*$').hasMatch(token);
+
+  static bool _isParam(String token) => RegExp(r'^p[0-7]$').hasMatch(token);
+}
@@ -1,6 +1,8 @@
+import 'dart:async';
 import 'dart:io';
 import 'dart:typed_data';
 import 'package:flutter_riverpod/flutter_riverpod.dart';
+import 'package:light_controller/service/effect_compiler.dart';
 import 'package:light_controller/service/protocol_encoder.dart';
 
 /// 全局 Provider，让 APP 的任何地方都能访问到这个服务单例
@@ -15,6 +17,13 @@ class LedMatrixService {
   final ProtocolEncoder _encoder;
   Socket? _socket;
 
+  /// 尚未遇到分界符的接收数据
+  final List<int> _rxBuffer = [];
+
+  /// STM32 的功耗回复，每次查询都会收到一份
+  final StreamController<PowerReport> _powerReports = StreamController<PowerReport>.broadcast();
+  Stream<PowerReport> get powerReports => _powerReports.stream;
+
   /// 连接到 ESP8266
   /// (生产级应用会在这里处理 DNS 解析，但我们直接用 IP)
   Future<void> connect(String ip, int port) async {
@@ -34,20 +43,19 @@ class LedMatrixService {
       // 对于我们这种小数据包，禁用 Nagle 算法可以降低延迟
       _socket?.setOption(SocketOption.tcpNoDelay, true);
 
-      // (可选) 监听来自 STM32/ESP8266 的*返回*数据
-      // _socket?.listen(
-      //   (data) {
-      //     print('Received from STM32: $data');
-      //   },
-      //   onError: (error) {
-      //     print('Socket Error: $error');
-      //     disconnect();
-      //   },
-      //   onDone: () {
-      //     print('Socket disconnected by remote.');
-      //     disconnect();
-      //   },
-      // );
+      // 监听来自 STM32 的回复 (ESP8266 透明转发，COBS 编码)
+      _rxBuffer.clear();
+      _socket?.listen(
+        _onData,
+        onError: (error) {
+          print('Socket Error: $error');
+          disconnect();
+        },
+        onDone: () {
+          print('Socket disconnected by remote.');
+          disconnect();
+        },
+      );
     } catch (e) {
       // 确保在出错时 socket 是 null
       _socket = null;
@@ -63,6 +71,29 @@ class LedMatrixService {
     _socket = null;
   }
 
+  /// [私有] 按 0x00 分界符拆出完整的包，解码后按头部分发
+  void _onData(Uint8List data) {
+    for (final byte in data) {
+      if (byte != 0x00) {
+        _rxBuffer.add(byte);
+        continue;
+      }
+      if (_rxBuffer.isEmpty) continue;
+
+      final packet = _encoder.removeCobs(Uint8List.fromList(_rxBuffer));
+      _rxBuffer.clear();
+      if (packet.isEmpty) continue;
+
+      switch (packet[0]) {
+        case PowerReport.header:
+          final report = PowerReport.decode(packet);
+          if (report != null) _powerReports.add(report);
+        default:
+          print('Unknown reply from STM32: $packet');
+      }
+    }
+  }
+
   /// [私有] 原始的发送方法
   /// cobs 编码将在这里进行
   void _send(Uint8List data) {
@@ -115,8 +146,274 @@ class LedMatrixService {
   /// [mode] 模式ID
   ///   0: 静态/画板模式
   ///   1: 扩散动画模式
+  ///   2: 关键帧插值, 3: RAM 帧页, 4: Flash 片段, 5: 字节码效果
+  ///   6: 等离子, 7: 云层, 8: 元胞自动机, 9: 火焰, 10: 文字跑马灯
   void sendSetModeCommand(int mode) {
     final data = _encoder.encodeSetMode(mode);
     _send(data);
   }
-}
\ No newline at end of file
+
+  /// 意图：设置全局亮度
+  /// [brightness] 0-255
+  void sendSetBrightnessCommand(int brightness) {
+    final data = _encoder.encodeSetBrightness(brightness);
+    _send(data);
+  }
+
+  /// 意图：设置电源预算
+  /// [milliamps] 预算电流 (mA)，0 表示不限流
+  void sendSetPowerBudgetCommand(int milliamps) {
+    final data = _encoder.encodeSetPowerBudget(milliamps);
+    _send(data);
+  }
+
+  /// 意图：开关时间抖动，低亮度渐变不再出现明显台阶 (默认关闭)
+  void sendSetDitheringCommand(bool enabled) {
+    final data = _encoder.encodeSetDithering(enabled);
+    _send(data);
+  }
+
+  /// 意图：修改帧节拍的帧率 (1-10000，默认 100)
+  void sendSetFpsCommand(int fps) {
+    final data = _encoder.encodeSetFps(fps);
+    _send(data);
+  }
+
+  /// 意图：查询 STM32 当前的功耗估算，结果从 [powerReports] 返回
+  void sendQueryPowerCommand() {
+    final data = _encoder.encodeQueryPower();
+    _send(data);
+  }
+
+  /// 意图：查询功耗估算并等待回复
+  /// 超时 (未连接、或 STM32 正忙于发送上一个回复) 时抛出 [TimeoutException]
+  Future<PowerReport> queryPower({Duration timeout = const Duration(seconds: 1)}) {
+    final reply = powerReports.first.timeout(timeout);
+    sendQueryPowerCommand();
+    return reply;
+  }
+
+  /// 意图：修改某个效果的参数
+  /// [mode] 效果对应的模式ID
+  /// [offset] 起始参数下标
+  /// [values] 参数值 (每个 0-255)
+  void sendSetEffectParamCommand(int mode, int offset, List<int> values) {
+    final data = _encoder.encodeSetEffectParam(mode, offset, values);
+    _send(data);
+  }
+
+  /// 意图：设置过渡效果
+  /// [type] 0: 直接切换, 1: 淡入淡出, 2: 擦除, 3: 溶解
+  /// [durationMs] 过渡时长 (ms)
+  /// [frames] 整帧刷新是否也过渡 (流式推送帧时应保持关闭)
+  void sendSetTransitionCommand(int type, int durationMs, {bool frames = false}) {
+    final data = _encoder.encodeSetTransition(type, durationMs, frames: frames);
+    _send(data);
+  }
+
+  /// 意图：发送一个关键帧，由 STM32 插值出中间帧
+  /// [pixelBytes] 75 字节的颜色数据
+  /// [durationMs] 从上一个关键帧过渡到本帧的时长
+  /// [curve] 0: 线性, 1: 缓入, 2: 缓出, 3: 缓入缓出
+  void sendKeyframeCommand(List<int> pixelBytes, int durationMs, {int curve = 0}) {
+    if (pixelBytes.length != 75) {
+      print("Error: Keyframe data length must be 75 bytes (5x5x3).");
+      return;
+    }
+
+    final data = _encoder.encodePushKeyframe(Uint8List.fromList(pixelBytes), durationMs, curve: curve);
+    _send(data);
+  }
+
+  /// 意图：上传一页画面到 STM32 的 RAM
+  /// [page] 页号 (0 到 [ProtocolEncoder.pageCount] - 1)
+  /// [pixelBytes] 75 字节的颜色数据
+  void sendUploadPageCommand(int page, List<int> pixelBytes) {
+    if (pixelBytes.length != 75) {
+      print("Error: Page data length must be 75 bytes (5x5x3).");
+      return;
+    }
+
+    final data = _encoder.encodeUploadPage(page, Uint8List.fromList(pixelBytes));
+    _send(data);
+  }
+
+  /// 意图：显示已上传的某一页
+  void sendFlipPageCommand(int page) {
+    final data = _encoder.encodeFlipPage(page);
+    _send(data);
+  }
+
+  /// 意图：让 STM32 自动轮播 [first] 开始的 [count] 页
+  /// [periodMs] 每页时长，0 表示停止轮播
+  void sendSetPageCycleCommand(int first, int count, int periodMs) {
+    final data = _encoder.encodeSetPageCycle(first, count, periodMs);
+    _send(data);
+  }
+
+  /// 意图：把一段动画写入 STM32 的 Flash，之后可脱离 APP 独立播放
+  /// [slot] 槽位 (0-7)
+  /// [frames] 每帧 75 字节 RGB；提供 [palette] 时每帧为 25 字节调色板下标
+  /// [palette] 调色板 (每个颜色 3 字节 RGB)，最多 256 色
+  /// 数据分块发送，块之间稍作等待，给 STM32 擦写 Flash 留出时间
+  Future<void> uploadClip({
+    required int slot,
+    required List<List<int>> frames,
+    required int framePeriodMs,
+    List<int>? palette,
+  }) async {
+    const chunkSize = 128;
+    const chunkDelay = Duration(milliseconds: 20);
+
+    final isPalette = palette != null;
+    final frameSize = isPalette ? 25 : 75;
+    if (frames.any((frame) => frame.length != frameSize)) {
+      print("Error: Clip frame length must be $frameSize bytes.");
+      return;
+    }
+
+    final bytes = BytesBuilder();
+    if (isPalette) bytes.add(palette);
+    for (final frame in frames) {
+      bytes.add(frame);
+    }
+    final payload = bytes.toBytes();
+
+    _send(_encoder.encodeClipBegin(
+      slot: slot,
+      format: isPalette ? 1 : 0,
+      framePeriodMs: framePeriodMs,
+      frameCount: frames.length,
+      paletteCount: isPalette ? palette.length ~/ 3 : 0,
+    ));
+    await Future.delayed(chunkDelay); // 第一页擦除
+
+    for (var offset = 0; offset < payload.length; offset += chunkSize) {
+      final end = (offset + chunkSize).clamp(0, payload.length);
+      _send(_encoder.encodeClipData(offset, Uint8List.sublistView(payload, offset, end)));
+      await Future.delayed(chunkDelay);
+    }
+
+    _send(_encoder.encodeClipEnd());
+  }
+
+  /// 意图：播放 Flash 中的片段
+  void sendPlayClipCommand(int slot, {bool loop = true}) {
+    final data = _encoder.encodePlayClip(slot, loop: loop);
+    _send(data);
+  }
+
+  /// 意图：上传一段演出序列并开始播放
+  /// [cues] (时间 ms, 指令) 列表，指令由 ProtocolEncoder 的 encodeXxx() 生成
+  /// [loopMs] 循环周期，0 表示只播放一遍
+  /// 上传后演出由 STM32 的时钟驱动，APP 可以断开连接
+  void sendSequence(List<(int, Uint8List)> cues, {int loopMs = 0}) {
+    _send(_encoder.encodeSeqControl(2)); // 清空旧序列
+    for (final (timeMs, command) in cues) {
+      _send(_encoder.encodeSeqAppend(timeMs, command));
+    }
+    _send(_encoder.encodeSeqControl(1, loopMs: loopMs));
+  }
+
+  /// 意图：停止演出序列
+  void sendStopSequenceCommand() {
+    final data = _encoder.encodeSeqControl(0);
+    _send(data);
+  }
+
+  /// 意图：编译一段效果表达式并交给 STM32 运行 (语法见 EffectCompiler)
+  /// 源码有误时抛出 [FormatException]，由调用方提示用户
+  void sendEffectProgram(String source) {
+    final program = EffectCompiler.compile(source);
+    _send(_encoder.encodeVmLoad(program));
+  }
+
+  /// 意图：设置元胞自动机 (模式 8) 的规则
+  /// [rule] B/S 记法，例如 "B3/S23" (生命游戏)、"B36/S23" (HighLife)
+  void sendLifeRuleCommand(String rule) {
+    final match = RegExp(r'^B([0-8]*)/S([0-8]*)$', caseSensitive: false).firstMatch(rule.trim());
+    if (match == null) {
+      print("Error: Rule must look like B3/S23.");
+      return;
+    }
+
+    int mask(String digits) => digits.split('').fold(0, (bits, digit) => bits | (1 << int.parse(digit)));
+    final birth = mask(match[1]!);
+    final survive = mask(match[2]!);
+
+    // 参数 0-2: 复活掩码低 8 位, 存活掩码低 8 位, 8 个邻居 (bit0 复活, bit1 存活)
+    final data = _encoder.encodeSetEffectParam(8, 0, [
+      birth & 0xFF,
+      survive & 0xFF,
+      ((birth >> 8) & 1) | (((survive >> 8) & 1) << 1),
+    ]);
+    _send(data);
+  }
+
+  /// 意图：在 STM32 上显示一段滚动文字，只需发送一个数据包
+  /// [pixelsPerSecond] 滚动速度，0 表示静止 (放得下时居中)
+  void sendTextCommand(String text, {int r = 255, int g = 255, int b = 255, double pixelsPerSecond = 4}) {
+    final data = _encoder.encodeSetText(text, r: r, g: g, b: b, pixelsPerSecond: pixelsPerSecond);
+    _send(data);
+  }
+
+  /// 意图：在 STM32 上填充矩形，坐标可以超出点阵 (自动裁剪)
+  void sendFillRectCommand(int x, int y, int w, int h, int r, int g, int b) {
+    final data = _encoder.encodeFillRect(x, y, w, h, r, g, b);
+    _send(data);
+  }
+
+  /// 意图：在 STM32 上画一条直线
+  void sendDrawLineCommand(int x0, int y0, int x1, int y1, int r, int g, int b) {
+    final data = _encoder.encodeDrawLine(x0, y0, x1, y1, r, g, b);
+    _send(data);
+  }
+
+  /// 意图：线性渐变填满整帧，从 (x0, y0) 的 [from] 过渡到 (x1, y1) 的 [to]
+  void sendLinearGradientCommand(int x0, int y0, int x1, int y1, List<int> from, List<int> to) {
+    final data = _encoder.encodeGradient(0, x0, y0, x1, y1, from, to);
+    _send(data);
+  }
+
+  /// 意图：径向渐变填满整帧，圆心 (cx, cy) 为 [from]，距离 [radius] 及以外为 [to]
+  void sendRadialGradientCommand(int cx, int cy, int radius, List<int> from, List<int> to) {
+    final data = _encoder.encodeGradient(1, cx, cy, radius, 0, from, to);
+    _send(data);
+  }
+
+  /// 意图：整帧平移，[wrap] 为 true 时移出的像素从另一侧移入 (滚动)
+  void sendShiftCommand(int dx, int dy, {bool wrap = true}) {
+    final data = _encoder.encodeShift(dx, dy, wrap: wrap);
+    _send(data);
+  }
+
+  /// 意图：把一个精灵上传到 STM32，之后只需 sendSpriteBlitCommand 移动它
+  /// [pixels] 为 width * height * 3 字节 RGB，按行排列
+  void sendSpriteUploadCommand(int id, int width, int height, Uint8List pixels, {List<int>? key}) {
+    final data = _encoder.encodeSpriteUpload(id, width, height, pixels, key: key);
+    _send(data);
+  }
+
+  /// 意图：在 (x, y) 绘制已上传的精灵，[clearFirst] 为 true 时先清空画面 (移动单个物体)
+  void sendSpriteBlitCommand(
+    int id,
+    int x,
+    int y, {
+    bool flipX = false,
+    bool flipY = false,
+    bool clearFirst = false,
+    int alpha = 255,
+  }) {
+    final data = _encoder.encodeSpriteBlit(
+      id,
+      x,
+      y,
+      flipX: flipX,
+      flipY: flipY,
+      clearFirst: clearFirst,
+      alpha: alpha,
+    );
+    _send(data);
+  }
+}
+
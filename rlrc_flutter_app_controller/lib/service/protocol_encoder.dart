@@ -2,6 +2,9 @@ import 'dart:typed_data';
 
 /// 负责将 APP 的意图 (Intent) 转换为 STM32 能识别的二进制数据包
 class ProtocolEncoder {
+  /// STM32 上的 RAM 帧页数：8 KB 预算 / 每页 75 字节，与固件的 PageEffect::PAGE_COUNT 一致
+  static const int pageCount = 8192 ~/ 75;
+
   /// 指令 4: 开/关 (0x03) (2 字节)
   /// [CMD(0x03)] [STATE(0x00/0x01)]
   Uint8List encodeBasicToggle({required bool isOn}) {
@@ -84,6 +87,28 @@ class ProtocolEncoder {
     return Uint8List.fromList(buffer);
   }
 
+  /// COBS 解码，[frame] 为两个 0x00 分界符之间的数据 (不含分界符)
+  /// 与 [applyCobs] 互逆；路标越界时返回已解出的部分
+  Uint8List removeCobs(Uint8List frame) {
+    final buffer = BytesBuilder();
+    int ptr = 0;
+
+    while (ptr < frame.length) {
+      final code = frame[ptr++];
+      if (code == 0) break; // 不应出现在帧内
+
+      // 拷贝 (code - 1) 个非零数据
+      for (int i = 1; i < code && ptr < frame.length; i++) {
+        buffer.addByte(frame[ptr++]);
+      }
+
+      // code < 255 且没到末尾，说明这里原本有个 0
+      if (code < 0xFF && ptr < frame.length) buffer.addByte(0x00);
+    }
+
+    return buffer.toBytes();
+  }
+
 /// 指令 4: 设置显示模式 (0x04)
   /// [CMD(0x04)] [Mode ID]
   /// Mode 0: 静态/画板模式
@@ -94,4 +119,375 @@ class ProtocolEncoder {
     builder.addByte(mode.clamp(0, 255)); // Mode ID
     return builder.toBytes();
   }
+
+  /// 指令 5: 设置全局亮度 (0x05)
+  /// [CMD(0x05)] [Brightness(0-255)]
+  /// 亮度与 gamma 校正由 STM32 在编码阶段完成，无需按比例重发每一帧
+  Uint8List encodeSetBrightness(int brightness) {
+    final builder = BytesBuilder();
+    builder.addByte(0x05); // Command ID
+    builder.addByte(brightness.clamp(0, 255)); // Brightness
+    return builder.toBytes();
+  }
+
+  /// 指令 6: 设置电源预算 (0x06)
+  /// [CMD(0x06)] [mA 低字节] [mA 高字节]
+  /// 整帧估算电流超出预算时 STM32 自动压低亮度，0 表示不限流
+  Uint8List encodeSetPowerBudget(int milliamps) {
+    final value = milliamps.clamp(0, 0xFFFF);
+    final builder = BytesBuilder();
+    builder.addByte(0x06); // Command ID
+    builder.addByte(value & 0xFF); // mA (小端)
+    builder.addByte((value >> 8) & 0xFF);
+    return builder.toBytes();
+  }
+
+  /// 指令 7: 查询功耗估算 (0x07)
+  /// [CMD(0x07)]
+  Uint8List encodeQueryPower() {
+    final builder = BytesBuilder();
+    builder.addByte(0x07); // Command ID
+    return builder.toBytes();
+  }
+
+  /// 指令 8: 设置效果参数 (0x08)
+  /// [CMD(0x08)] [Mode ID] [起始下标] [参数值...]
+  /// 每个效果最多 8 个字节参数，下标含义见固件中各效果的 Param 枚举
+  Uint8List encodeSetEffectParam(int mode, int offset, List<int> values) {
+    final builder = BytesBuilder();
+    builder.addByte(0x08); // Command ID
+    builder.addByte(mode.clamp(0, 255)); // Mode ID
+    builder.addByte(offset.clamp(0, 7)); // 起始下标
+    for (final value in values) {
+      builder.addByte(value.clamp(0, 255));
+    }
+    return builder.toBytes();
+  }
+
+  /// 指令 9: 设置过渡效果 (0x09)
+  /// [CMD(0x09)] [类型] [ms 低字节] [ms 高字节] [整帧刷新也过渡]
+  /// 类型 0: 直接切换, 1: 淡入淡出, 2: 擦除, 3: 溶解
+  /// 作用于模式切换、页面切换和开关，由 STM32 在本地计算中间帧；
+  /// 连续推送的整帧默认直接显示，[frames] 为 true 时整帧刷新也过渡
+  Uint8List encodeSetTransition(int type, int durationMs, {bool frames = false}) {
+    final value = durationMs.clamp(0, 0xFFFF);
+    final builder = BytesBuilder();
+    builder.addByte(0x09); // Command ID
+    builder.addByte(type.clamp(0, 3)); // 过渡类型
+    builder.addByte(value & 0xFF); // ms (小端)
+    builder.addByte((value >> 8) & 0xFF);
+    builder.addByte(frames ? 1 : 0);
+    return builder.toBytes();
+  }
+
+  /// 指令 10: 追加关键帧 (0x0A)
+  /// [CMD(0x0A)] [缓动曲线] [ms 低字节] [ms 高字节] [R0,G0,B0, R1,G1,B1, ...]
+  /// 缓动曲线 0: 线性, 1: 缓入, 2: 缓出, 3: 缓入缓出
+  /// STM32 在 [durationMs] 内从上一个关键帧插值到本帧，最多缓存 4 帧
+  Uint8List encodePushKeyframe(Uint8List data, int durationMs, {int curve = 0}) {
+    final value = durationMs.clamp(0, 0xFFFF);
+    final builder = BytesBuilder();
+    builder.addByte(0x0A); // Command ID
+    builder.addByte(curve.clamp(0, 3)); // 缓动曲线
+    builder.addByte(value & 0xFF); // ms (小端)
+    builder.addByte((value >> 8) & 0xFF);
+    builder.add(data); // 75 字节的颜色数据
+    return builder.toBytes();
+  }
+
+  /// 指令 11: 上传帧页 (0x0B)
+  /// [CMD(0x0B)] [页号(0-108)] [R0,G0,B0, R1,G1,B1, ...]
+  /// 帧页保存在 STM32 的 RAM 中，上传一次即可反复显示
+  Uint8List encodeUploadPage(int page, Uint8List data) {
+    final builder = BytesBuilder();
+    builder.addByte(0x0B); // Command ID
+    builder.addByte(page.clamp(0, pageCount - 1)); // 页号
+    builder.add(data); // 75 字节的颜色数据
+    return builder.toBytes();
+  }
+
+  /// 指令 12: 翻页 (0x0C)
+  /// [CMD(0x0C)] [页号(0-108)]
+  Uint8List encodeFlipPage(int page) {
+    final builder = BytesBuilder();
+    builder.addByte(0x0C); // Command ID
+    builder.addByte(page.clamp(0, pageCount - 1)); // 页号
+    return builder.toBytes();
+  }
+
+  /// 指令 13: 自动轮播帧页 (0x0D)
+  /// [CMD(0x0D)] [起始页] [页数] [ms 低字节] [ms 高字节]
+  /// 每页时长为 0 时停止轮播
+  Uint8List encodeSetPageCycle(int first, int count, int periodMs) {
+    final value = periodMs.clamp(0, 0xFFFF);
+    final builder = BytesBuilder();
+    builder.addByte(0x0D); // Command ID
+    builder.addByte(first.clamp(0, pageCount - 1)); // 起始页
+    builder.addByte(count.clamp(0, pageCount)); // 页数
+    builder.addByte(value & 0xFF); // ms (小端)
+    builder.addByte((value >> 8) & 0xFF);
+    return builder.toBytes();
+  }
+
+  /// 指令 14: 开始上传 Flash 片段 (0x0E)
+  /// [CMD(0x0E)] [槽位(0-7)] [格式] [每帧 ms(2)] [帧数(2)] [调色板颜色数(2)]
+  /// 格式 0: RGB 原始帧 (每帧 75 字节), 1: 调色板帧 (每帧 25 字节下标)
+  /// 多字节字段均为小端
+  Uint8List encodeClipBegin({
+    required int slot,
+    required int format,
+    required int framePeriodMs,
+    required int frameCount,
+    int paletteCount = 0,
+  }) {
+    final builder = BytesBuilder();
+    builder.addByte(0x0E); // Command ID
+    builder.addByte(slot.clamp(0, 7)); // 槽位
+    builder.addByte(format.clamp(0, 1)); // 格式
+    for (final value in [framePeriodMs, frameCount, paletteCount]) {
+      final v = value.clamp(0, 0xFFFF);
+      builder.addByte(v & 0xFF);
+      builder.addByte((v >> 8) & 0xFF);
+    }
+    return builder.toBytes();
+  }
+
+  /// 指令 15: 片段数据块 (0x0F)
+  /// [CMD(0x0F)] [偏移(4, 小端)] [数据...]
+  /// 数据为调色板 (RGB) 与各帧数据顺序拼接后的字节流，偏移必须连续
+  Uint8List encodeClipData(int offset, Uint8List chunk) {
+    final builder = BytesBuilder();
+    builder.addByte(0x0F); // Command ID
+    for (var shift = 0; shift < 32; shift += 8) {
+      builder.addByte((offset >> shift) & 0xFF); // 偏移 (小端)
+    }
+    builder.add(chunk);
+    return builder.toBytes();
+  }
+
+  /// 指令 16: 结束上传 (0x10)
+  /// [CMD(0x10)]
+  Uint8List encodeClipEnd() {
+    final builder = BytesBuilder();
+    builder.addByte(0x10); // Command ID
+    return builder.toBytes();
+  }
+
+  /// 指令 17: 播放 Flash 片段 (0x11)
+  /// [CMD(0x11)] [槽位(0-7)] [是否循环]
+  Uint8List encodePlayClip(int slot, {bool loop = true}) {
+    final builder = BytesBuilder();
+    builder.addByte(0x11); // Command ID
+    builder.addByte(slot.clamp(0, 7)); // 槽位
+    builder.addByte(loop ? 0x01 : 0x00); // 是否循环
+    return builder.toBytes();
+  }
+
+  /// 指令 18: 追加演出条目 (0x12)
+  /// [CMD(0x12)] [时间 ms(4, 小端)] [到时执行的指令...]
+  /// [command] 是其他 encodeXxx() 的返回值 (未经 COBS 编码)，时间相对于序列开始，必须单调不减
+  Uint8List encodeSeqAppend(int timeMs, Uint8List command) {
+    final builder = BytesBuilder();
+    builder.addByte(0x12); // Command ID
+    for (var shift = 0; shift < 32; shift += 8) {
+      builder.addByte((timeMs >> shift) & 0xFF); // 时间 (小端)
+    }
+    builder.add(command);
+    return builder.toBytes();
+  }
+
+  /// 指令 19: 控制演出序列 (0x13)
+  /// [CMD(0x13)] [动作(0 停止, 1 开始, 2 清空)] [循环周期 ms(4, 小端)]
+  /// 循环周期为 0 时只播放一遍
+  Uint8List encodeSeqControl(int action, {int loopMs = 0}) {
+    final builder = BytesBuilder();
+    builder.addByte(0x13); // Command ID
+    builder.addByte(action.clamp(0, 2)); // 动作
+    for (var shift = 0; shift < 32; shift += 8) {
+      builder.addByte((loopMs >> shift) & 0xFF); // 循环周期 (小端)
+    }
+    return builder.toBytes();
+  }
+
+  /// 指令 20: 载入字节码效果 (0x14)
+  /// [CMD(0x14)] [字节码...]
+  /// [program] 由 EffectCompiler.compile() 生成，最多 256 字节
+  Uint8List encodeVmLoad(Uint8List program) {
+    final builder = BytesBuilder();
+    builder.addByte(0x14); // Command ID
+    builder.add(program);
+    return builder.toBytes();
+  }
+
+  /// 指令 21: 设置跑马灯文字 (0x15)
+  /// [CMD(0x15)] [R] [G] [B] [速度(2, 小端, 1/256 像素每秒)] [文字(ASCII)...]
+  /// 非 ASCII 字符替换为 '?'，最多 64 个字符
+  Uint8List encodeSetText(
+    String text, {
+    required int r,
+    required int g,
+    required int b,
+    required double pixelsPerSecond,
+  }) {
+    final builder = BytesBuilder();
+    builder.addByte(0x15); // Command ID
+    builder.addByte(r.clamp(0, 255)); // R
+    builder.addByte(g.clamp(0, 255)); // G
+    builder.addByte(b.clamp(0, 255)); // B
+    final speed = (pixelsPerSecond * 256).round().clamp(0, 0xFFFF);
+    builder.addByte(speed & 0xFF); // 速度低字节
+    builder.addByte((speed >> 8) & 0xFF); // 速度高字节
+    final chars = text.codeUnits.take(64).map((c) => c >= 0x20 && c <= 0x7E ? c : 0x3F);
+    builder.add(chars.toList());
+    return builder.toBytes();
+  }
+
+  /// 有符号坐标 (-128..127) 按补码写入一个字节
+  int _int8(int v) => v.clamp(-128, 127) & 0xFF;
+
+  /// 指令 22: 填充矩形 (0x16)
+  /// [CMD(0x16)] [X(int8)] [Y(int8)] [W] [H] [R] [G] [B]
+  Uint8List encodeFillRect(int x, int y, int w, int h, int r, int g, int b) {
+    final builder = BytesBuilder();
+    builder.addByte(0x16); // Command ID
+    builder.addByte(_int8(x)); // X
+    builder.addByte(_int8(y)); // Y
+    builder.addByte(w.clamp(0, 255)); // W
+    builder.addByte(h.clamp(0, 255)); // H
+    builder.addByte(r.clamp(0, 255)); // R
+    builder.addByte(g.clamp(0, 255)); // G
+    builder.addByte(b.clamp(0, 255)); // B
+    return builder.toBytes();
+  }
+
+  /// 指令 23: 画直线 (0x17)，包含两个端点
+  /// [CMD(0x17)] [X0] [Y0] [X1] [Y1] (int8) [R] [G] [B]
+  Uint8List encodeDrawLine(int x0, int y0, int x1, int y1, int r, int g, int b) {
+    final builder = BytesBuilder();
+    builder.addByte(0x17); // Command ID
+    builder.add([_int8(x0), _int8(y0), _int8(x1), _int8(y1)]); // 端点
+    builder.addByte(r.clamp(0, 255)); // R
+    builder.addByte(g.clamp(0, 255)); // G
+    builder.addByte(b.clamp(0, 255)); // B
+    return builder.toBytes();
+  }
+
+  /// 指令 24: 渐变填充整帧 (0x18)
+  /// [CMD(0x18)] [类型] [X0] [Y0] [X1] [Y1] (int8) [R0] [G0] [B0] [R1] [G1] [B1]
+  /// 类型 0 线性：从 (x0, y0) 到 (x1, y1)；类型 1 径向：圆心 (x0, y0)，x1 为半径 (0-255)，y1 忽略
+  Uint8List encodeGradient(int type, int x0, int y0, int x1, int y1, List<int> from, List<int> to) {
+    final builder = BytesBuilder();
+    builder.addByte(0x18); // Command ID
+    builder.addByte(type.clamp(0, 1)); // 类型
+    builder.add([_int8(x0), _int8(y0)]); // 起点 / 圆心
+    builder.addByte(type == 1 ? x1.clamp(0, 255) : _int8(x1)); // 终点 X / 半径
+    builder.addByte(_int8(y1)); // 终点 Y
+    builder.add(from.take(3).map((c) => c.clamp(0, 255)).toList()); // 起始颜色
+    builder.add(to.take(3).map((c) => c.clamp(0, 255)).toList()); // 结束颜色
+    return builder.toBytes();
+  }
+
+  /// 指令 25: 整帧平移 (0x19)
+  /// [CMD(0x19)] [DX(int8)] [DY(int8)] [环绕(0/1)]
+  Uint8List encodeShift(int dx, int dy, {bool wrap = true}) {
+    final builder = BytesBuilder();
+    builder.addByte(0x19); // Command ID
+    builder.addByte(_int8(dx)); // DX
+    builder.addByte(_int8(dy)); // DY
+    builder.addByte(wrap ? 0x01 : 0x00); // 环绕
+    return builder.toBytes();
+  }
+
+  /// 指令 26: 上传精灵 (0x1A)，最大 8x8，保存在 STM32 的 RAM 中，编号 0-15
+  /// [CMD(0x1A)] [编号] [宽] [高] [使用关键色(0/1)] [关键色 R] [G] [B] [像素 RGB(宽 * 高 * 3)...]
+  /// [key] 为 null 时精灵不透明，否则等于该颜色的像素不绘制
+  Uint8List encodeSpriteUpload(int id, int width, int height, Uint8List pixels, {List<int>? key}) {
+    final builder = BytesBuilder();
+    builder.addByte(0x1A); // Command ID
+    builder.addByte(id.clamp(0, 15)); // 编号
+    builder.addByte(width.clamp(1, 8)); // 宽
+    builder.addByte(height.clamp(1, 8)); // 高
+    builder.addByte(key != null ? 0x01 : 0x00); // 是否使用关键色
+    builder.add((key ?? const [0, 0, 0]).take(3).map((c) => c.clamp(0, 255)).toList()); // 关键色
+    builder.add(pixels);
+    return builder.toBytes();
+  }
+
+  /// 指令 27: 绘制精灵 (0x1B)
+  /// [CMD(0x1B)] [编号] [X(int8)] [Y(int8)] [标志位] [不透明度(可选)]
+  /// 标志位：bit0 水平翻转，bit1 垂直翻转，bit2 先清空画面；不透明度为 255 时省略，只发 5 字节
+  Uint8List encodeSpriteBlit(
+    int id,
+    int x,
+    int y, {
+    bool flipX = false,
+    bool flipY = false,
+    bool clearFirst = false,
+    int alpha = 255,
+  }) {
+    final builder = BytesBuilder();
+    builder.addByte(0x1B); // Command ID
+    builder.addByte(id.clamp(0, 15)); // 编号
+    builder.addByte(_int8(x)); // X
+    builder.addByte(_int8(y)); // Y
+    builder.addByte((flipX ? 0x01 : 0) | (flipY ? 0x02 : 0) | (clearFirst ? 0x04 : 0)); // 标志位
+    if (alpha < 255) builder.addByte(alpha.clamp(0, 255)); // 不透明度
+    return builder.toBytes();
+  }
+
+  /// 指令 28: 时间抖动开关 (0x1C)
+  /// [CMD(0x1C)] [开启(0/1)]
+  /// 开启后 STM32 在高于内容帧率的每次刷新中分散 gamma 校正后的小数部分，低亮度渐变更平滑
+  Uint8List encodeSetDithering(bool enabled) {
+    final builder = BytesBuilder();
+    builder.addByte(0x1C); // Command ID
+    builder.addByte(enabled ? 0x01 : 0x00); // 开启
+    return builder.toBytes();
+  }
+
+  /// 指令 29: 设置帧率 (0x1D)
+  /// [CMD(0x1D)] [FPS 低字节] [FPS 高字节]
+  /// 帧节拍的频率 (默认 100)，效果按节拍推进，STM32 随之调整每帧的计算预算
+  Uint8List encodeSetFps(int fps) {
+    final value = fps.clamp(1, 10000);
+    final builder = BytesBuilder();
+    builder.addByte(0x1D); // Command ID
+    builder.addByte(value & 0xFF); // FPS (小端)
+    builder.addByte((value >> 8) & 0xFF);
+    return builder.toBytes();
+  }
+}
+
+/// STM32 对功耗查询 (0x07) 的回复 (0x87)
+/// [0x87] [mA u32 小端] [预算 mA u16 小端] [限流系数 u8]
+class PowerReport {
+  const PowerReport({required this.milliamps, required this.budgetMa, required this.limit});
+
+  static const int header = 0x87;
+
+  /// 按当前画面估算的整帧电流
+  final int milliamps;
+
+  /// 电源预算，0 表示不限流
+  final int budgetMa;
+
+  /// 限流系数，255 表示不限流
+  final int limit;
+
+  /// 限流后保留的亮度百分比
+  int get limitPercent => (limit + 1) * 100 ~/ 256;
+
+  /// 从解码后的回复包解析，长度或头部不符时返回 null
+  static PowerReport? decode(Uint8List packet) {
+    if (packet.length < 8 || packet[0] != header) return null;
+    final data = ByteData.sublistView(packet);
+    return PowerReport(
+      milliamps: data.getUint32(1, Endian.little),
+      budgetMa: data.getUint16(5, Endian.little),
+      limit: packet[7],
+    );
+  }
+
+  @override
+  String toString() => 'PowerReport($milliamps mA / $budgetMa mA, limit $limitPercent%)';
 }